@@ -15,6 +15,9 @@
 #ifndef ASW__LLVM_CODEGEN_HPP_
 #define ASW__LLVM_CODEGEN_HPP_
 
+#include <functional>
+#include <map>
+
 #include <asw/location_info.hpp>
 #include <asw/scope.hpp>
 #include <asw/type_info.hpp>
@@ -33,10 +36,12 @@
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
+#include <llvm/TargetParser/Host.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
@@ -56,6 +61,78 @@ concept NODE = requires(T * t) {
 namespace asw::slc::LLVM
 {
 
+/* operations provided by the list, vec, and mat runtimes, see runtime_functions.cpp */
+enum class runtime_op
+{
+  CREATE,
+  CREATE_SOA,
+  DESTROY,
+  INIT,
+  FINI,
+  SET_HEAD,
+  HEAD,
+  CDR,
+  RUN,
+  LENGTH,
+  COUNT,
+  NOT,
+  COMPACT,
+  REVERSE,
+  NTH,
+  TAKE,
+  DROP,
+  CONCAT,
+  RANGE,
+  CONS,
+  APPEND,
+  RESERVE,
+  FROM_ARRAY,
+  FROM_ARGV,
+  FROM_LIST,
+  TO_LIST,
+  FROM_NESTED,
+  TO_NESTED,
+  FROM_ROWS,
+  SLICE,
+  TRANSPOSE,
+  MATMUL,
+  ROW_SUMS,
+  COL_SUMS,
+  PUT,
+  GET,
+  HAS,
+  REMOVE,
+  ADD,
+  SUBTRACT,
+  MULTIPLY,
+  DIVIDE,
+  MIN,
+  MAX,
+  AND,
+  OR,
+  XOR,
+  MASK_AND,
+  MASK_OR,
+  MASK_XOR,
+  /* pvecs */
+  ASSOC,
+  PUSH,
+  LEAF,
+  /* queues and heaps */
+  POP,
+  PEEK,
+  /* strings and symbols */
+  COMPARE,
+  INTERN,
+  INTERN_STATIC,
+  FROM_INT,
+  FROM_FLOAT,
+  TO_INT,
+  TO_FLOAT,
+  /* string builders */
+  TO_STRING,
+};
+
 struct codegen : public llvm_visitor
 {
   codegen();
@@ -64,6 +141,8 @@ struct codegen : public llvm_visitor
   llvm::Value * LogErrorV(const char * s) const;
 
   llvm::Value * visit(node * const n) const;
+  /* run the O2 pipeline over the module, after visit and before it is written out */
+  void optimize() const;
   llvm::Value * visit_binary_op(binary_op * const) const override;
   llvm::Value * visit_literal(literal * const) const override;
   llvm::Value * visit_extern_function(extern_function * const) const override;
@@ -81,6 +160,7 @@ struct codegen : public llvm_visitor
   llvm::Value * visit_infinite_loop(infinite_loop * const _loop) const override;
   llvm::Value * visit_when_loop(when_loop * const _loop) const override;
   llvm::Value * visit_node(node * const) const override;
+  llvm::Value * visit_record_definition(record_definition * const) const override;
   llvm::Value * visit_set_expression(set_expression * const) const override;
   llvm::Value * visit_simple_expression(simple_expression * const) const override;
   llvm::Value * visit_unary_op(unary_op * const) const override;
@@ -139,34 +219,171 @@ private:
   llvm::Value * _maybe_convert(node * const n, const type_id tid) const;
 
   llvm::Value * _convert_to_bool(llvm::Value * val, const type_id _type) const;
-  llvm::Value * _convert_to_int(llvm::Value * val, const type_id _type) const;
-  llvm::Value * _convert_to_float(llvm::Value * val, const type_id _type) const;
+  llvm::Value * _convert_to_simd(node * const n, const type_info * const to) const;
+  llvm::Value * _convert_to_int(
+    llvm::Value * val, const type_id _type, const type_id to = type_id::INT) const;
+  llvm::Value * _convert_to_float(
+    llvm::Value * val, const type_id _type, const type_id to = type_id::FLOAT) const;
   llvm::Value * _do_create_list(const type_id _type) const;
   llvm::Value * _do_init_list(llvm::Value * l, const type_id _type) const;
   llvm::Value * _do_car(expression * const l) const;
   llvm::Value * _do_car(llvm::Value * const l, const type_id list_type) const;
+  llvm::Value * _do_set_head(llvm::Value * const l, llvm::Value * const val, const type_id list_type) const;
   llvm::Value * _do_cdr(expression * const l) const;
   llvm::Value * _do_cdr(llvm::Value * const l, const type_id list_type) const;
   llvm::Value * _do_append(llvm::Value * const l, llvm::Value * const val, const type_id list_type) const;
   llvm::Value * _do_append(expression * const l, expression * const r) const;
-  llvm::Value * _visit_int_list(list * const l) const;
-  llvm::Value * _visit_float_list(list * const l) const;
-  llvm::Value * _visit_list_op_int(list_op * const op) const;
-  llvm::Value * _visit_list_op_float(list_op * const op) const;
-  llvm::Value * _visit_unary_op_int_list(unary_op * const op) const;
-  llvm::Value * _visit_unary_op_float_list(unary_op * const op) const;
+  llvm::Value * _do_length(llvm::Value * const l, const type_id list_type) const;
+  llvm::Value * _do_reserve(llvm::Value * const n, const type_id list_type) const;
+  llvm::Value * _do_list_from_array(list * const l, const type_id elem_type) const;
+  llvm::Value * _do_vec_length(llvm::Value * const v) const;
+  llvm::Value * _do_vec_data(llvm::Value * const v) const;
+  llvm::Value * _do_vec_nth(expression * const v, expression * const idx) const;
+  llvm::Value * _do_vec_load(llvm::Value * const data, llvm::Value * const idx, const type_id elem_type) const;
+  void _do_vec_store(
+    llvm::Value * const data, llvm::Value * const idx, llvm::Value * const val,
+    const type_id elem_type) const;
+  llvm::Value * _do_vec_create(llvm::Value * const n, const type_id elem_type) const;
+  llvm::Value * _do_list_to_vec(llvm::Value * const l, const type_id elem_type) const;
+  llvm::Value * _do_vec_to_list(llvm::Value * const v, const type_id elem_type) const;
+  llvm::Value * _visit_unary_op_list(unary_op * const op) const;
+  llvm::Value * _visit_slice(list_op * const op) const;
+  llvm::Value * _visit_list_function(binary_op * const op) const;
+  llvm::Value * _visit_map(binary_op * const op) const;
+  llvm::Value * _visit_filter(binary_op * const op) const;
+  llvm::Value * _visit_mat_map(binary_op * const op) const;
+  llvm::Value * _visit_fold(list_op * const op) const;
+  void _emit_list_loop(
+    llvm::Value * const l, const type_id elem_type,
+    const std::function<void(llvm::Value *)> & body) const;
+  llvm::Value * _inline_lambda(lambda * const fn, const std::vector<llvm::Value *> & args) const;
+  llvm::Value * _visit_dynamic_call(function_call * const call) const;
+  llvm::Function * _lambda_function(lambda * const fn) const;
+  llvm::Value * _make_closure(llvm::Value * const func, llvm::Value * const env) const;
+  llvm::Value * _lambda_env(lambda * const fn) const;
+  llvm::Value * _visit_mask_op(list_op * const op) const;
+  llvm::Value * _visit_scalar_arith(list_op * const op) const;
+  llvm::Value * _visit_simd_reduce(list_op * const op, expression * const operand) const;
+  llvm::Value * _visit_lanes(list_op * const op) const;
+  llvm::Value * _visit_shuffle(list_op * const op) const;
+  llvm::Value * _visit_do_loop_vec(do_loop * const _loop) const;
+  llvm::Value * _visit_collect_loop_vec(collect_loop * const _loop) const;
+  llvm::Value * _vec_loop_source(
+    iterator_definition * const it, llvm::Value * const vec,
+    std::function<llvm::Value *(llvm::Value *, llvm::BasicBlock *)> & load) const;
+  void _emit_index_loop(
+    llvm::Value * const n, const std::function<void(llvm::Value *)> & body) const;
+
+  /* mats, row-major with their shape in front */
+  llvm::Value * _visit_unary_op_mat(unary_op * const op) const;
+  llvm::Value * _do_mat_rows(llvm::Value * const m) const;
+  llvm::Value * _do_mat_cols(llvm::Value * const m) const;
+  llvm::Value * _do_mat_data(llvm::Value * const m) const;
+  llvm::Value * _do_mat_row(
+    llvm::Value * const data, llvm::Value * const cols, llvm::Value * const idx,
+    llvm::Value * const view, const type_id elem_type) const;
 
+  /* maps and sets, hash tables from the runtime that hold a value in 64 bits */
+  llvm::Value * _visit_table(list_op * const op) const;
+  llvm::Value * _visit_put(list_op * const op) const;
+  llvm::Value * _visit_table_op(binary_op * const op) const;
+  llvm::Value * _table_key(expression * const key, const type_info * const table_t) const;
+  llvm::Value * _to_table_value(expression * const val, const type_info * const table_t) const;
+  llvm::Value * _from_table_value(llvm::Value * const bits, const type_info * const table_t) const;
+  llvm::Value * _to_bits(llvm::Value * const val, const type_id elem) const;
+  llvm::Value * _from_bits(llvm::Value * const bits, const type_id elem) const;
+  llvm::Value * _do_table_field(llvm::Value * const t, const int field, const char * name) const;
+  void _do_table_skip_free(
+    llvm::Value * const ctrl, llvm::Value * const idx, llvm::BasicBlock * const next) const;
+
+  /* pvecs, RRB trees from the runtime that also hold an element in 64 bits */
+  llvm::Value * _visit_to_pvec(unary_op * const op) const;
+  llvm::Value * _visit_assoc(list_op * const op) const;
+  llvm::Value * _visit_pvec_op(binary_op * const op) const;
+  llvm::Value * _call_pvec(
+    const runtime_op op, std::vector<llvm::Value *> args, const std::string & name = "") const;
+  llvm::Value * _do_pvec_length(llvm::Value * const p) const;
+  llvm::AllocaInst * _pvec_cursor() const;
+  llvm::Value * _do_pvec_slot(
+    llvm::Value * const p, llvm::Value * const idx, llvm::AllocaInst * const cursor) const;
+
+  /* queues and heaps from the runtime, a queue holds an element in 64 bits like a pvec */
+  llvm::Value * _visit_queue(list_op * const op) const;
+  llvm::Value * _visit_queue_push(binary_op * const op) const;
+  llvm::Value * _visit_queue_op(unary_op * const op) const;
+  llvm::Value * _visit_builder(list_op * const op) const;
+  llvm::Value * _to_queue_bits(llvm::Value * const val, const type_info * const queue_t) const;
+  llvm::Value * _from_queue_bits(llvm::Value * const bits, const type_info * const queue_t) const;
+
+  /* records and tuples, and vecs of records */
+  llvm::Value * _visit_record_construction(function_call * const call) const;
+  llvm::Value * _visit_get(unary_op * const op) const;
+  llvm::Value * _visit_values(list_op * const op) const;
+  record_definition * _record_of(const type_info * const t) const;
+  std::size_t _value_size(const type_info * const t) const;
+  bool _by_reference(const type_info * const t) const;
+  llvm::Type * _param_type(const type_info * const t) const;
+  llvm::Value * _pass_arg(llvm::Value * const val, const type_info * const t) const;
+  llvm::Value * _receive_arg(llvm::Value * const arg, const type_info * const t) const;
+  llvm::Value * _do_record_vec_create(llvm::Value * const n, record_definition * const rec) const;
+  llvm::Value * _do_record_vec_column(llvm::Value * const v, const int field) const;
+  llvm::Value * _do_record_vec_load(
+    llvm::Value * const v, llvm::Value * const idx, record_definition * const rec) const;
+  void _do_record_vec_store(
+    llvm::Value * const v, llvm::Value * const idx, llvm::Value * const val,
+    record_definition * const rec) const;
+  llvm::Value * _do_record_vec_get(
+    llvm::Value * const v, record_definition * const rec, const int field) const;
+
+  /* names bound in named_values_, with what each one shadowed (or nullptr) */
+  using bindings_t = std::vector<std::pair<std::string, llvm::Value *>>;
+  void _bind(const std::string & name, llvm::Value * const val, bindings_t & saved) const;
+  void _bind_captures(lambda * const fn, llvm::Value * const env, bindings_t & saved) const;
+  void _unbind(const bindings_t & saved) const;
+  llvm::Value * _load_definition(variable_definition * const def) const;
   llvm::Value * _load_var(scope * const s, const std::string & name) const;
   llvm::Value * _store_var(scope * const s, const std::string & name, llvm::Value * val) const;
 
   llvm::Value * _create_cons(expression * const e, expression * const l) const;
+  llvm::AllocaInst * _create_entry_alloca(llvm::Type * type, const std::string & name) const;
+
+  llvm::Constant * _string_literal(const std::string & str) const;
+  llvm::Value * _symbol_literal(const std::string & name) const;
+  void _intern_symbols() const;
+  void _emit_main(llvm::Function * const body, function_definition * const func) const;
+  llvm::Value * _visit_intern(unary_op * const op) const;
+  llvm::Value * _visit_to_string(unary_op * const op) const;
+  llvm::Value * _visit_string_concat(list_op * const op) const;
 
-  void _insert_slc_int_list_functions() const;
-  void _insert_slc_double_list_functions() const;
+  void _insert_runtime_functions() const;
+  llvm::Function * _runtime_function(
+    const type_id container, const type_id elem, const runtime_op op) const;
+  llvm::Value * _call_runtime(
+    const type_id container, const type_id elem, const runtime_op op,
+    std::vector<llvm::Value *> args, const std::string & name = "") const;
+  llvm::Type * _elem_storage_type(const type_id elem) const;
+  llvm::Value * _to_storage(llvm::Value * val, const type_id elem) const;
+  llvm::Value * _from_storage(llvm::Value * val, const type_id elem) const;
 
   llvm::Type * _type_id_to_llvm(const type_id id) const;
+  llvm::Type * _type_to_llvm(const type_info * const t) const;
+  llvm::StructType * _vec_struct_type() const;
+  llvm::StructType * _mat_struct_type() const;
+  llvm::StructType * _table_struct_type() const;
+  llvm::StructType * _pvec_cursor_type() const;
+  llvm::StructType * _record_vec_struct_type() const;
 
   mutable std::unordered_map<std::string, llvm::Value *> named_values_;
+  /* lambdas whose bodies are being inlined, innermost last */
+  mutable std::vector<lambda *> inlining_;
+  /* the layout of each capturing lambda's environment */
+  mutable std::unordered_map<lambda *, llvm::StructType *> env_types_;
+  /* records by name, they are all defined at the top level */
+  mutable std::unordered_map<std::string, record_definition *> records_;
+  mutable std::unordered_map<std::string, llvm::StructType *> record_types_;
+  /* string literals by contents, and the slot each symbol literal is interned into */
+  mutable std::unordered_map<std::string, llvm::GlobalVariable *> string_literals_;
+  mutable std::map<std::string, llvm::GlobalVariable *> symbols_;
   using name_to_alloca_map_t = std::unordered_map<std::string, llvm::AllocaInst *>;
   mutable std::unordered_map<scope *, std::unique_ptr<name_to_alloca_map_t>> scope_to_alloca_map_;
   inline static std::unique_ptr<llvm::LLVMContext> context_ = nullptr;
@@ -0,0 +1,75 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_BOOL_LIST_H_
+#define ASW__SLC__RUNTIME__SLC_BOOL_LIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * list<bool> packs its elements one bit each, so a bool has no address and
+ * there is no car. head reads an element instead.
+ *
+ * A list value is the address of a chunk with the index of the head bit
+ * in bits 48-63. That needs user space addresses under 2^48: 4-level
+ * paging on x86-64, or 48-bit virtual addresses on AArch64 with top-byte
+ * ignore and MTE tagging off. A chunk allocated above that, as can happen
+ * with 5-level paging (LA57), can't be represented, so the program prints
+ * why and aborts rather than lose elements.
+ */
+struct slc_bool_list;
+
+/* bits decoded by each call to run, the same as SLC_LIST_RUN_MAX in slc_list.h */
+#define SLC_BOOL_LIST_RUN 256
+
+struct slc_bool_list * slc_bool_list_create();
+int8_t slc_bool_list_destroy(struct slc_bool_list *);
+int8_t slc_bool_list_init(struct slc_bool_list *);
+int8_t slc_bool_list_fini(struct slc_bool_list *);
+int8_t slc_bool_list_set_head(struct slc_bool_list *, int8_t);
+
+/* unary ops */
+int8_t slc_bool_list_head(struct slc_bool_list *);
+struct slc_bool_list * slc_bool_list_cdr(struct slc_bool_list *);
+int64_t slc_bool_list_length(struct slc_bool_list *);
+int64_t slc_bool_list_count(struct slc_bool_list *);
+struct slc_bool_list * slc_bool_list_not(struct slc_bool_list *);
+
+/* binary ops */
+struct slc_bool_list * slc_bool_list_cons(int8_t, struct slc_bool_list *);
+struct slc_bool_list * slc_bool_list_append(struct slc_bool_list *, int8_t);
+
+/* bulk construction */
+struct slc_bool_list * slc_bool_list_reserve(size_t);
+struct slc_bool_list * slc_bool_list_from_array(const int8_t *, size_t);
+size_t slc_bool_list_to_array(struct slc_bool_list *, int8_t *);
+/* decode up to SLC_BOOL_LIST_RUN bits into bytes, set *n to how many and *next to the list after them */
+const int8_t * slc_bool_list_run(
+  struct slc_bool_list *, int64_t *, struct slc_bool_list **, int8_t *);
+/* bit x of the list is bit x % 64 of word x / 64 */
+struct slc_bool_list * slc_bool_list_from_words(const uint64_t *, size_t);
+size_t slc_bool_list_to_words(struct slc_bool_list *, uint64_t *);
+
+/* list ops */
+int8_t slc_bool_list_and(struct slc_bool_list *);
+int8_t slc_bool_list_or(struct slc_bool_list *);
+int8_t slc_bool_list_xor(struct slc_bool_list *);
+
+/* elementwise, the result is as long as the shorter list */
+struct slc_bool_list * slc_bool_list_mask_and(struct slc_bool_list *, struct slc_bool_list *);
+struct slc_bool_list * slc_bool_list_mask_or(struct slc_bool_list *, struct slc_bool_list *);
+struct slc_bool_list * slc_bool_list_mask_xor(struct slc_bool_list *, struct slc_bool_list *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_BOOL_LIST_H_ */
@@ -0,0 +1,64 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_BOOL_VEC_H_
+#define ASW__SLC__RUNTIME__SLC_BOOL_VEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct slc_bool_list;
+
+/**
+ * Packed array of bools: element x is bit x % 64 of data[x / 64]. The
+ * compiler reads len and data directly when indexing and looping, so the
+ * order of these fields is fixed. Bits past len in the last word are not
+ * part of the vec and may hold anything.
+ */
+struct slc_bool_vec
+{
+  int64_t len;
+  /* number of bits in storage, 0 for a view into another vec */
+  int64_t cap;
+  uint64_t * data;
+  uint64_t storage[];
+};
+
+struct slc_bool_vec * slc_bool_vec_create(size_t);
+int8_t slc_bool_vec_destroy(struct slc_bool_vec *);
+
+/* unary ops */
+int64_t slc_bool_vec_length(struct slc_bool_vec *);
+int64_t slc_bool_vec_count(struct slc_bool_vec *);
+struct slc_bool_vec * slc_bool_vec_not(struct slc_bool_vec *);
+
+/* views, or copies when start is not a multiple of 64 */
+struct slc_bool_vec * slc_bool_vec_slice(struct slc_bool_vec *, int64_t, int64_t);
+
+/* conversions */
+struct slc_bool_vec * slc_bool_vec_from_array(const int8_t *, size_t);
+struct slc_bool_vec * slc_bool_vec_from_list(struct slc_bool_list *);
+struct slc_bool_list * slc_bool_vec_to_list(struct slc_bool_vec *);
+
+/* vec ops */
+int8_t slc_bool_vec_and(struct slc_bool_vec *);
+int8_t slc_bool_vec_or(struct slc_bool_vec *);
+int8_t slc_bool_vec_xor(struct slc_bool_vec *);
+
+/* elementwise, the result is as long as the shorter vec */
+struct slc_bool_vec * slc_bool_vec_mask_and(struct slc_bool_vec *, struct slc_bool_vec *);
+struct slc_bool_vec * slc_bool_vec_mask_or(struct slc_bool_vec *, struct slc_bool_vec *);
+struct slc_bool_vec * slc_bool_vec_mask_xor(struct slc_bool_vec *, struct slc_bool_vec *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_BOOL_VEC_H_ */
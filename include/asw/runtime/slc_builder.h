@@ -0,0 +1,41 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_BUILDER_H_
+#define ASW__SLC__RUNTIME__SLC_BUILDER_H_
+
+#include <stdint.h>
+
+/**
+ * builder, text that is appended to in place and then turned into a
+ * string. Strings never change once made, so (+ acc s) in a loop copies
+ * everything built so far on each step. A builder keeps its bytes in a
+ * buffer that doubles when full instead, so pushing n bytes in total
+ * copies O(n) of them however many pushes it takes.
+ *
+ * (string b) copies the bytes out into a new string of exactly their
+ * length, and the builder can keep growing after that.
+ */
+struct slc_builder;
+
+struct slc_builder * slc_builder_create();
+int8_t slc_builder_destroy(struct slc_builder *);
+
+/* append s, in place, NULL if the buffer could not grow */
+struct slc_builder * slc_builder_push(struct slc_builder *, const char * s);
+/* the bytes pushed so far, as a new string */
+const char * slc_builder_string(struct slc_builder *);
+int64_t slc_builder_length(struct slc_builder *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_BUILDER_H_ */
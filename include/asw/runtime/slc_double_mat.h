@@ -0,0 +1,27 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_DOUBLE_MAT_H_
+#define ASW__SLC__RUNTIME__SLC_DOUBLE_MAT_H_
+
+#include <asw/runtime/slc_double_list.h>
+#include <asw/runtime/slc_sized_vec.h>
+#include <stdint.h>
+
+/* mat<float>, see asw/runtime/slc_mat.h */
+#define SLC_MAT_NAME double
+#define SLC_MAT_T double
+#include <asw/runtime/slc_mat.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_DOUBLE_MAT_H_ */
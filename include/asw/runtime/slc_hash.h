@@ -0,0 +1,43 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_HASH_H_
+#define ASW__SLC__RUNTIME__SLC_HASH_H_
+
+#include <asw/runtime/slc_double_list.h>
+#include <asw/runtime/slc_int_list.h>
+#include <asw/runtime/slc_string_list.h>
+#include <asw/runtime/slc_symbol.h>
+#include <stdint.h>
+
+/* map and set tables keyed by int, float, string and symbol, see asw/runtime/slc_table.h */
+#define SLC_TABLE_NAME int
+#define SLC_TABLE_K int64_t
+#include <asw/runtime/slc_table.h>
+
+#define SLC_TABLE_NAME double
+#define SLC_TABLE_K double
+#include <asw/runtime/slc_table.h>
+
+/* the strings themselves are not copied, like list<string> */
+#define SLC_TABLE_NAME string
+#define SLC_TABLE_K const char *
+#include <asw/runtime/slc_table.h>
+
+/* keyed by address, which is enough since symbols are interned */
+#define SLC_TABLE_NAME symbol
+#define SLC_TABLE_K const char *
+#include <asw/runtime/slc_table.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_HASH_H_ */
@@ -0,0 +1,54 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ASW__SLC__RUNTIME__SLC_HEAP_H_
+#define ASW__SLC__RUNTIME__SLC_HEAP_H_
+
+#include <stdint.h>
+
+/**
+ * heap<T>, a priority queue of int or float. Elements are ordered as
+ * int64_t; the compiler maps a float to an int64_t that orders the same
+ * way and back, so this one runtime serves both.
+ *
+ * It is a 4-ary heap: the children of element i are 4i + 1 to 4i + 4. That
+ * halves the depth of a binary heap, and the array is offset so those
+ * four share one half of a cache line, so a step down the heap compares
+ * four keys from one line instead of two keys from two. A max heap stores
+ * each key inverted, which reverses the order, so both kinds share one
+ * set of sift loops.
+ *
+ * Popping or peeking an empty heap gives 0. The compiler reads len
+ * directly, so it stays the first field.
+ */
+struct slc_heap
+{
+  int64_t len;
+  int64_t cap;
+  /* 0 for a min heap, ~0 for a max heap, xor'd into every key */
+  int64_t flip;
+  int64_t * keys;
+};
+
+struct slc_heap * slc_heap_create(int8_t max);
+int8_t slc_heap_destroy(struct slc_heap *);
+
+/* add a key, in place, NULL if the heap could not grow */
+struct slc_heap * slc_heap_push(struct slc_heap *, int64_t);
+/* remove the smallest key, or the largest of a max heap */
+int64_t slc_heap_pop(struct slc_heap *);
+int64_t slc_heap_peek(struct slc_heap *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_HEAP_H_ */
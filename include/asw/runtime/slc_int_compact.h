@@ -0,0 +1,53 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_INT_COMPACT_H_
+#define ASW__SLC__RUNTIME__SLC_INT_COMPACT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Compact list<int> storage, made by (compact l). A compact list is still a
+ * struct slc_int_list *, told apart from a regular one by its low bit, and
+ * the slc_int_list_* functions hand it off to these.
+ *
+ * Compact lists are read-only: set_head and append leave them alone.
+ *
+ * Like list<bool>, the index of the head goes in bits 48-63 of the value,
+ * so a list is only compacted when the whole of it is allocated under
+ * 2^48, see asw/runtime/slc_bool_list.h. Otherwise, or if allocation
+ * fails, compact returns the list it was given, unchanged.
+ */
+#define SLC_INT_COMPACT_TAG 0x1
+/* elements in a compact chunk, also the most that decode produces */
+#define SLC_INT_COMPACT_RUN 128
+
+struct slc_int_list;
+
+static inline int slc_int_compact_is(const struct slc_int_list * list)
+{
+  return 0 != ((uintptr_t)list & SLC_INT_COMPACT_TAG);
+}
+
+int64_t slc_int_compact_head(struct slc_int_list *);
+struct slc_int_list * slc_int_compact_cdr(struct slc_int_list *);
+int64_t slc_int_compact_length(struct slc_int_list *);
+struct slc_int_list * slc_int_compact_drop(struct slc_int_list *, int64_t);
+int8_t slc_int_compact_destroy(struct slc_int_list *);
+
+/* decode up to the end of the chunk into out, and set *next to the list after it */
+size_t slc_int_compact_decode(struct slc_int_list *, int64_t * out, struct slc_int_list ** next);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_INT_COMPACT_H_ */
@@ -15,32 +15,18 @@
 #ifndef ASW__SLC__RUNTIME__SLC_INT_LIST_H_
 #define ASW__SLC__RUNTIME__SLC_INT_LIST_H_
 
-#include <stdint.h>
+#define SLC_LIST_NAME int
+#define SLC_LIST_T int64_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
 
-struct slc_int_list;
-
-struct slc_int_list * slc_int_list_create();
-int8_t slc_int_list_destroy(struct slc_int_list *);
-int8_t slc_int_list_init(struct slc_int_list *);
-int8_t slc_int_list_fini(struct slc_int_list *);
-int8_t slc_int_list_set_head(struct slc_int_list *, int64_t);
-int8_t slc_int_list_set_tail(struct slc_int_list *, struct slc_int_list *);
-
-/* unary ops */
-int64_t * slc_int_list_car(struct slc_int_list *);
-struct slc_int_list * slc_int_list_cdr(struct slc_int_list *);
-
-/* binary ops */
-struct slc_int_list * slc_int_list_cons(int64_t, struct slc_int_list *);
-struct slc_int_list * slc_int_list_append(struct slc_int_list *, int64_t);
-
-/* list ops */
-int64_t slc_int_list_add(struct slc_int_list *);
-int64_t slc_int_list_subtract(struct slc_int_list *);
-int64_t slc_int_list_multiply(struct slc_int_list *);
-int64_t slc_int_list_divide(struct slc_int_list *);
+/* re-encode a list compactly, see asw/runtime/slc_int_compact.h */
+struct slc_int_list * slc_int_list_compact(struct slc_int_list *);
+/* the integers [a, b] */
+struct slc_int_list * slc_int_list_range(int64_t, int64_t);
 
 /* print function */
 int64_t print_int(int64_t);
+int8_t print_slc_int_list(struct slc_int_list *);
 
 #endif  /* ASW__SLC__RUNTIME__SLC_INT_LIST_H_ */
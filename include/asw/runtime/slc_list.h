@@ -0,0 +1,102 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Declares the list runtime for one element type. This header has no
+ * include guard on purpose, it is included once per element type with
+ * the following defined:
+ *
+ *   SLC_LIST_NAME     name used in the symbols, slc_<name>_list_*
+ *   SLC_LIST_T        C type of an element
+ *   SLC_LIST_NUMERIC  (optional) also declare the arithmetic reductions
+ *
+ * The parameters are undefined again at the end.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ASW__SLC__RUNTIME__SLC_LIST_H_
+#define ASW__SLC__RUNTIME__SLC_LIST_H_
+#define SLC_LIST_CAT_(a, b, c) a ## b ## c
+#define SLC_LIST_CAT(a, b, c) SLC_LIST_CAT_(a, b, c)
+/* elements the buffer passed to run must hold */
+#define SLC_LIST_RUN_MAX 256
+#endif  /* ASW__SLC__RUNTIME__SLC_LIST_H_ */
+
+#define SLC_LIST SLC_LIST_CAT(slc_, SLC_LIST_NAME, _list)
+#define SLC_LIST_FN(fn) SLC_LIST_CAT(SLC_LIST, _, fn)
+#define SLC_LIST_ELEM SLC_LIST_CAT(slc_, SLC_LIST_NAME, _list_elem)
+
+struct SLC_LIST;
+/* named so that qualifiers apply to the element, even when it is a pointer */
+typedef SLC_LIST_T SLC_LIST_ELEM;
+
+struct SLC_LIST * SLC_LIST_FN(create)();
+int8_t SLC_LIST_FN(destroy)(struct SLC_LIST *);
+int8_t SLC_LIST_FN(init)(struct SLC_LIST *);
+int8_t SLC_LIST_FN(fini)(struct SLC_LIST *);
+int8_t SLC_LIST_FN(set_head)(struct SLC_LIST *, SLC_LIST_ELEM);
+
+/* unary ops */
+SLC_LIST_ELEM * SLC_LIST_FN(car)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(head)(struct SLC_LIST *);
+struct SLC_LIST * SLC_LIST_FN(cdr)(struct SLC_LIST *);
+int64_t SLC_LIST_FN(length)(struct SLC_LIST *);
+
+/* binary ops */
+struct SLC_LIST * SLC_LIST_FN(cons)(SLC_LIST_ELEM, struct SLC_LIST *);
+struct SLC_LIST * SLC_LIST_FN(append)(struct SLC_LIST *, SLC_LIST_ELEM);
+
+/* bulk construction */
+struct SLC_LIST * SLC_LIST_FN(reserve)(size_t);
+struct SLC_LIST * SLC_LIST_FN(from_array)(const SLC_LIST_ELEM *, size_t);
+size_t SLC_LIST_FN(to_array)(struct SLC_LIST *, SLC_LIST_ELEM *);
+/**
+ * return the elements from list to the end of its chunk, set *n to how many
+ * there are and *next to the list after them. a compact chunk is decoded into
+ * buf, up to SLC_LIST_RUN_MAX elements at a time. the elements of a list made
+ * by reserve are never compact, and may be written through the result.
+ */
+const SLC_LIST_ELEM * SLC_LIST_FN(run)(
+  struct SLC_LIST *, int64_t *, struct SLC_LIST **, SLC_LIST_ELEM *);
+
+/* list functions, new lists are allocated in one block */
+struct SLC_LIST * SLC_LIST_FN(reverse)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(nth)(struct SLC_LIST *, int64_t);
+struct SLC_LIST * SLC_LIST_FN(take)(struct SLC_LIST *, int64_t);
+struct SLC_LIST * SLC_LIST_FN(drop)(struct SLC_LIST *, int64_t);
+struct SLC_LIST * SLC_LIST_FN(concat)(struct SLC_LIST *, struct SLC_LIST *);
+
+/* higher-order, fn is called once per element, in order */
+struct SLC_LIST * SLC_LIST_FN(map)(struct SLC_LIST *, SLC_LIST_ELEM (*)(SLC_LIST_ELEM));
+struct SLC_LIST * SLC_LIST_FN(filter)(struct SLC_LIST *, int8_t (*)(SLC_LIST_ELEM));
+SLC_LIST_ELEM SLC_LIST_FN(fold)(
+  struct SLC_LIST *, SLC_LIST_ELEM (*)(SLC_LIST_ELEM, SLC_LIST_ELEM), SLC_LIST_ELEM);
+
+#ifdef SLC_LIST_NUMERIC
+/* list ops */
+SLC_LIST_ELEM SLC_LIST_FN(add)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(subtract)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(multiply)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(divide)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(min)(struct SLC_LIST *);
+SLC_LIST_ELEM SLC_LIST_FN(max)(struct SLC_LIST *);
+#endif
+
+#undef SLC_LIST_ELEM
+#undef SLC_LIST_FN
+#undef SLC_LIST
+#undef SLC_LIST_NUMERIC
+#undef SLC_LIST_T
+#undef SLC_LIST_NAME
@@ -0,0 +1,90 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Declares the mat runtime for one numeric element type. Like
+ * asw/runtime/slc_vec.h, this header has no include guard and is included
+ * once per element type with the following defined:
+ *
+ *   SLC_MAT_NAME  name used in the symbols, slc_<name>_mat_*
+ *   SLC_MAT_T     C type of an element
+ *
+ * A row of a mat is handed out as a slc_<name>_vec, and a mat converts to
+ * and from list<list<T>>, so include this after the vec and list headers
+ * of the element type. The parameters are undefined again at the end.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ASW__SLC__RUNTIME__SLC_MAT_H_
+#define ASW__SLC__RUNTIME__SLC_MAT_H_
+#define SLC_MAT_CAT_(a, b, c) a ## b ## c
+#define SLC_MAT_CAT(a, b, c) SLC_MAT_CAT_(a, b, c)
+struct slc_ptr_list;
+struct slc_ptr_vec;
+#endif  /* ASW__SLC__RUNTIME__SLC_MAT_H_ */
+
+#define SLC_MAT SLC_MAT_CAT(slc_, SLC_MAT_NAME, _mat)
+#define SLC_MAT_FN(fn) SLC_MAT_CAT(SLC_MAT, _, fn)
+#define SLC_MAT_VEC SLC_MAT_CAT(slc_, SLC_MAT_NAME, _vec)
+
+struct SLC_MAT_VEC;
+
+/**
+ * A dense row-major matrix, element (i, j) is data[i * cols + j]. The
+ * compiler reads the shape and data directly when looping over rows, so
+ * the order of these fields is fixed.
+ */
+struct SLC_MAT
+{
+  int64_t rows;
+  int64_t cols;
+  SLC_MAT_T * data;
+  SLC_MAT_T storage[];
+};
+
+/* a zeroed rows x cols mat */
+struct SLC_MAT * SLC_MAT_FN(create)(int64_t, int64_t);
+int8_t SLC_MAT_FN(destroy)(struct SLC_MAT *);
+
+/* row x as a vec that views the elements of the mat */
+struct SLC_MAT_VEC * SLC_MAT_FN(row)(struct SLC_MAT *, int64_t);
+
+/* conversions, rows shorter than the longest one are padded with zeros */
+struct SLC_MAT * SLC_MAT_FN(from_nested)(struct slc_ptr_list *);
+struct SLC_MAT * SLC_MAT_FN(from_rows)(struct slc_ptr_vec *);
+struct slc_ptr_list * SLC_MAT_FN(to_nested)(struct SLC_MAT *);
+
+/* linear algebra, matmul returns NULL if the columns of a aren't the rows of b */
+struct SLC_MAT * SLC_MAT_FN(transpose)(struct SLC_MAT *);
+struct SLC_MAT * SLC_MAT_FN(matmul)(struct SLC_MAT *, struct SLC_MAT *);
+
+/* one sum per row, or per column */
+struct SLC_MAT_VEC * SLC_MAT_FN(row_sums)(struct SLC_MAT *);
+struct SLC_MAT_VEC * SLC_MAT_FN(col_sums)(struct SLC_MAT *);
+
+/* mat ops, over every element */
+SLC_MAT_T SLC_MAT_FN(add)(struct SLC_MAT *);
+SLC_MAT_T SLC_MAT_FN(multiply)(struct SLC_MAT *);
+SLC_MAT_T SLC_MAT_FN(min)(struct SLC_MAT *);
+SLC_MAT_T SLC_MAT_FN(max)(struct SLC_MAT *);
+
+/* print function */
+int8_t SLC_MAT_CAT(print_, SLC_MAT, )(struct SLC_MAT *);
+
+#undef SLC_MAT_VEC
+#undef SLC_MAT_FN
+#undef SLC_MAT
+#undef SLC_MAT_T
+#undef SLC_MAT_NAME
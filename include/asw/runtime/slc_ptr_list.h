@@ -0,0 +1,23 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_PTR_LIST_H_
+#define ASW__SLC__RUNTIME__SLC_PTR_LIST_H_
+
+/* elements that are themselves lists or vecs, as in list<list<T>> */
+#define SLC_LIST_NAME ptr
+#define SLC_LIST_T void *
+#include <asw/runtime/slc_list.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_PTR_LIST_H_ */
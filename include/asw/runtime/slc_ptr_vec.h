@@ -0,0 +1,61 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_PTR_VEC_H_
+#define ASW__SLC__RUNTIME__SLC_PTR_VEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The leading fields of every slc_<T>_vec. A row of a nested vec is one of
+ * these in place, so it is a view of its elements that can be handed out
+ * as a vec<T> without allocating.
+ */
+struct slc_vec_row
+{
+  int64_t len;
+  int64_t cap;
+  void * data;
+};
+
+/**
+ * vec<vec<T>>. Like the other vecs, the compiler reads len and data
+ * directly; element x is &data[x].
+ */
+struct slc_ptr_vec
+{
+  int64_t len;
+  /* number of rows in storage, 0 for a view into another vec */
+  int64_t cap;
+  struct slc_vec_row * data;
+  struct slc_vec_row storage[];
+};
+
+struct slc_ptr_vec * slc_ptr_vec_create(size_t);
+int8_t slc_ptr_vec_destroy(struct slc_ptr_vec *);
+
+/* unary ops */
+int64_t slc_ptr_vec_length(struct slc_ptr_vec *);
+
+/* views */
+struct slc_ptr_vec * slc_ptr_vec_slice(struct slc_ptr_vec *, int64_t, int64_t);
+
+/**
+ * a vec of rows that all point into one array of count elements of
+ * elem_size bytes, stored after the rows and returned in *values
+ */
+struct slc_ptr_vec * slc_ptr_vec_csr(size_t rows, size_t count, size_t elem_size, void ** values);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_PTR_VEC_H_ */
@@ -0,0 +1,58 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ASW__SLC__RUNTIME__SLC_PVEC_H_
+#define ASW__SLC__RUNTIME__SLC_PVEC_H_
+
+#include <stdint.h>
+
+/**
+ * pvec<T>, a persistent vector. It is a relaxed radix balanced (RRB) tree
+ * of 32-way nodes with the elements in its leaves. Elements are stored as
+ * 64 bits, see asw/runtime/slc_table.h.
+ *
+ * Nothing is changed in place: nth, assoc, push, slice, and concat are
+ * O(log32 n) and share every node they don't touch with their arguments,
+ * so an old version stays valid as long as it is held. Nodes are shared
+ * between versions, so a pvec is never freed.
+ *
+ * The compiler reads len directly and loops over a pvec a leaf at a time
+ * with slc_pvec_leaf, so the order of these fields is fixed.
+ */
+struct slc_pvec_node;
+
+struct slc_pvec
+{
+  int64_t len;
+  /* SLC_PVEC_BITS for each level above the leaves */
+  int64_t shift;
+  struct slc_pvec_node * root;
+};
+
+struct slc_pvec * slc_pvec_create();
+/* n zero elements in full leaves, which may be written through slc_pvec_leaf until it is shared */
+struct slc_pvec * slc_pvec_reserve(int64_t n);
+
+uint64_t slc_pvec_nth(struct slc_pvec *, int64_t);
+struct slc_pvec * slc_pvec_assoc(struct slc_pvec *, int64_t, uint64_t);
+struct slc_pvec * slc_pvec_push(struct slc_pvec *, uint64_t);
+/* the elements [start, end) */
+struct slc_pvec * slc_pvec_slice(struct slc_pvec *, int64_t start, int64_t end);
+struct slc_pvec * slc_pvec_concat(struct slc_pvec *, struct slc_pvec *);
+
+/* the slot of element i in its leaf, and set *end to the index just past that leaf */
+uint64_t * slc_pvec_leaf(struct slc_pvec *, int64_t i, int64_t * end);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_PVEC_H_ */
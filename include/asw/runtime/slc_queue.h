@@ -0,0 +1,52 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ASW__SLC__RUNTIME__SLC_QUEUE_H_
+#define ASW__SLC__RUNTIME__SLC_QUEUE_H_
+
+#include <stdint.h>
+
+/**
+ * queue<T>, a first in first out queue in a ring buffer. Elements are
+ * stored as 64 bits, see asw/runtime/slc_table.h.
+ *
+ * The buffer's capacity is a power of two, so the slot after the last one
+ * is found with a mask, and it doubles when full. push, pop, and peek are
+ * O(1) and only push ever allocates. Popping or peeking an empty queue
+ * gives 0, the zero of every element type, as a lookup of a missing key
+ * does.
+ *
+ * The compiler reads len directly, so it stays the first field.
+ */
+struct slc_queue
+{
+  int64_t len;
+  /* the slot of the front element */
+  int64_t head;
+  /* capacity - 1 */
+  int64_t mask;
+  uint64_t * slots;
+};
+
+struct slc_queue * slc_queue_create();
+int8_t slc_queue_destroy(struct slc_queue *);
+
+/* add to the back, in place, NULL if the buffer could not grow */
+struct slc_queue * slc_queue_push(struct slc_queue *, uint64_t);
+/* remove from the front */
+uint64_t slc_queue_pop(struct slc_queue *);
+uint64_t slc_queue_peek(struct slc_queue *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_QUEUE_H_ */
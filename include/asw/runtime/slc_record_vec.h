@@ -0,0 +1,54 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_RECORD_VEC_H_
+#define ASW__SLC__RUNTIME__SLC_RECORD_VEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <asw/runtime/slc_ptr_vec.h>
+
+/**
+ * vec<R> for a record R. The runtime only knows sizes, the compiler reads
+ * and writes the records itself.
+ *
+ * An aos vec keeps whole records back to back in data, record x is
+ * &data[x * size]. An soa vec has no data, instead column f holds field f
+ * of every record, and is a vec<T> in place (bool columns are packed like
+ * vec<bool>), so it can be handed out without copying.
+ */
+struct slc_record_vec
+{
+  int64_t len;
+  /* number of records in storage */
+  int64_t cap;
+  /* the records of an aos vec, NULL for soa */
+  void * data;
+  /* number of columns, 0 for aos */
+  int64_t fields;
+  struct slc_vec_row columns[];
+};
+
+/* n records of elem_size bytes each, stored aos */
+struct slc_record_vec * slc_record_vec_create(size_t n, size_t elem_size);
+/* n records stored soa, column x is column_bytes[x] bytes */
+struct slc_record_vec * slc_record_vec_create_soa(
+  size_t n, size_t fields, const int64_t * column_bytes);
+int8_t slc_record_vec_destroy(struct slc_record_vec *);
+
+/* unary ops */
+int64_t slc_record_vec_length(struct slc_record_vec *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_RECORD_VEC_H_ */
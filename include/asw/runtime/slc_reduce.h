@@ -0,0 +1,59 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef ASW__SLC__RUNTIME__SLC_REDUCE_H_
+#define ASW__SLC__RUNTIME__SLC_REDUCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Reduction kernels over a contiguous run of n values, folded into init.
+ * These are shared by the list and vec runtimes and pick the widest SIMD
+ * instruction set the machine supports when the runtime is loaded.
+ */
+int64_t slc_reduce_int_sum(const int64_t *, size_t, int64_t);
+int64_t slc_reduce_int_prod(const int64_t *, size_t, int64_t);
+int64_t slc_reduce_int_min(const int64_t *, size_t, int64_t);
+int64_t slc_reduce_int_max(const int64_t *, size_t, int64_t);
+double slc_reduce_double_sum(const double *, size_t, double);
+double slc_reduce_double_prod(const double *, size_t, double);
+double slc_reduce_double_min(const double *, size_t, double);
+double slc_reduce_double_max(const double *, size_t, double);
+/* the sized numbers, which only vecs hold */
+int8_t slc_reduce_i8_sum(const int8_t *, size_t, int8_t);
+int8_t slc_reduce_i8_prod(const int8_t *, size_t, int8_t);
+int8_t slc_reduce_i8_min(const int8_t *, size_t, int8_t);
+int8_t slc_reduce_i8_max(const int8_t *, size_t, int8_t);
+int16_t slc_reduce_i16_sum(const int16_t *, size_t, int16_t);
+int16_t slc_reduce_i16_prod(const int16_t *, size_t, int16_t);
+int16_t slc_reduce_i16_min(const int16_t *, size_t, int16_t);
+int16_t slc_reduce_i16_max(const int16_t *, size_t, int16_t);
+int32_t slc_reduce_i32_sum(const int32_t *, size_t, int32_t);
+int32_t slc_reduce_i32_prod(const int32_t *, size_t, int32_t);
+int32_t slc_reduce_i32_min(const int32_t *, size_t, int32_t);
+int32_t slc_reduce_i32_max(const int32_t *, size_t, int32_t);
+uint32_t slc_reduce_u32_sum(const uint32_t *, size_t, uint32_t);
+uint32_t slc_reduce_u32_prod(const uint32_t *, size_t, uint32_t);
+uint32_t slc_reduce_u32_min(const uint32_t *, size_t, uint32_t);
+uint32_t slc_reduce_u32_max(const uint32_t *, size_t, uint32_t);
+uint64_t slc_reduce_u64_sum(const uint64_t *, size_t, uint64_t);
+uint64_t slc_reduce_u64_prod(const uint64_t *, size_t, uint64_t);
+uint64_t slc_reduce_u64_min(const uint64_t *, size_t, uint64_t);
+uint64_t slc_reduce_u64_max(const uint64_t *, size_t, uint64_t);
+float slc_reduce_f32_sum(const float *, size_t, float);
+float slc_reduce_f32_prod(const float *, size_t, float);
+float slc_reduce_f32_min(const float *, size_t, float);
+float slc_reduce_f32_max(const float *, size_t, float);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_REDUCE_H_ */
@@ -0,0 +1,55 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_SIZED_LIST_H_
+#define ASW__SLC__RUNTIME__SLC_SIZED_LIST_H_
+
+#include <stdint.h>
+
+/**
+ * Lists of the sized numbers, i8 through f32, see asw/runtime/slc_list.h.
+ * A cell is just the element, so the narrower the element the more of
+ * them fit in a chunk: 56 i32s or 224 i8s against 28 ints.
+ */
+#define SLC_LIST_NAME i8
+#define SLC_LIST_T int8_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#define SLC_LIST_NAME i16
+#define SLC_LIST_T int16_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#define SLC_LIST_NAME i32
+#define SLC_LIST_T int32_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#define SLC_LIST_NAME u32
+#define SLC_LIST_T uint32_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#define SLC_LIST_NAME u64
+#define SLC_LIST_T uint64_t
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#define SLC_LIST_NAME f32
+#define SLC_LIST_T float
+#define SLC_LIST_NUMERIC
+#include <asw/runtime/slc_list.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_SIZED_LIST_H_ */
@@ -0,0 +1,63 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ASW__SLC__RUNTIME__SLC_SIZED_VEC_H_
+#define ASW__SLC__RUNTIME__SLC_SIZED_VEC_H_
+
+#include <stdint.h>
+
+/* vecs of every number type, see asw/runtime/slc_vec.h */
+#define SLC_VEC_NAME int
+#define SLC_VEC_T int64_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME double
+#define SLC_VEC_T double
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+/* the sized ones, i8 through f32, see asw/runtime/slc_sized_list.h for their lists */
+#define SLC_VEC_NAME i8
+#define SLC_VEC_T int8_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME i16
+#define SLC_VEC_T int16_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME i32
+#define SLC_VEC_T int32_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME u32
+#define SLC_VEC_T uint32_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME u64
+#define SLC_VEC_T uint64_t
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#define SLC_VEC_NAME f32
+#define SLC_VEC_T float
+#define SLC_VEC_LIST
+#include <asw/runtime/slc_vec.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_SIZED_VEC_H_ */
@@ -0,0 +1,41 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_STRING_H_
+#define ASW__SLC__RUNTIME__SLC_STRING_H_
+
+#include <stdint.h>
+
+/**
+ * Strings are NUL-terminated and never changed once made, so they are
+ * shared as freely as list cells and passed to C as they are. Each new
+ * string is one allocation of exactly its length: (+ a b c) measures its
+ * parts and then copies each one once, so building text is linear in
+ * what is built rather than in the number of steps taken.
+ */
+
+/* parts[0, n) joined */
+const char * slc_string_concat(const char * const * parts, int64_t n);
+int64_t slc_string_length(const char * s);
+/* negative, zero or positive as a sorts before, with or after b */
+int64_t slc_string_compare(const char * a, const char * b);
+
+/* conversions, a float is written in as few digits as read back the same */
+const char * slc_string_from_int(int64_t i);
+const char * slc_string_from_double(double d);
+/* the number at the start of s, 0 if there is none */
+int64_t slc_string_to_int(const char * s);
+double slc_string_to_double(const char * s);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_STRING_H_ */
@@ -0,0 +1,52 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ASW__SLC__RUNTIME__SLC_STRING_ARGV_H_
+#define ASW__SLC__RUNTIME__SLC_STRING_ARGV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The command line as a list<string>, made by slc_string_list_from_argv for
+ * main's args. It reads argv in place: a list value is the address of its
+ * head's slot in argv, told apart from a regular list by its low bit, so
+ * neither the array nor the strings are copied. It is the compact list of
+ * list<string>, and the slc_string_list_* functions hand it off to these.
+ *
+ * An argv list is read-only like a compact list<int>, and it is never freed.
+ */
+#define SLC_STRING_ARGV_TAG 0x1
+/* the most that decode produces */
+#define SLC_STRING_ARGV_RUN 64
+
+struct slc_string_list;
+
+static inline int slc_string_compact_is(const struct slc_string_list * list)
+{
+  return 0 != ((uintptr_t)list & SLC_STRING_ARGV_TAG);
+}
+
+const char * slc_string_compact_head(struct slc_string_list *);
+struct slc_string_list * slc_string_compact_cdr(struct slc_string_list *);
+int64_t slc_string_compact_length(struct slc_string_list *);
+struct slc_string_list * slc_string_compact_drop(struct slc_string_list *, int64_t);
+int8_t slc_string_compact_destroy(struct slc_string_list *);
+
+/* copy up to SLC_STRING_ARGV_RUN of the pointers into out, and set *next to the list after them */
+size_t slc_string_compact_decode(
+  struct slc_string_list *, const char ** out, struct slc_string_list ** next);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_STRING_ARGV_H_ */
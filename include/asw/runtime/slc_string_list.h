@@ -0,0 +1,29 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_STRING_LIST_H_
+#define ASW__SLC__RUNTIME__SLC_STRING_LIST_H_
+
+/* list<string>, the strings themselves are not copied */
+#define SLC_LIST_NAME string
+#define SLC_LIST_T const char *
+#include <asw/runtime/slc_list.h>
+
+/* main's args, a list over argv itself, see asw/runtime/slc_string_argv.h */
+struct slc_string_list * slc_string_list_from_argv(int64_t argc, const char ** argv);
+
+/* (+ l), every string of l joined into a new one, measured and copied once */
+const char * slc_string_list_add(struct slc_string_list *);
+
+#endif  /* ASW__SLC__RUNTIME__SLC_STRING_LIST_H_ */
@@ -0,0 +1,35 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_SYMBOL_H_
+#define ASW__SLC__RUNTIME__SLC_SYMBOL_H_
+
+/**
+ * Symbols are interned strings: there is one copy of each distinct
+ * string, so two symbols are equal exactly when they are the same
+ * pointer. A symbol is still a NUL-terminated string and can be read as
+ * one. Interned strings stay valid until the program exits.
+ */
+
+/* the canonical copy of s, s is copied the first time it is seen */
+const char * slc_symbol_intern(const char * s);
+/* the same, but s itself becomes the canonical copy, for string literals */
+const char * slc_symbol_intern_static(const char * s);
+
+/* list<symbol>, the same cells as list<string> */
+#define SLC_LIST_NAME symbol
+#define SLC_LIST_T const char *
+#include <asw/runtime/slc_list.h>
+
+#endif  /* ASW__SLC__RUNTIME__SLC_SYMBOL_H_ */
@@ -0,0 +1,99 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Declares the hash table runtime for one key type. Like
+ * asw/runtime/slc_vec.h, this header has no include guard and is included
+ * once per key type with the following defined:
+ *
+ *   SLC_TABLE_NAME  name used in the symbols, slc_<name>_map_* and slc_<name>_set_*
+ *   SLC_TABLE_K     C type of a key
+ *
+ * map<K, V> and set<K> share one table, a set just has no values. The
+ * parameters are undefined again at the end.
+ *
+ * A value is stored as 64 bits: an int as it is, a float bit for bit, a
+ * bool as 0 or 1, and anything else as its pointer. The compiler converts
+ * to and from V, so one runtime serves every value type. The containers
+ * that hold any T, pvec and queue, store their elements the same way.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ASW__SLC__RUNTIME__SLC_TABLE_H_
+#define ASW__SLC__RUNTIME__SLC_TABLE_H_
+#define SLC_TABLE_CAT_(a, b, c) a ## b ## c
+#define SLC_TABLE_CAT(a, b, c) SLC_TABLE_CAT_(a, b, c)
+#endif  /* ASW__SLC__RUNTIME__SLC_TABLE_H_ */
+
+#define SLC_TABLE SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _table)
+#define SLC_TABLE_KEY SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _table_key)
+#define SLC_TABLE_MAP_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _map_ ## fn)
+#define SLC_TABLE_SET_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _set_ ## fn)
+#define SLC_TABLE_LIST SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _list)
+
+struct SLC_TABLE_LIST;
+/* named so that qualifiers apply to the key, even when it is a pointer */
+typedef SLC_TABLE_K SLC_TABLE_KEY;
+
+/**
+ * An open-addressing table with one control byte per slot: empty,
+ * deleted, or the low 7 bits of the hash of a full slot's key. A lookup
+ * compares a group of control bytes at once and only touches the keys
+ * whose 7 bits match. The compiler reads cap, ctrl and keys directly when
+ * looping over a table, so the order of these fields is fixed.
+ */
+struct SLC_TABLE
+{
+  int64_t len;
+  /* slots, a power of two no smaller than a group */
+  int64_t cap;
+  /* cap control bytes, then the first group's again so a group never wraps */
+  int8_t * ctrl;
+  SLC_TABLE_KEY * keys;
+  /* NULL for a set */
+  uint64_t * vals;
+  /* empty slots that can still be filled before the table grows */
+  int64_t growth;
+};
+
+/* map<K, V>, a missing key gets 0, which is the zero of every V */
+struct SLC_TABLE * SLC_TABLE_MAP_FN(create)();
+int8_t SLC_TABLE_MAP_FN(destroy)(struct SLC_TABLE *);
+int64_t SLC_TABLE_MAP_FN(length)(struct SLC_TABLE *);
+struct SLC_TABLE * SLC_TABLE_MAP_FN(put)(struct SLC_TABLE *, SLC_TABLE_KEY, uint64_t);
+uint64_t SLC_TABLE_MAP_FN(get)(struct SLC_TABLE *, SLC_TABLE_KEY);
+int8_t SLC_TABLE_MAP_FN(has)(struct SLC_TABLE *, SLC_TABLE_KEY);
+int8_t SLC_TABLE_MAP_FN(remove)(struct SLC_TABLE *, SLC_TABLE_KEY);
+
+/* set<K> */
+struct SLC_TABLE * SLC_TABLE_SET_FN(create)();
+int8_t SLC_TABLE_SET_FN(destroy)(struct SLC_TABLE *);
+int64_t SLC_TABLE_SET_FN(length)(struct SLC_TABLE *);
+struct SLC_TABLE * SLC_TABLE_SET_FN(put)(struct SLC_TABLE *, SLC_TABLE_KEY);
+int8_t SLC_TABLE_SET_FN(has)(struct SLC_TABLE *, SLC_TABLE_KEY);
+int8_t SLC_TABLE_SET_FN(remove)(struct SLC_TABLE *, SLC_TABLE_KEY);
+struct SLC_TABLE * SLC_TABLE_SET_FN(from_list)(struct SLC_TABLE_LIST *);
+struct SLC_TABLE * SLC_TABLE_SET_FN(from_array)(const SLC_TABLE_KEY *, size_t);
+
+/* print function, a set prints its keys in table order */
+int8_t SLC_TABLE_CAT(print_slc_, SLC_TABLE_NAME, _set)(struct SLC_TABLE *);
+
+#undef SLC_TABLE_LIST
+#undef SLC_TABLE_SET_FN
+#undef SLC_TABLE_MAP_FN
+#undef SLC_TABLE_KEY
+#undef SLC_TABLE
+#undef SLC_TABLE_K
+#undef SLC_TABLE_NAME
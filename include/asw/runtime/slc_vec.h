@@ -0,0 +1,89 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Declares the vec runtime for one numeric element type. Like
+ * asw/runtime/slc_list.h, this header has no include guard and is
+ * included once per element type with the following defined:
+ *
+ *   SLC_VEC_NAME  name used in the symbols, slc_<name>_vec_*
+ *   SLC_VEC_T     C type of an element
+ *   SLC_VEC_LIST  (optional) also declare the conversions to and from
+ *                 slc_<name>_list, for the element types that have one
+ *
+ * The compiler reads len and data directly when indexing and looping, so
+ * the order of the fields is fixed. The parameters are undefined again at
+ * the end.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ASW__SLC__RUNTIME__SLC_VEC_H_
+#define ASW__SLC__RUNTIME__SLC_VEC_H_
+#define SLC_VEC_CAT_(a, b, c) a ## b ## c
+#define SLC_VEC_CAT(a, b, c) SLC_VEC_CAT_(a, b, c)
+#endif  /* ASW__SLC__RUNTIME__SLC_VEC_H_ */
+
+#define SLC_VEC SLC_VEC_CAT(slc_, SLC_VEC_NAME, _vec)
+#define SLC_VEC_FN(fn) SLC_VEC_CAT(SLC_VEC, _, fn)
+
+struct SLC_VEC
+{
+  int64_t len;
+  /* number of elements in storage, 0 for a view into another vec */
+  int64_t cap;
+  SLC_VEC_T * data;
+  SLC_VEC_T storage[];
+};
+
+struct SLC_VEC * SLC_VEC_FN(create)(size_t);
+int8_t SLC_VEC_FN(destroy)(struct SLC_VEC *);
+
+/* unary ops */
+int64_t SLC_VEC_FN(length)(struct SLC_VEC *);
+
+/* views */
+struct SLC_VEC * SLC_VEC_FN(slice)(struct SLC_VEC *, int64_t, int64_t);
+
+/* conversions */
+struct SLC_VEC * SLC_VEC_FN(from_array)(const SLC_VEC_T *, size_t);
+
+#ifdef SLC_VEC_LIST
+struct SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list);
+struct slc_ptr_list;
+struct slc_ptr_vec;
+
+struct SLC_VEC * SLC_VEC_FN(from_list)(struct SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list) *);
+struct SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list) * SLC_VEC_FN(to_list)(struct SLC_VEC *);
+/* list<list<T>> to and from a nested vec, see asw/runtime/slc_ptr_vec.h */
+struct slc_ptr_vec * SLC_VEC_FN(from_nested)(struct slc_ptr_list *);
+struct slc_ptr_list * SLC_VEC_FN(to_nested)(struct slc_ptr_vec *);
+#endif
+
+/* vec ops */
+SLC_VEC_T SLC_VEC_FN(add)(struct SLC_VEC *);
+SLC_VEC_T SLC_VEC_FN(subtract)(struct SLC_VEC *);
+SLC_VEC_T SLC_VEC_FN(multiply)(struct SLC_VEC *);
+SLC_VEC_T SLC_VEC_FN(divide)(struct SLC_VEC *);
+SLC_VEC_T SLC_VEC_FN(min)(struct SLC_VEC *);
+SLC_VEC_T SLC_VEC_FN(max)(struct SLC_VEC *);
+
+/* print function */
+int8_t SLC_VEC_CAT(print_, SLC_VEC, )(struct SLC_VEC *);
+
+#undef SLC_VEC_FN
+#undef SLC_VEC
+#undef SLC_VEC_LIST
+#undef SLC_VEC_T
+#undef SLC_VEC_NAME
@@ -24,12 +24,14 @@ namespace asw::slc
 /* forward declarations */
 struct variable_definition;
 struct function_definition;
+struct record_definition;
 
 struct scope
 {
   std::shared_ptr<scope> parent = nullptr;
   std::vector<variable_definition *> variables;
   std::vector<function_definition *> functions;
+  std::vector<record_definition *> records;
 };
 
 }  // namespace asw::slc
@@ -15,6 +15,10 @@
 #ifndef ASW__SEMANTICS_HPP_
 #define ASW__SEMANTICS_HPP_
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <asw/slc_node.hpp>
 
 namespace asw::slc
@@ -33,6 +37,7 @@ public:
 
   bool visit_binary_op(binary_op * const op) const override;
   bool visit_node(node * const n) const override;
+  bool visit_record_definition(record_definition * const rec) const override;
   bool visit_function_body(function_body * const body) const override;
   bool visit_function_call(function_call * const call_) const override;
   bool visit_extern_function(extern_function * const func_) const override;
@@ -84,22 +89,70 @@ public:
     return false;
   }
 
+  bool scope_has_record(
+    const std::string & name, const scope * s,
+    record_definition ** p_rec = nullptr) const
+  {
+    for (record_definition * r : s->records) {
+      if (r->get_name() == name) {
+        if (nullptr != p_rec) {
+          *p_rec = r;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
   bool scope_has_definition(
     const std::string & name, const scope * s,
     definition ** p_def = nullptr) const
   {
     function_definition * func;
     variable_definition * var;
+    record_definition * rec;
     if (scope_has_function(name, s, &func)) {
       *p_def = func;
       return true;
     } else if (scope_has_variable(name, s, &var)) {
       *p_def = var;
       return true;
+    } else if (scope_has_record(name, s, &rec)) {
+      *p_def = rec;
+      return true;
     }
     return false;
   }
 
+  void find_captures(lambda * const fn, node * const n) const;
+  bool visit_dynamic_call(function_call * const call_, formal * const param) const;
+  bool check_lambda_argument(
+    function_call * const call_, std::size_t x, formal * const param,
+    bool * added = nullptr) const;
+  bool check_dynamic_calls() const;
+  bool visit_record_construction(function_call * const call_, record_definition * const rec) const;
+  record_definition * find_record(const std::string & name, node * const from) const;
+  void resolve_record_types(
+    type_info * const t, node * const from, const std::vector<std::string> & known = {}) const;
+  std::string find_type_param(
+    const type_info * const t, const std::vector<std::string> & known) const;
+  bool infer_type_params(
+    const type_info * const param, const type_info * const arg,
+    std::map<std::string, type_info> & bindings) const;
+  void substitute_type_params(
+    node * const n, const std::map<std::string, type_info> & bindings) const;
+  void substitute_type_params(
+    type_info * const t, const std::map<std::string, type_info> & bindings) const;
+  function_definition * instantiate(
+    function_call * const call_, function_definition * const generic) const;
+
+  bool check_function_argument(
+    op_id op, expression * const fn, const std::vector<type_info *> & params,
+    type_info * const ret = nullptr) const;
+  bool check_table_type(node * const n, type_info * const t) const;
+  bool check_table_argument(
+    op_id op, expression * const arg, type_info * const table_t, bool value) const;
+
   template<class ... Args>
   void internal_compiler_error(const char * fmt, Args && ... args) const
   {
@@ -144,6 +197,8 @@ public:
 
 private:
   mutable std::size_t str_counter{0};
+  /* calls through lambda-typed formals */
+  mutable std::vector<function_call *> dynamic_calls_;
   SemanticAnalyzer() = default;
   ~SemanticAnalyzer() override = default;
   inline static SemanticAnalyzer * impl = nullptr;
@@ -15,6 +15,7 @@
 #ifndef ASW__SLC_NODE_HPP_
 #define ASW__SLC_NODE_HPP_
 
+#include <algorithm>
 #include <concepts>
 #include <functional>
 #include <memory>
@@ -61,6 +62,48 @@ enum class op_id
   CAR,
   CDR,
   CONS,
+  LENGTH,
+  COUNT,
+  COMPACT,
+  INTERN,
+  REVERSE,
+  NTH,
+  TAKE,
+  DROP,
+  CONCAT,
+  RANGE,
+  MAP,
+  FILTER,
+  FOLD,
+  SLICE,
+  MIN,
+  MAX,
+  TO_VEC,
+  TO_LIST,
+  TO_MAT,
+  TO_PVEC,
+  TO_STRING,
+  TRANSPOSE,
+  MATMUL,
+  ROW_SUMS,
+  COL_SUMS,
+  COLS,
+  TABLE,
+  /* a table op that makes a max heap, (heap<int> max) */
+  MAX_HEAP,
+  PUT,
+  LOOKUP,
+  HAS,
+  REMOVE,
+  ASSOC,
+  PUSH,
+  POP,
+  PEEK,
+  GET,
+  VALUES,
+  CAST,
+  LANES,
+  SHUFFLE,
   PRINT,
   ASSIGN,
   INVALID,
@@ -102,6 +145,88 @@ inline std::string op_to_str(op_id id)
       return "cdr"s;
     case op_id::CONS:
       return "cons"s;
+    case op_id::LENGTH:
+      return "length"s;
+    case op_id::COUNT:
+      return "count"s;
+    case op_id::COMPACT:
+      return "compact"s;
+    case op_id::INTERN:
+      return "intern"s;
+    case op_id::REVERSE:
+      return "reverse"s;
+    case op_id::NTH:
+      return "nth"s;
+    case op_id::TAKE:
+      return "take"s;
+    case op_id::DROP:
+      return "drop"s;
+    case op_id::CONCAT:
+      return "concat"s;
+    case op_id::RANGE:
+      return "range"s;
+    case op_id::MAP:
+      return "map"s;
+    case op_id::FILTER:
+      return "filter"s;
+    case op_id::FOLD:
+      return "fold"s;
+    case op_id::SLICE:
+      return "slice"s;
+    case op_id::MIN:
+      return "min"s;
+    case op_id::MAX:
+      return "max"s;
+    case op_id::TO_VEC:
+      return "vec"s;
+    case op_id::TO_LIST:
+      return "list"s;
+    case op_id::TO_MAT:
+      return "mat"s;
+    case op_id::TO_PVEC:
+      return "pvec"s;
+    case op_id::TO_STRING:
+      return "string"s;
+    case op_id::TRANSPOSE:
+      return "transpose"s;
+    case op_id::MATMUL:
+      return "matmul"s;
+    case op_id::ROW_SUMS:
+      return "rowsum"s;
+    case op_id::COL_SUMS:
+      return "colsum"s;
+    case op_id::COLS:
+      return "cols"s;
+    case op_id::TABLE:
+      return "table"s;
+    case op_id::MAX_HEAP:
+      return "max heap"s;
+    case op_id::PUT:
+      return "put"s;
+    case op_id::LOOKUP:
+      return "lookup"s;
+    case op_id::HAS:
+      return "has"s;
+    case op_id::REMOVE:
+      return "remove"s;
+    case op_id::ASSOC:
+      return "assoc"s;
+    case op_id::PUSH:
+      return "push"s;
+    case op_id::POP:
+      return "pop"s;
+    case op_id::PEEK:
+      return "peek"s;
+    case op_id::GET:
+      return "get"s;
+    case op_id::VALUES:
+      return "values"s;
+    case op_id::CAST:
+      return "cast"s;
+    case op_id::LANES:
+      return "lanes"s;
+    case op_id::SHUFFLE:
+      return "shuffle"s;
     case op_id::PRINT:
       return "print"s;
     case op_id::INVALID:
@@ -331,6 +456,27 @@ struct node
     return false;
   }
 
+  /**
+   * a copy of this subtree as the parser built it, without anything that
+   * semantic analysis added; generic functions are instantiated from these
+   */
+  node * clone() const
+  {
+    node * ret = this->make_copy();
+    ret->name = name;
+    if (nullptr != location_) {
+      ret->location_ = new location_info(*location_);
+    }
+    if (nullptr != tid) {
+      ret->tid = new type_info(*tid);
+    }
+    for (const node * child : children) {
+      ret->add_child(child->clone());
+    }
+    ret->relink(this);
+    return ret;
+  }
+
   utilities(binary_op)
   utilities(collect_loop)
   utilities(do_loop)
@@ -347,12 +493,35 @@ struct node
   utilities(list_op)
   utilities(literal)
   utilities(loop)
+  utilities(record_definition)
   utilities(set_expression)
   utilities(unary_op)
   utilities(variable_definition)
   utilities(when_loop)
 
 protected:
+  /* a new node of the same type, with whatever isn't a child copied over */
+  virtual node * make_copy() const
+  {
+    return new node();
+  }
+
+  /* point fields that refer to children of original at the copies of them */
+  virtual void relink(const node * const)
+  {
+  }
+
+  template<class T>
+  T * copy_of(const node * const original, T * const child) const
+  {
+    for (size_t x = 0; x < original->children.size(); ++x) {
+      if (original->children[x] == child) {
+        return static_cast<T *>(children[x]);
+      }
+    }
+    return nullptr;
+  }
+
   node * parent_ = nullptr;
   location_info * location_ = nullptr;
   type_info * tid = nullptr;
@@ -399,6 +568,11 @@ struct simple_expression : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new simple_expression();
+  }
+
   /* name */
   /* child */
 };
@@ -464,6 +638,13 @@ struct literal : public simple_expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    auto * ret = new literal();
+    ret->value = value;
+    return ret;
+  }
+
   std::variant<int, double, std::string> value;
 };
 
@@ -507,6 +688,11 @@ struct variable : public simple_expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new variable();
+  }
+
   definition * resolved_definition = nullptr;
   /* referenced var stored in name */
 };
@@ -546,6 +732,13 @@ struct binary_op : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    auto * ret = new binary_op();
+    ret->op = op;
+    return ret;
+  }
+
   op_id op = op_id::INVALID;
   /* name */
   /* children (lhs, rhs) */
@@ -585,10 +778,24 @@ struct list_op : public expression
     return this->oid;
   }
 
+  /**
+   * returns the operand when the op was given a single list, vec, or simd
+   * vector, in which case the op reduces that operand instead of its
+   * argument list.
+   */
+  expression * get_reduced_operand() const;
+
 protected:
+  node * make_copy() const override
+  {
+    auto * ret = new list_op();
+    ret->oid = oid;
+    return ret;
+  }
+
   op_id oid = op_id::INVALID;
   /* name */
-  /* children: list */
+  /* children: list, none for an empty table */
 };
 
 struct unary_op : public expression
@@ -626,8 +833,15 @@ struct unary_op : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    auto * ret = new unary_op();
+    ret->op = op;
+    return ret;
+  }
+
   op_id op = op_id::INVALID;
-  /* name */
+  /* name: the field, or the position in a tuple, for get */
   /* children: list */
 };
 
@@ -671,6 +885,11 @@ struct if_expr : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new if_expr();
+  }
+
   /* name */
   /* children (condition, expression, expression) */
 };
@@ -734,6 +953,17 @@ struct list : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new list();
+  }
+
+  void relink(const node * const original) override
+  {
+    head = copy_of(original, static_cast<const list *>(original)->head);
+    tail = copy_of(original, static_cast<const list *>(original)->tail);
+  }
+
   /* first element in the list */
   expression * head = nullptr;
   /* rest of the list */
@@ -774,6 +1004,28 @@ struct function_call : public expression
     resolved_ = func;
   }
 
+  /* the lambda-typed formal this calls through, if it isn't a known function */
+  formal * get_dynamic_target() const
+  {
+    return dynamic_;
+  }
+
+  void resolve_dynamic(formal * param) const
+  {
+    dynamic_ = param;
+  }
+
+  /* the record this constructs, if it names a record rather than a function */
+  record_definition * get_record() const
+  {
+    return record_;
+  }
+
+  void resolve_record(record_definition * rec) const
+  {
+    record_ = rec;
+  }
+
   std::string print_node(size_t indent_level) const override
   {
     std::string indent = get_indent(indent_level);
@@ -785,7 +1037,14 @@ struct function_call : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new function_call();
+  }
+
   mutable callable * resolved_ = nullptr;
+  mutable formal * dynamic_ = nullptr;
+  mutable record_definition * record_ = nullptr;
   /* name: function to call */
   /* children: arguments */
 };
@@ -825,6 +1084,17 @@ struct function_body : public node
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new function_body();
+  }
+
+  void relink(const node * const original) override
+  {
+    return_expression =
+      copy_of(original, static_cast<const function_body *>(original)->return_expression);
+  }
+
   expression * return_expression = nullptr;
 };
 
@@ -853,6 +1123,11 @@ struct variable_definition : public definition
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new variable_definition();
+  }
+
   /* name */
   /* value (expression) stored as child */
 };
@@ -901,6 +1176,11 @@ struct set_expression : public expression
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new set_expression();
+  }
+
   definition * resolved_definition = nullptr;
   /* name */
   /* value (expression) stored as child */
@@ -941,6 +1221,11 @@ struct iterator_definition : public variable_definition
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new iterator_definition();
+  }
+
   expression * list_;
   /* name */
   /* list */
@@ -965,13 +1250,67 @@ struct formal : public variable_definition
     return ret;
   }
 
+  /* a lambda passed to this formal, returns false if it was already known */
+  bool add_source(lambda * const l)
+  {
+    if (std::find(lambda_sources.begin(), lambda_sources.end(), l) != lambda_sources.end()) {
+      return false;
+    }
+    lambda_sources.push_back(l);
+    return true;
+  }
+
+  /* another lambda-typed formal passed on to this one */
+  bool add_source(formal * const f)
+  {
+    if (f == this ||
+      std::find(formal_sources.begin(), formal_sources.end(), f) != formal_sources.end())
+    {
+      return false;
+    }
+    formal_sources.push_back(f);
+    return true;
+  }
+
+  /* every lambda that can reach this formal, directly or through other formals */
+  std::vector<lambda *> get_targets() const
+  {
+    std::vector<lambda *> ret;
+    std::vector<const formal *> seen = {this};
+    for (std::size_t x = 0; x < seen.size(); ++x) {
+      for (lambda * l : seen[x]->lambda_sources) {
+        if (std::find(ret.begin(), ret.end(), l) == ret.end()) {
+          ret.push_back(l);
+        }
+      }
+      for (const formal * f : seen[x]->formal_sources) {
+        if (std::find(seen.begin(), seen.end(), f) == seen.end()) {
+          seen.push_back(f);
+        }
+      }
+    }
+    return ret;
+  }
+
 protected:
+  node * make_copy() const override
+  {
+    return new formal();
+  }
+
+  std::vector<lambda *> lambda_sources;
+  std::vector<formal *> formal_sources;
   /* name */
 };
 
 struct function_definition : public definition, public callable
 {
-  ~function_definition() override = default;
+  ~function_definition() override
+  {
+    for (function_definition * instance : instances) {
+      delete instance;
+    }
+  }
 
   std::string print_node(size_t indent_level) const override
   {
@@ -1016,9 +1355,66 @@ struct function_definition : public definition, public callable
     return parameters;
   }
 
+  void set_type_params(const std::vector<std::string> & params)
+  {
+    type_params = params;
+  }
+
+  const std::vector<std::string> & get_type_params() const
+  {
+    return type_params;
+  }
+
+  bool is_generic() const
+  {
+    return !type_params.empty();
+  }
+
+  /* the instance of this generic function with the given mangled name, if there is one yet */
+  function_definition * get_instance(const std::string & mangled) const
+  {
+    for (function_definition * instance : instances) {
+      if (instance->get_name() == mangled) {
+        return instance;
+      }
+    }
+    return nullptr;
+  }
+
+  void add_instance(function_definition * const instance)
+  {
+    /* an instance looks things up through this, but isn't a child, so it is never cloned */
+    instance->parent_ = this;
+    instances.push_back(instance);
+  }
+
+  const std::vector<function_definition *> & get_instances() const
+  {
+    return instances;
+  }
+
 protected:
+  node * make_copy() const override
+  {
+    auto * ret = new function_definition();
+    ret->type_params = type_params;
+    return ret;
+  }
+
+  void relink(const node * const original) override
+  {
+    const auto * func = static_cast<const function_definition *>(original);
+    impl = copy_of(original, func->impl);
+    for (formal * param : func->parameters) {
+      parameters.push_back(copy_of(original, param));
+    }
+  }
+
   function_body * impl = nullptr;
   formals parameters;
+  /* type parameters of a generic function, each instance has them substituted */
+  std::vector<std::string> type_params;
+  std::vector<function_definition *> instances;
   /* name */
   /* value (expression) stored as child */
 };
@@ -1070,9 +1466,37 @@ struct lambda : public expression, public callable
     return parameters;
   }
 
+  void add_capture(variable_definition * const def)
+  {
+    if (std::find(captures.begin(), captures.end(), def) == captures.end()) {
+      captures.push_back(def);
+    }
+  }
+
+  /* definitions outside of this lambda that its body refers to, in order of first use */
+  const std::vector<variable_definition *> & get_captures() const
+  {
+    return captures;
+  }
+
 protected:
+  node * make_copy() const override
+  {
+    return new lambda();
+  }
+
+  void relink(const node * const original) override
+  {
+    const auto * fn = static_cast<const lambda *>(original);
+    impl = copy_of(original, fn->impl);
+    for (formal * param : fn->parameters) {
+      parameters.push_back(copy_of(original, param));
+    }
+  }
+
   function_body * impl = nullptr;
   formals parameters;
+  std::vector<variable_definition *> captures;
   /* name */
   /* value (expression) stored as child */
 };
@@ -1099,6 +1523,97 @@ struct extern_function : public function_definition
   {
     return v->visit_extern_function(this);
   }
+
+protected:
+  node * make_copy() const override
+  {
+    return new extern_function();
+  }
+};
+
+struct record_definition : public definition
+{
+  ~record_definition() override = default;
+
+  std::string print_node(size_t indent_level) const override
+  {
+    std::string ret = get_indent(indent_level) + "record_definition(" + this->get_fqn() + "):\n";
+    for (const auto & child : children) {
+      ret += child->print_node(indent_level + 1);
+    }
+    return ret;
+  }
+
+  bool accept(const visitor * v) override
+  {
+    return v->visit_record_definition(this);
+  }
+
+  llvm::Value * accept(const llvm_visitor * v) override
+  {
+    return v->visit_record_definition(this);
+  }
+
+  void set_fields(formals * list)
+  {
+    for (formal * f : *list) {
+      this->add_child(f);
+    }
+    this->fields = *list;
+  }
+
+  const formals & get_fields() const
+  {
+    return fields;
+  }
+
+  /* the position of the named field, or -1 if there is none */
+  int get_field_index(const std::string & field) const
+  {
+    for (std::size_t x = 0; x < fields.size(); ++x) {
+      if (fields[x]->get_name() == field) {
+        return static_cast<int>(x);
+      }
+    }
+    return -1;
+  }
+
+  void set_layout(const std::string & _layout)
+  {
+    layout = _layout;
+  }
+
+  const std::string & get_layout() const
+  {
+    return layout;
+  }
+
+  /* a vec of these is stored as one column per field, rather than whole records in a row */
+  bool is_soa() const
+  {
+    return layout == "soa";
+  }
+
+protected:
+  node * make_copy() const override
+  {
+    auto * ret = new record_definition();
+    ret->layout = layout;
+    return ret;
+  }
+
+  void relink(const node * const original) override
+  {
+    for (formal * field : static_cast<const record_definition *>(original)->fields) {
+      fields.push_back(copy_of(original, field));
+    }
+  }
+
+  formals fields;
+  /* aos or soa, how vecs of this record are laid out */
+  std::string layout = "aos";
+  /* name */
+  /* children: fields */
 };
 
 struct loop : public expression
@@ -1137,6 +1652,12 @@ struct loop : public expression
   }
 
 protected:
+  void relink(const node * const original) override
+  {
+    body_ = copy_of(original, static_cast<const loop *>(original)->body_);
+    iterator_ = copy_of(original, static_cast<const loop *>(original)->iterator_);
+  }
+
   function_body * body_ = nullptr;
   iterator_definition * iterator_ = nullptr;
 };
@@ -1155,6 +1676,11 @@ struct infinite_loop : public loop
     return v->visit_infinite_loop(this);
   }
 
+protected:
+  node * make_copy() const override
+  {
+    return new infinite_loop();
+  }
 };
 
 struct do_loop : public loop
@@ -1170,6 +1696,12 @@ struct do_loop : public loop
   {
     return v->visit_do_loop(this);
   }
+
+protected:
+  node * make_copy() const override
+  {
+    return new do_loop();
+  }
 };
 
 struct collect_loop : public loop
@@ -1185,6 +1717,12 @@ struct collect_loop : public loop
   {
     return v->visit_collect_loop(this);
   }
+
+protected:
+  node * make_copy() const override
+  {
+    return new collect_loop();
+  }
 };
 
 struct when_loop : public loop
@@ -1224,9 +1762,38 @@ struct when_loop : public loop
   }
 
 protected:
+  node * make_copy() const override
+  {
+    return new when_loop();
+  }
+
+  void relink(const node * const original) override
+  {
+    loop::relink(original);
+    condition_ = copy_of(original, static_cast<const when_loop *>(original)->condition_);
+    return_ = copy_of(original, static_cast<const when_loop *>(original)->return_);
+  }
+
   expression * condition_ = nullptr;
   expression * return_ = nullptr;
 };
 
+/* the lambda that expr is, or that the variable expr names is bound to */
+inline lambda * resolve_lambda(expression * const expr)
+{
+  if (expr->is_lambda()) {
+    return expr->as_lambda();
+  }
+  variable * const var = dynamic_cast<variable *>(expr);
+  if (nullptr == var || nullptr == var->get_resolution() ||
+    !var->get_resolution()->is_variable_definition() ||
+    var->get_resolution()->get_children().empty() ||
+    !var->get_resolution()->get_children()[0]->is_lambda())
+  {
+    return nullptr;
+  }
+  return var->get_resolution()->get_children()[0]->as_lambda();
+}
+
 } // namespace asw::slc
 #endif  // ASW__SLC_NODE_HPP_
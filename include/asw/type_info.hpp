@@ -15,27 +15,96 @@
 #ifndef ASW__TYPE_INFO_HPP_
 #define ASW__TYPE_INFO_HPP_
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace asw::slc
 {
 enum class type_id
 {
   INT,
   FLOAT,
+  /* sized numbers, int and float are 64 bits */
+  I8,
+  I16,
+  I32,
+  U32,
+  U64,
+  F32,
   STRING,
+  /* an interned string, compared and hashed by its address */
+  SYMBOL,
   BOOL,
   LAMBDA,
   VARIABLE,
   NIL,
   LIST,
+  VEC,
+  /* a dense row-major matrix of int or float */
+  MAT,
+  /* hash tables keyed by int, float, string, or symbol, a map's value type is in elems */
+  MAP,
+  SET,
+  /* a persistent vector, an RRB tree from the runtime */
+  PVEC,
+  /* a ring buffer queue, and a 4-ary heap of int or float */
+  QUEUE,
+  HEAP,
+  /* text appended to in place, from the runtime, until it is made a string */
+  BUILDER,
+  RECORD,
+  TUPLE,
+  /* a fixed number of lanes of a number or bool, f64x4 */
+  SIMD,
   INVALID,
 };
 
+inline bool is_integer(const type_id id)
+{
+  switch (id) {
+    case type_id::INT:
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+    case type_id::U32:
+    case type_id::U64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+inline bool is_unsigned(const type_id id)
+{
+  return id == type_id::U32 || id == type_id::U64;
+}
+
+inline bool is_floating(const type_id id)
+{
+  return id == type_id::FLOAT || id == type_id::F32;
+}
+
+inline bool is_numeric(const type_id id)
+{
+  return is_integer(id) || is_floating(id);
+}
+
+/* the sized numbers, which lists do not hold */
+inline bool is_sized(const type_id id)
+{
+  return is_numeric(id) && id != type_id::INT && id != type_id::FLOAT;
+}
+
 struct type_info
 {
   type_info() = default;
   type_info(const type_info & other)
   {
     type = other.type;
+    name = other.name;
+    elems = other.elems;
+    lanes = other.lanes;
     if (nullptr != other.subtype) {
       subtype = new type_info(*other.subtype);
     }
@@ -49,6 +118,9 @@ struct type_info
   type_info & operator=(const type_info & other)
   {
     this->type = other.type;
+    this->name = other.name;
+    this->elems = other.elems;
+    this->lanes = other.lanes;
     delete subtype;
     if (nullptr != other.subtype) {
       subtype = new type_info();
@@ -63,10 +135,22 @@ struct type_info
   {
     if (type != rhs.type) {
       return false;
-    } else if (type != type_id::LIST) {
+    } else if (type == type_id::RECORD) {
+      /* records are nominal */
+      return name == rhs.name;
+    } else if (type == type_id::TUPLE) {
+      return elems == rhs.elems;
+    } else if (type == type_id::MAP) {
+      return *subtype == *rhs.subtype && elems == rhs.elems;
+    } else if (type == type_id::SIMD) {
+      return lanes == rhs.lanes && *subtype == *rhs.subtype;
+    } else if (type != type_id::LIST && type != type_id::VEC && type != type_id::MAT &&
+      type != type_id::SET && type != type_id::PVEC && type != type_id::QUEUE &&
+      type != type_id::HEAP)
+    {
       return true;
     }
-    /* both are lists, compare subtypes */
+    /* both are lists (or vecs, mats, sets, pvecs, queues, or heaps), compare subtypes */
     return subtype && rhs.subtype && (*subtype == *rhs.subtype);
   }
 
@@ -88,27 +172,51 @@ struct type_info
     if ((this->type == type_id::LIST) && (other->type == type_id::LIST)) {
       return *this == *other || (this->subtype && other->subtype &&
              this->subtype->converts_to(other->subtype));
+    } else if (compatible(this->type, type_id::LIST, type_id::VEC) &&
+      compatible(other->type, type_id::LIST, type_id::VEC))
+    {
+      /* lists and vecs convert by copying, which needs matching elements */
+      return this->subtype && other->subtype && (*this->subtype == *other->subtype);
     }
     switch (type) {
       case type_id::INT:
-        return compatible(
-          other->type, type_id::STRING, type_id::INT, type_id::FLOAT, type_id::BOOL);
       case type_id::FLOAT:
-        return compatible(
-          other->type, type_id::STRING, type_id::INT, type_id::FLOAT, type_id::BOOL);
+      case type_id::I8:
+      case type_id::I16:
+      case type_id::I32:
+      case type_id::U32:
+      case type_id::U64:
+      case type_id::F32:
       case type_id::BOOL:
-        return compatible(
-          other->type, type_id::STRING, type_id::INT, type_id::FLOAT, type_id::BOOL);
+        /* a scalar is broadcast to every lane of a SIMD vector */
+        return is_numeric(other->type) || compatible(other->type, type_id::STRING, type_id::BOOL) ||
+               (other->type == type_id::SIMD && converts_to(other->subtype));
       case type_id::LAMBDA:
         return other->type == type_id::LAMBDA;
       case type_id::STRING:
         return compatible(
           other->type, type_id::STRING, type_id::BOOL);
+      case type_id::SYMBOL:
+        /* a symbol reads as its string, the other way takes an intern */
+        return compatible(
+          other->type, type_id::SYMBOL, type_id::STRING);
       case type_id::VARIABLE:
       case type_id::NIL:
       case type_id::LIST:
+      case type_id::VEC:
         return compatible(
           other->type, type_id::BOOL);
+      case type_id::MAT:
+      case type_id::MAP:
+      case type_id::SET:
+      case type_id::PVEC:
+      case type_id::QUEUE:
+      case type_id::HEAP:
+      case type_id::BUILDER:
+      case type_id::RECORD:
+      case type_id::TUPLE:
+      case type_id::SIMD:
+        return *this == *other;
       case type_id::INVALID:
         return false;
     }
@@ -119,6 +227,12 @@ struct type_info
   type_id type = type_id::INVALID;
   /* stores the inner type (for lists) */
   type_info * subtype = nullptr;
+  /* for a type parameter of a generic function (a VARIABLE) or a RECORD, its name */
+  std::string name;
+  /* the element types of a TUPLE, in order, or the value type of a MAP */
+  std::vector<type_info> elems;
+  /* the number of lanes of a SIMD vector, whose subtype is the lane */
+  std::size_t lanes = 0;
 };
 
 using namespace std::string_literals;
@@ -131,14 +245,50 @@ inline std::string type_id_to_str(type_id id)
       return "int"s;
     case type_id::FLOAT:
       return "float"s;
+    case type_id::I8:
+      return "i8"s;
+    case type_id::I16:
+      return "i16"s;
+    case type_id::I32:
+      return "i32"s;
+    case type_id::U32:
+      return "u32"s;
+    case type_id::U64:
+      return "u64"s;
+    case type_id::F32:
+      return "f32"s;
     case type_id::STRING:
       return "string"s;
+    case type_id::SYMBOL:
+      return "symbol"s;
     case type_id::BOOL:
       return "bool"s;
     case type_id::LAMBDA:
       return "lambda"s;
     case type_id::LIST:
       return "list"s;
+    case type_id::VEC:
+      return "vec"s;
+    case type_id::MAT:
+      return "mat"s;
+    case type_id::MAP:
+      return "map"s;
+    case type_id::SET:
+      return "set"s;
+    case type_id::PVEC:
+      return "pvec"s;
+    case type_id::QUEUE:
+      return "queue"s;
+    case type_id::HEAP:
+      return "heap"s;
+    case type_id::BUILDER:
+      return "builder"s;
+    case type_id::RECORD:
+      return "record"s;
+    case type_id::TUPLE:
+      return "tuple"s;
+    case type_id::SIMD:
+      return "simd"s;
     case type_id::VARIABLE:
       return "variable"s;
     case type_id::NIL:
@@ -149,12 +299,81 @@ inline std::string type_id_to_str(type_id id)
   return "unknown_type"s;
 }
 
+/* the lanes of a SIMD type by name, the f64 of f64x4 */
+inline type_id lane_type_from_str(const std::string & str)
+{
+  const type_id lanes[] = {
+    type_id::I8, type_id::I16, type_id::I32, type_id::U32, type_id::U64, type_id::F32,
+    type_id::BOOL,
+  };
+  if (str == "i64") {
+    return type_id::INT;
+  } else if (str == "f64") {
+    return type_id::FLOAT;
+  }
+  for (const type_id lane : lanes) {
+    if (type_id_to_str(lane) == str) {
+      return lane;
+    }
+  }
+  return type_id::INVALID;
+}
+
 inline std::string type_to_str(type_info * _type)
 {
   if (_type->type == type_id::LIST) {
     return "list<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::VEC) {
+    return "vec<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::MAT) {
+    return "mat<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::MAP) {
+    return "map<"s + type_to_str(_type->subtype) + ", "s + type_to_str(&_type->elems[0]) + ">"s;
+  } else if (_type->type == type_id::SET) {
+    return "set<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::PVEC) {
+    return "pvec<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::QUEUE) {
+    return "queue<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::HEAP) {
+    return "heap<"s + type_to_str(_type->subtype) + ">"s;
+  } else if ((_type->type == type_id::VARIABLE || _type->type == type_id::RECORD) &&
+    !_type->name.empty())
+  {
+    return _type->name;
+  } else if (_type->type == type_id::LAMBDA && nullptr != _type->subtype) {
+    return "lambda<"s + type_to_str(_type->subtype) + ">"s;
+  } else if (_type->type == type_id::SIMD) {
+    /* spelled as in the source, where int and float lanes are i64 and f64 */
+    const type_id lane = _type->subtype->type;
+    return ((lane == type_id::INT) ? "i64"s : (lane == type_id::FLOAT) ? "f64"s :
+           type_id_to_str(lane)) + "x"s + std::to_string(_type->lanes);
+  } else if (_type->type == type_id::TUPLE) {
+    std::string ret = "tuple<"s;
+    for (std::size_t x = 0; x < _type->elems.size(); ++x) {
+      ret += ((x > 0) ? ", "s : ""s) + type_to_str(&_type->elems[x]);
+    }
+    return ret + ">"s;
   }
   return type_id_to_str(_type->type);
 }
+
+/* a type as it appears in the name of a generic function's instance */
+inline std::string mangle_type(const type_info * const _type)
+{
+  std::string ret = type_id_to_str(_type->type);
+  if (_type->type == type_id::RECORD) {
+    ret += "_" + _type->name;
+  } else if (_type->type == type_id::SIMD) {
+    ret += std::to_string(_type->lanes);
+  }
+  for (const type_info & elem : _type->elems) {
+    ret += "_" + mangle_type(&elem);
+  }
+  if (nullptr != _type->subtype) {
+    ret += "_" + mangle_type(_type->subtype);
+  }
+  return ret;
+}
 }  // namespace asw::slc
 #endif  // ASW__TYPE_INFO_HPP_
@@ -41,6 +41,7 @@ struct list_op;
 struct literal;
 struct loop;
 struct node;
+struct record_definition;
 struct set_expression;
 struct simple_expression;
 struct unary_op;
@@ -70,6 +71,7 @@ struct visitor_interface
   virtual return_type visit_list_op(list_op * const) const = 0;
   virtual return_type visit_literal(literal * const) const = 0;
   virtual return_type visit_node(node * const) const = 0;
+  virtual return_type visit_record_definition(record_definition * const) const = 0;
   virtual return_type visit_set_expression(set_expression * const) const = 0;
   virtual return_type visit_simple_expression(simple_expression * const) const = 0;
   virtual return_type visit_unary_op(unary_op * const) const = 0;
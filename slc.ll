@@ -40,11 +40,28 @@
 "lambda" {return LAMBDA;}
 "let" {return LET;}
 "defun" {return DEFUN;}
+"defrecord" {return DEFRECORD;}
 "int" {return INT;}
 "bool" {return BOOL;}
 "float" {return FLOAT;}
+"i8" {return I8;}
+"i16" {return I16;}
+"i32" {return I32;}
+"i64" {return I64;}
+"u32" {return U32;}
+"u64" {return U64;}
+"f32" {return F32;}
+"f64" {return F64;}
 "string" {return STRING;}
+"symbol" {return SYMBOL;}
 "list" {return LIST;}
+"vec" {return VEC;}
+"mat" {return MAT;}
+"pvec" {return PVEC;}
+"queue" {return QUEUE;}
+"heap" {return HEAP;}
+"builder" {return BUILDER;}
+"tuple" {return TUPLE;}
 "print" {return PRINT;}
 "nil" {return NIL;}
 "(" {return LPAREN;}
@@ -63,6 +80,35 @@
 "cons" {return CONS;}
 "cdr" {return CDR;}
 "car" {return CAR;}
+"length" {return LENGTH;}
+"count" {return COUNT;}
+"compact" {return COMPACT;}
+"intern" {return INTERN;}
+"nth" {return NTH;}
+"slice" {return SLICE;}
+"reverse" {return REVERSE;}
+"transpose" {return TRANSPOSE;}
+"matmul" {return MATMUL;}
+"rowsum" {return ROWSUM;}
+"colsum" {return COLSUM;}
+"cols" {return COLS;}
+"take" {return TAKE;}
+"drop" {return DROP;}
+"concat" {return CONCAT;}
+"range" {return RANGE;}
+"map" {return MAP;}
+"filter" {return FILTER;}
+"fold" {return FOLD;}
+"put" {return PUT;}
+"lookup" {return LOOKUP;}
+"has" {return HAS;}
+"remove" {return REMOVE;}
+"assoc" {return ASSOC;}
+"push" {return PUSH;}
+"pop" {return POP;}
+"peek" {return PEEK;}
+"min" {return MIN;}
+"max" {return MAX;}
 "xor" {return XOR;}
 "or" {return OR;}
 "and" {return AND;}
@@ -71,6 +117,9 @@
 "for" {return FOR;}
 "in" {return IN;}
 "set" {return SET;}
+"get" {return GET;}
+"values" {return VALUES;}
+"shuffle" {return SHUFFLE;}
 "do" {return DO;}
 "collect" {return COLLECT;}
 "loop" {return LOOP;}
@@ -83,6 +132,7 @@
 "<=" {return LESS_EQ;}
 "=" {return EQUAL;}
 
+(i8|i16|i32|i64|u32|u64|f32|f64|bool)x[0-9]+ {yylval->sval = strdup(yytext); return SIMD;}
 [a-zA-Z_][a-zA-Z_0-9]* {yylval->sval = strdup(yytext); return IDENTIFIER;}
 [0-9]+\.[0-9]+ 	{yylval->fval = atof(yytext); return FLOAT;}
 [0-9]+		{yylval->ival = atoi(yytext); return INT;}
@@ -14,10 +14,14 @@ extern char * yytext;
 
 %token	<ival>		INT
 %token	<fval> 		FLOAT
-%token	<sval>		STR IDENTIFIER
+%token	<sval>		STR IDENTIFIER SIMD
 %token			PLUS MINUS TIMES DIVIDE NIL SET FOR IN
-%token  		IF NOT LIST DEFUN IMPORT OR AND XOR
-%token  		CAR CDR CONS LAMBDA BOOL STRING SQUOTE EXTERN
+%token  		IF NOT LIST VEC MAT DEFUN DEFRECORD GET IMPORT OR AND XOR
+%token  		CAR CDR CONS LENGTH COUNT COMPACT NTH SLICE MIN MAX LAMBDA BOOL STRING SQUOTE EXTERN
+%token			REVERSE TAKE DROP CONCAT RANGE MAP FILTER FOLD TUPLE VALUES SHUFFLE
+%token			TRANSPOSE MATMUL ROWSUM COLSUM COLS PUT LOOKUP HAS REMOVE SYMBOL INTERN
+%token			PVEC ASSOC PUSH QUEUE HEAP POP PEEK BUILDER
+%token			I8 I16 I32 I64 U32 U64 F32 F64
 %token 			LET LPAREN RPAREN LBRACKET RBRACKET COLON PRINT
 %token			GREATER LESS GREATER_EQ LESS_EQ EQUAL COMMA
 %token                  LOOP DO COLLECT RETURN WHEN
@@ -37,6 +41,7 @@ extern char * yytext;
     asw::slc::definition * def;
     asw::slc::variable_definition * var_def;
     asw::slc::function_definition * func_def;
+    asw::slc::record_definition * rec_def;
     asw::slc::expression * expr;
     asw::slc::list * exprs;
     asw::slc::simple_expression * sexpr;
@@ -46,14 +51,17 @@ extern char * yytext;
     asw::slc::extern_function * exdef;
     asw::slc::lambda * lamda;
     asw::slc::loop * loop;
+    std::vector<std::string> * names;
 }
 
 %type	<node>  	stmt
-%type	<type_id>	type primitive
+%type	<type_id>	type primitive sized simd tuple_elems table
+%type	<names>		type_params names
 %type	<op_id>	        bin_op list_op unary_op
 %type	<def>		definition
 %type	<var_def>	variable_definition
 %type	<func_def>	function_definition
+%type	<rec_def>	record_definition
 %type	<expr>		expression lambda
 %type	<exprs>		expressions
 %type	<sexpr>		sexpr
@@ -87,6 +95,7 @@ stmt:	        definition
 definition:	variable_definition { $$ = $1; }
 	|	function_definition { $$ = $1; }
 	|	extern_definition { $$ = $1; }
+	|	record_definition { $$ = $1; }
 	;
 
 body:	        stmt body
@@ -94,6 +103,35 @@ body:	        stmt body
 		    $2->prepend_child($1);
 		    $$ = $2;
 		}
+	|	LPAREN LET LPAREN names RPAREN expression RPAREN body
+		{
+		    /* (let (a b) e) binds a hidden variable to the tuple e, and each name to an element */
+		    const std::string tuple_name = std::string("values_") +
+		      std::to_string(@2.first_line) + "_" + std::to_string(@2.first_column);
+		    for (std::size_t x = $4->size(); x-- > 0; ) {
+			auto * tuple_var = new asw::slc::variable();
+			tuple_var->set_location(@4.first_line, @4.first_column, yytext);
+			tuple_var->set_name(tuple_name);
+			tuple_var->set_type(asw::slc::type_id::VARIABLE);
+			auto * elem = new asw::slc::unary_op();
+			elem->set_location(@4.first_line, @4.first_column, yytext);
+			elem->set_name(std::to_string(x));
+			elem->set_op(asw::slc::op_id::GET);
+			elem->add_child(tuple_var);
+			auto * def = new asw::slc::variable_definition();
+			def->set_location(@4.first_line, @4.first_column, yytext);
+			def->set_name((*$4)[x]);
+			def->add_child(elem);
+			$8->prepend_child(def);
+		    }
+		    delete $4;
+		    auto * def = new asw::slc::variable_definition();
+		    def->set_location(@2.first_line, @2.first_column, yytext);
+		    def->set_name(tuple_name);
+		    def->add_child($6);
+		    $8->prepend_child(def);
+		    $$ = $8;
+		}
 	|	expression  // function body must end in an expression
 		{
 		    $$ = new asw::slc::function_body();
@@ -166,8 +204,8 @@ loop:           LPAREN LOOP body RPAREN
                         }
 		        delete $6;
                     }
-                    loop->set_loop_body($8);
                     loop->set_iterator(iterator_def);
+                    loop->set_loop_body($8);
                     $$ = loop;
                 }
         |       LPAREN LOOP FOR IDENTIFIER IN expressions WHEN expression RETURN expression RPAREN
@@ -250,8 +288,73 @@ function_definition:
 		    $$->set_formals($5);
 		    delete $5;
 		    $$->set_body($7);
+		}
+	|	LPAREN DEFUN IDENTIFIER LBRACKET type_params RBRACKET LPAREN formals RPAREN body RPAREN
+		{
+		    /* a generic function, instantiated for the types it is called with */
+		    $$ = new asw::slc::function_definition();
+		    $$->set_location(@3.first_line, @3.first_column, yytext);
+		    $$->set_name($3);
+		    free($3);
+		    $$->set_type_params(*$5);
+		    delete $5;
+		    $$->set_formals($8);
+		    delete $8;
+		    $$->set_body($10);
 		};
 
+record_definition:
+		LPAREN DEFRECORD IDENTIFIER LPAREN formals RPAREN RPAREN
+		{
+		    $$ = new asw::slc::record_definition();
+		    $$->set_location(@3.first_line, @3.first_column, yytext);
+		    $$->set_name($3);
+		    free($3);
+		    $$->set_fields($5);
+		    delete $5;
+		}
+	|	LPAREN DEFRECORD IDENTIFIER IDENTIFIER LPAREN formals RPAREN RPAREN
+		{
+		    /* the layout of a vec of these records, aos or soa */
+		    $$ = new asw::slc::record_definition();
+		    $$->set_location(@3.first_line, @3.first_column, yytext);
+		    $$->set_name($3);
+		    free($3);
+		    $$->set_layout($4);
+		    free($4);
+		    $$->set_fields($6);
+		    delete $6;
+		}
+	;
+
+type_params:	type_params COMMA IDENTIFIER
+		{
+		    $1->push_back($3);
+		    free($3);
+		    $$ = $1;
+		}
+	|	IDENTIFIER
+		{
+		    $$ = new std::vector<std::string>();
+		    $$->push_back($1);
+		    free($1);
+		}
+	;
+
+names:		names IDENTIFIER
+		{
+		    $1->push_back($2);
+		    free($2);
+		    $$ = $1;
+		}
+	|	IDENTIFIER
+		{
+		    $$ = new std::vector<std::string>();
+		    $$->push_back($1);
+		    free($1);
+		}
+	;
+
 lambda:         LPAREN LAMBDA LPAREN formals RPAREN body RPAREN
 		{
 		    auto * l = new asw::slc::lambda();
@@ -296,8 +399,105 @@ type:	        primitive
 		    $$->type = asw::slc::type_id::LIST;
 		    $$->subtype = $3;
 		}
+	|	VEC LESS type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::VEC;
+		    $$->subtype = $3;
+		}
+	|	MAT LESS type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::MAT;
+		    $$->subtype = $3;
+		}
+	|	PVEC LESS type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::PVEC;
+		    $$->subtype = $3;
+		}
+	|	IDENTIFIER
+		{
+		    /* a type parameter, or a record */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::VARIABLE;
+		    $$->name = $1;
+		    free($1);
+		}
+	|	LAMBDA LESS type GREATER
+		{
+		    /* the subtype is what the lambda returns */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::LAMBDA;
+		    $$->subtype = $3;
+		}
+	|	TUPLE LESS tuple_elems GREATER
+		{
+		    $$ = $3;
+		}
+	|	simd
+		{
+		    $$ = $1;
+		}
+	|	table
+		{
+		    $$ = $1;
+		}
 		;
 
+table:		MAP LESS type COMMA type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::MAP;
+		    $$->subtype = $3;
+		    $$->elems.push_back(*$5);
+		    delete $5;
+		}
+	|	SET LESS type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::SET;
+		    $$->subtype = $3;
+		}
+	|	QUEUE LESS type GREATER
+		{
+		    /* not tables, but made the same way */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::QUEUE;
+		    $$->subtype = $3;
+		}
+	|	HEAP LESS type GREATER
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::HEAP;
+		    $$->subtype = $3;
+		}
+	|	BUILDER
+		{
+		    /* (builder) or (builder "a" "b"), made like a queue<string> */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::BUILDER;
+		    $$->subtype = new asw::slc::type_info();
+		    $$->subtype->type = asw::slc::type_id::STRING;
+		}
+	;
+
+tuple_elems:	tuple_elems COMMA type
+		{
+		    $1->elems.push_back(*$3);
+		    delete $3;
+		    $$ = $1;
+		}
+	|	type
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::TUPLE;
+		    $$->elems.push_back(*$1);
+		    delete $1;
+		}
+	;
+
 primitive:
 		INT
 		{
@@ -319,11 +519,81 @@ primitive:
 		    $$ = new asw::slc::type_info();
 		    $$->type = asw::slc::type_id::STRING;
 		}
+	|	SYMBOL
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::SYMBOL;
+		}
 	|	LAMBDA
 		{
 		    $$ = new asw::slc::type_info();
 		    $$->type = asw::slc::type_id::LAMBDA;
 		}
+	|	sized
+		{
+		    $$ = $1;
+		}
+	;
+
+sized:		I8
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::I8;
+		}
+	|	I16
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::I16;
+		}
+	|	I32
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::I32;
+		}
+	|	I64
+		{
+		    /* the same as int */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::INT;
+		}
+	|	U32
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::U32;
+		}
+	|	U64
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::U64;
+		}
+	|	F32
+		{
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::F32;
+		}
+	|	F64
+		{
+		    /* the same as float */
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::FLOAT;
+		}
+	;
+
+simd:		SIMD
+		{
+		    /* f64x4 is 4 lanes of f64 */
+		    const std::string name = $1;
+		    free($1);
+		    const std::size_t x = name.rfind('x');
+		    $$ = new asw::slc::type_info();
+		    $$->type = asw::slc::type_id::SIMD;
+		    $$->lanes = std::stoul(name.substr(x + 1));
+		    if (0 == $$->lanes) {
+			yyerror(&@1, root, "a simd type needs at least one lane");
+		    }
+		    $$->subtype = new asw::slc::type_info();
+		    $$->subtype->type = asw::slc::lane_type_from_str(name.substr(0, x));
+		}
 	;
 
 bin_op:       	GREATER {$$ = asw::slc::op_id::GREATER;}
@@ -332,6 +602,18 @@ bin_op:       	GREATER {$$ = asw::slc::op_id::GREATER;}
 	|	LESS_EQ {$$ = asw::slc::op_id::LESS_EQ;}
 	|	EQUAL {$$ = asw::slc::op_id::EQUAL;}
 	|	CONS {$$ = asw::slc::op_id::CONS;}
+	|	NTH {$$ = asw::slc::op_id::NTH;}
+	|	TAKE {$$ = asw::slc::op_id::TAKE;}
+	|	DROP {$$ = asw::slc::op_id::DROP;}
+	|	CONCAT {$$ = asw::slc::op_id::CONCAT;}
+	|	RANGE {$$ = asw::slc::op_id::RANGE;}
+	|	MAP {$$ = asw::slc::op_id::MAP;}
+	|	FILTER {$$ = asw::slc::op_id::FILTER;}
+	|	MATMUL {$$ = asw::slc::op_id::MATMUL;}
+	|	LOOKUP {$$ = asw::slc::op_id::LOOKUP;}
+	|	HAS {$$ = asw::slc::op_id::HAS;}
+	|	REMOVE {$$ = asw::slc::op_id::REMOVE;}
+	|	PUSH {$$ = asw::slc::op_id::PUSH;}
 	;
 
 list_op:	TIMES {$$ = asw::slc::op_id::TIMES;}
@@ -342,11 +624,35 @@ list_op:	TIMES {$$ = asw::slc::op_id::TIMES;}
 	|	OR {$$ = asw::slc::op_id::OR;}
 	|	XOR {$$ = asw::slc::op_id::XOR;}
         |       PRINT {$$ = asw::slc::op_id::PRINT;}
+	|	MIN {$$ = asw::slc::op_id::MIN;}
+	|	MAX {$$ = asw::slc::op_id::MAX;}
+	|	SLICE {$$ = asw::slc::op_id::SLICE;}
+	|	FOLD {$$ = asw::slc::op_id::FOLD;}
+	|	VALUES {$$ = asw::slc::op_id::VALUES;}
+	|	SHUFFLE {$$ = asw::slc::op_id::SHUFFLE;}
+	|	PUT {$$ = asw::slc::op_id::PUT;}
+	|	ASSOC {$$ = asw::slc::op_id::ASSOC;}
 	;
 
 unary_op:       NOT {$$ = asw::slc::op_id::NOT;}
 	|	CAR {$$ = asw::slc::op_id::CAR;}
 	|	CDR {$$ = asw::slc::op_id::CDR;}
+	|	LENGTH {$$ = asw::slc::op_id::LENGTH;}
+	|	COUNT {$$ = asw::slc::op_id::COUNT;}
+	|	COMPACT {$$ = asw::slc::op_id::COMPACT;}
+	|	INTERN {$$ = asw::slc::op_id::INTERN;}
+	|	STRING {$$ = asw::slc::op_id::TO_STRING;}
+	|	REVERSE {$$ = asw::slc::op_id::REVERSE;}
+	|	VEC {$$ = asw::slc::op_id::TO_VEC;}
+	|	LIST {$$ = asw::slc::op_id::TO_LIST;}
+	|	MAT {$$ = asw::slc::op_id::TO_MAT;}
+	|	PVEC {$$ = asw::slc::op_id::TO_PVEC;}
+	|	TRANSPOSE {$$ = asw::slc::op_id::TRANSPOSE;}
+	|	ROWSUM {$$ = asw::slc::op_id::ROW_SUMS;}
+	|	COLSUM {$$ = asw::slc::op_id::COL_SUMS;}
+	|	COLS {$$ = asw::slc::op_id::COLS;}
+	|	POP {$$ = asw::slc::op_id::POP;}
+	|	PEEK {$$ = asw::slc::op_id::PEEK;}
 	;
 
 expressions:	expressions expression
@@ -409,6 +715,100 @@ expression:
 		    $$->add_child($3);
 		    ((asw::slc::list_op *)$$)->set_op($2);
 		}
+	|	LPAREN GET expression IDENTIFIER RPAREN
+		{
+		    /* a field of a record, or the column of a vec of records */
+		    auto * op = new asw::slc::unary_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name($4);
+		    free($4);
+		    op->set_op(asw::slc::op_id::GET);
+		    op->add_child($3);
+		    $$ = op;
+		}
+	|	LPAREN sized expression RPAREN
+		{
+		    /* a conversion, (i32 x), the type is known up front */
+		    auto * op = new asw::slc::unary_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_op(asw::slc::op_id::CAST);
+		    op->set_type($2);
+		    op->add_child($3);
+		    $$ = op;
+		}
+	|	LPAREN simd expressions RPAREN
+		{
+		    /* (f64x4 a b c d) sets each lane, (f64x4 a) sets all of them */
+		    auto * op = new asw::slc::list_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(
+			std::string("list_op_") +
+			std::to_string(@$.first_line) + "_" + std::to_string(@$.first_column));
+		    op->set_op(asw::slc::op_id::LANES);
+		    op->set_type($2);
+		    op->add_child($3);
+		    $$ = op;
+		}
+	|	LPAREN table RPAREN
+		{
+		    /* an empty table, (map<string, int>) or (set<int>) */
+		    auto * op = new asw::slc::list_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(
+			std::string("list_op_") +
+			std::to_string(@$.first_line) + "_" + std::to_string(@$.first_column));
+		    op->set_op(asw::slc::op_id::TABLE);
+		    op->set_type($2);
+		    $$ = op;
+		}
+	|	LPAREN table expressions RPAREN
+		{
+		    /* (set<int> 1 2 3) or (set<int> l) for its keys, (map<string, int> "a" 1 "b" 2) */
+		    auto * op = new asw::slc::list_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(
+			std::string("list_op_") +
+			std::to_string(@$.first_line) + "_" + std::to_string(@$.first_column));
+		    op->set_op(asw::slc::op_id::TABLE);
+		    op->set_type($2);
+		    op->add_child($3);
+		    $$ = op;
+		}
+	|	LPAREN table MAX RPAREN
+		{
+		    /* an empty max heap, (heap<int> max) */
+		    auto * op = new asw::slc::list_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(
+			std::string("list_op_") +
+			std::to_string(@$.first_line) + "_" + std::to_string(@$.first_column));
+		    op->set_op(asw::slc::op_id::MAX_HEAP);
+		    op->set_type($2);
+		    $$ = op;
+		}
+	|	LPAREN table MAX expressions RPAREN
+		{
+		    /* (heap<int> max 3 1 2) or (heap<int> max l) */
+		    auto * op = new asw::slc::list_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(
+			std::string("list_op_") +
+			std::to_string(@$.first_line) + "_" + std::to_string(@$.first_column));
+		    op->set_op(asw::slc::op_id::MAX_HEAP);
+		    op->set_type($2);
+		    op->add_child($4);
+		    $$ = op;
+		}
+	|	LPAREN GET expression INT RPAREN
+		{
+		    /* an element of a tuple, by position */
+		    auto * op = new asw::slc::unary_op();
+		    op->set_location(@2.first_line, @2.first_column, yytext);
+		    op->set_name(std::to_string($4));
+		    op->set_op(asw::slc::op_id::GET);
+		    op->add_child($3);
+		    $$ = op;
+		}
         |       LPAREN SET IDENTIFIER expression RPAREN
                 {
                     auto * p = new asw::slc::set_expression();
@@ -504,6 +904,16 @@ sexpr:	        IDENTIFIER
 		    /* minus 1 to include the quote character */
 		    $$->set_location(@1.first_line, @1.first_column - 1, yytext);
 		}
+	|	SQUOTE IDENTIFIER
+		{
+		    /* a symbol, 'name */
+		    auto * lit = new asw::slc::literal();
+		    lit->set_value(std::string($2));
+		    free($2);
+		    lit->set_type(asw::slc::type_id::SYMBOL);
+		    $$ = lit;
+		    $$->set_location(@1.first_line, @1.first_column, yytext);
+		}
 	|	NIL
 		{
 		    auto * lit = new asw::slc::literal();
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include <asw/llvm_codegen.hpp>
 #include <asw/slc_node.hpp>
 
@@ -28,22 +30,52 @@ codegen::codegen()
 llvm::Value * codegen::visit(node * const n) const
 {
   n->mark_visiting();
-  _insert_slc_int_list_functions();
-  _insert_slc_double_list_functions();
+  _insert_runtime_functions();
   llvm::Value * ret = n->accept(this);
+  _intern_symbols();
   n->mark_visited();
   return ret;
 }
 
+void codegen::optimize() const
+{
+  /* the passes make target dependent choices, so give them the target llc will use */
+  llvm::InitializeNativeTarget();
+  std::string triple = llvm::sys::getDefaultTargetTriple();
+  std::string err;
+  const llvm::Target * target = llvm::TargetRegistry::lookupTarget(triple, err);
+  if (nullptr == target) {
+    internal_compiler_error("no target for '%s': %s\n", triple.c_str(), err.c_str());
+    return;
+  }
+  std::unique_ptr<llvm::TargetMachine> machine(
+    target->createTargetMachine(triple, "generic", "", {}, {}));
+  module_->setTargetTriple(triple);
+  module_->setDataLayout(machine->createDataLayout());
+  llvm::LoopAnalysisManager lam;
+  llvm::FunctionAnalysisManager fam;
+  llvm::CGSCCAnalysisManager cgam;
+  llvm::ModuleAnalysisManager mam;
+  llvm::PassBuilder pb(machine.get());
+  pb.registerModuleAnalyses(mam);
+  pb.registerCGSCCAnalyses(cgam);
+  pb.registerFunctionAnalyses(fam);
+  pb.registerLoopAnalyses(lam);
+  pb.crossRegisterProxies(lam, fam, cgam, mam);
+  /* llc only optimizes while lowering, inlining and the loop passes happen here */
+  llvm::ModulePassManager mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+  mpm.run(*module_, mam);
+}
+
 llvm::Value * codegen::visit_extern_function(extern_function * const func_) const
 {
   std::vector<llvm::Type *> formals;
   formals.reserve(func_->get_formals().size());
   for (const formal * param : func_->get_formals()) {
-    formals.push_back(_type_id_to_llvm(param->get_type()->type));
+    formals.push_back(_type_to_llvm(param->get_type()));
   }
   llvm::FunctionType * func__ = llvm::FunctionType::get(
-    _type_id_to_llvm(func_->get_type()->type), formals, false);
+    _type_to_llvm(func_->get_type()), formals, false);
   return llvm::Function::Create(
     func__, llvm::Function::ExternalLinkage, func_->get_name(), module_.get());
 }
@@ -63,7 +95,9 @@ llvm::Value * codegen::visit_literal(literal * const l) const
     case type_id::FLOAT:
       return llvm::ConstantFP::get(*context_, llvm::APFloat(l->get_double()));
     case type_id::STRING:
-      return builder_->CreateGlobalString(l->get_str(), l->get_fqn("."));
+      return _string_literal(l->get_str());
+    case type_id::SYMBOL:
+      return _symbol_literal(l->get_str());
     case type_id::NIL:
       return llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
     default:
@@ -72,8 +106,70 @@ llvm::Value * codegen::visit_literal(literal * const l) const
   return LogErrorV("unknown literal");
 }
 
+llvm::Constant * codegen::_string_literal(const std::string & str) const
+{
+  /* equal literals share one constant */
+  llvm::GlobalVariable *& gv = string_literals_[str];
+  if (nullptr == gv) {
+    llvm::Constant * init = llvm::ConstantDataArray::getString(*context_, str);
+    gv = new llvm::GlobalVariable(
+      *module_, init->getType(), true, llvm::GlobalValue::PrivateLinkage, init, "str");
+    gv->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    gv->setAlignment(llvm::Align(1));
+  }
+  return gv;
+}
+
+llvm::Value * codegen::_symbol_literal(const std::string & name) const
+{
+  /* each distinct symbol has a slot, which _intern_symbols fills before main */
+  llvm::PointerType * ptr_t = llvm::PointerType::get(*context_, 0);
+  llvm::GlobalVariable *& slot = symbols_[name];
+  if (nullptr == slot) {
+    slot = new llvm::GlobalVariable(
+      *module_, ptr_t, false, llvm::GlobalValue::InternalLinkage,
+      llvm::ConstantPointerNull::get(ptr_t), "sym." + name);
+  }
+  return builder_->CreateLoad(ptr_t, slot, name);
+}
+
+void codegen::_intern_symbols() const
+{
+  if (symbols_.empty()) {
+    return;
+  }
+  /* the literal itself becomes the canonical copy, so nothing is copied at startup */
+  llvm::PointerType * ptr_t = llvm::PointerType::get(*context_, 0);
+  llvm::Type * i32_t = llvm::Type::getInt32Ty(*context_);
+  llvm::Function * intern = _runtime_function(
+    type_id::SYMBOL, type_id::STRING, runtime_op::INTERN_STATIC);
+  llvm::Function * ctor = llvm::Function::Create(
+    llvm::FunctionType::get(llvm::Type::getVoidTy(*context_), false),
+    llvm::Function::InternalLinkage, "slc.intern_symbols", module_.get());
+  llvm::IRBuilder<llvm::NoFolder> ctor_builder(
+    llvm::BasicBlock::Create(*context_, "entry", ctor));
+  for (const auto & [name, slot] : symbols_) {
+    ctor_builder.CreateStore(ctor_builder.CreateCall(intern, {_string_literal(name)}, name), slot);
+  }
+  ctor_builder.CreateRetVoid();
+  /* run it like a C constructor, with the default priority */
+  llvm::StructType * entry_t = llvm::StructType::get(*context_, {i32_t, ptr_t, ptr_t});
+  llvm::ArrayType * ctors_t = llvm::ArrayType::get(entry_t, 1);
+  llvm::Constant * entry = llvm::ConstantStruct::get(
+    entry_t, {llvm::ConstantInt::get(i32_t, 65535), ctor, llvm::ConstantPointerNull::get(ptr_t)});
+  new llvm::GlobalVariable(
+    *module_, ctors_t, false, llvm::GlobalValue::AppendingLinkage,
+    llvm::ConstantArray::get(ctors_t, {entry}), "llvm.global_ctors");
+}
+
 llvm::Value * codegen::visit_do_loop(do_loop * const _loop) const
 {
+  const type_info * list_type = _loop->get_iterator()->get_list()->get_type();
+  if (list_type->compatible(
+      list_type->type, type_id::VEC, type_id::MAT, type_id::MAP, type_id::SET, type_id::PVEC))
+  {
+    return _visit_do_loop_vec(_loop);
+  }
   /* save iter variable in case it shadows another variable */
   llvm::Value * old_iter_val = nullptr;
   if (auto it = named_values_.find(_loop->get_iterator()->get_name()); it != named_values_.end()) {
@@ -84,60 +180,52 @@ llvm::Value * codegen::visit_do_loop(do_loop * const _loop) const
   llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
   llvm::BasicBlock * update_bb = llvm::BasicBlock::Create(*context_, "update", func);
   llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
-  llvm::Type * iter_t = _type_id_to_llvm(_loop->get_iterator()->get_type()->type);
+  const type_id list_t = _loop->get_iterator()->get_type()->type;
   llvm::Value * null = llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
-  llvm::AllocaInst * ret_alloca =
-    builder_->CreateAlloca(
-    _type_id_to_llvm(
-      _loop->get_loop_body()->get_return_expression()->get_type()->type),
-    nullptr, "loopret");
-  llvm::AllocaInst * iter_alloca = builder_->CreateAlloca(iter_t, nullptr, "iter_head");
+  llvm::AllocaInst * ret_alloca = _create_entry_alloca(
+    _type_to_llvm(_loop->get_loop_body()->get_return_expression()->get_type()), "loopret");
   /* reserve space for iterator */
   llvm::AllocaInst * list_iter_alloca =
-    builder_->CreateAlloca(llvm::PointerType::get(*context_, 0), nullptr, "iter_tail");
-  /* store the tail of the list in the pointer for the iterator */
-  llvm::Value * init = _loop->get_iterator()->get_list()->accept(this);
-  builder_->CreateStore(_do_cdr(init, _loop->get_iterator()->get_type()->type), list_iter_alloca);
-  /* get the value of the head of the list, and store it in iter */
-  builder_->CreateStore(_do_car(init, _loop->get_iterator()->get_type()->type), iter_alloca);
+    _create_entry_alloca(llvm::PointerType::get(*context_, 0), "iter");
+  /* start the iterator at the head of the list */
+  builder_->CreateStore(_loop->get_iterator()->get_list()->accept(this), list_iter_alloca);
   /* insert explicit fall-through to the check block */
   builder_->CreateBr(check_bb);
   builder_->SetInsertPoint(check_bb);
-  /* load the tail */
-  llvm::Value * tail = builder_->CreateLoad(
-    list_iter_alloca->getAllocatedType(), list_iter_alloca, "tail_iter");
-  /* check if tail is null */
+  llvm::Value * iter = builder_->CreateLoad(
+    list_iter_alloca->getAllocatedType(), list_iter_alloca, "iter");
+  /* if we ran off the end of the list, branch to the end of the loop. otherwise jump to body */
   llvm::Value * cond = builder_->CreateCmp(
-    llvm::CmpInst::Predicate::ICMP_EQ, tail, null,
-    "nullcheck");
-  /* if tail is null, branch to the end of the loop. otherwise jump to body */
+    llvm::CmpInst::Predicate::ICMP_EQ, iter, null, "nullcheck");
   builder_->CreateCondBr(cond, loop_end_bb, loop_bb);
   builder_->SetInsertPoint(loop_bb);
-  /* initialize the iterator to the head of the list */
-  named_values_[_loop->get_iterator()->get_name()] =
-    builder_->CreateLoad(iter_alloca->getAllocatedType(), iter_alloca, "iter_head");
-  /* insert explicit fall-through to the loop block */
-  builder_->SetInsertPoint(loop_bb);
+  /* bind the loop variable to the head of the iterator */
+  named_values_[_loop->get_iterator()->get_name()] = _do_car(iter, list_t);
   /* emit the body */
   builder_->CreateStore(_loop->get_loop_body()->accept(this), ret_alloca);
   /* fall-through to the update step */
   builder_->CreateBr(update_bb);
   builder_->SetInsertPoint(update_bb);
-  /* update the tail iterator */
-  const type_id list_t = _loop->get_iterator()->get_type()->type;
-  builder_->CreateStore(_do_cdr(tail, list_t), list_iter_alloca);
-  builder_->CreateStore(_do_car(tail, list_t), iter_alloca);
+  builder_->CreateStore(_do_cdr(iter, list_t), list_iter_alloca);
   /* brach to check step */
   builder_->CreateBr(check_bb);
   builder_->SetInsertPoint(loop_end_bb);
   named_values_.erase(_loop->get_iterator()->get_name());
-  named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
+  if (nullptr != old_iter_val) {
+    named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
+  }
   return builder_->CreateLoad(
     ret_alloca->getAllocatedType(), ret_alloca, "loopret");
 }
 
 llvm::Value * codegen::visit_collect_loop(collect_loop * const _loop) const
 {
+  const type_info * list_type = _loop->get_iterator()->get_list()->get_type();
+  if (list_type->compatible(
+      list_type->type, type_id::VEC, type_id::MAT, type_id::MAP, type_id::SET, type_id::PVEC))
+  {
+    return _visit_collect_loop_vec(_loop);
+  }
   /* save iter variable in case it shadows another variable */
   llvm::Value * old_iter_val = nullptr;
   if (auto it = named_values_.find(_loop->get_iterator()->get_name()); it != named_values_.end()) {
@@ -148,59 +236,225 @@ llvm::Value * codegen::visit_collect_loop(collect_loop * const _loop) const
   llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
   llvm::BasicBlock * update_bb = llvm::BasicBlock::Create(*context_, "update", func);
   llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
-  llvm::Type * iter_t = _type_id_to_llvm(_loop->get_iterator()->get_type()->type);
+  const type_id list_t = _loop->get_iterator()->get_type()->type;
+  const type_id ret_t = _loop->get_loop_body()->get_return_expression()->get_type()->type;
   llvm::Value * null = llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
-  /* create list */
-  llvm::AllocaInst * retlist_alloca =
-    builder_->CreateAlloca(llvm::PointerType::get(*context_, 0), nullptr, "retlist");
-  /* store null in the retlist */
-  builder_->CreateStore(null, retlist_alloca);
-  llvm::AllocaInst * iter_alloca = builder_->CreateAlloca(iter_t, nullptr, "iter_head");
-  /* reserve space for iterator */
+  /* reserve space for the iterator and the output cursor */
   llvm::AllocaInst * list_iter_alloca =
-    builder_->CreateAlloca(llvm::PointerType::get(*context_, 0), nullptr, "iter_tail");
-  /* store the tail of the list in the pointer for the iterator */
+    _create_entry_alloca(llvm::PointerType::get(*context_, 0), "iter");
+  llvm::AllocaInst * out_iter_alloca =
+    _create_entry_alloca(llvm::PointerType::get(*context_, 0), "out");
   llvm::Value * init = _loop->get_iterator()->get_list()->accept(this);
-  builder_->CreateStore(_do_cdr(init, _loop->get_iterator()->get_type()->type), list_iter_alloca);
-  /* get the value of the head of the list, and store it in iter */
-  builder_->CreateStore(_do_car(init, _loop->get_iterator()->get_type()->type), iter_alloca);
+  builder_->CreateStore(init, list_iter_alloca);
+  /* one element is collected per input element, so allocate the result up front */
+  llvm::Value * retlist = _do_reserve(_do_length(init, list_t), ret_t);
+  builder_->CreateStore(retlist, out_iter_alloca);
   /* insert explicit fall-through to the check block */
   builder_->CreateBr(check_bb);
   builder_->SetInsertPoint(check_bb);
-  /* load the tail */
-  llvm::Value * tail = builder_->CreateLoad(
-    list_iter_alloca->getAllocatedType(), list_iter_alloca, "tail_iter");
-  /* check if tail is null */
+  llvm::Value * iter = builder_->CreateLoad(
+    list_iter_alloca->getAllocatedType(), list_iter_alloca, "iter");
+  /* if we ran off the end of the list, branch to the end of the loop. otherwise jump to body */
   llvm::Value * cond = builder_->CreateCmp(
-    llvm::CmpInst::Predicate::ICMP_EQ, tail, null,
-    "nullcheck");
-  /* if tail is null, branch to the end of the loop. otherwise jump to body */
+    llvm::CmpInst::Predicate::ICMP_EQ, iter, null, "nullcheck");
   builder_->CreateCondBr(cond, loop_end_bb, loop_bb);
   builder_->SetInsertPoint(loop_bb);
-  /* initialize the iterator to the head of the list */
-  named_values_[_loop->get_iterator()->get_name()] =
-    builder_->CreateLoad(iter_alloca->getAllocatedType(), iter_alloca, "iter_head");
-  /* insert explicit fall-through to the loop block */
+  /* bind the loop variable to the head of the iterator */
+  named_values_[_loop->get_iterator()->get_name()] = _do_car(iter, list_t);
+  /* emit the body, and write the result to the output cursor */
+  llvm::Value * val = _loop->get_loop_body()->accept(this);
+  llvm::Value * out = builder_->CreateLoad(
+    out_iter_alloca->getAllocatedType(), out_iter_alloca, "out");
+  _do_set_head(out, val, ret_t);
+  builder_->CreateStore(_do_cdr(out, ret_t), out_iter_alloca);
+  /* fall-through to the update step */
+  builder_->CreateBr(update_bb);
+  builder_->SetInsertPoint(update_bb);
+  builder_->CreateStore(_do_cdr(iter, list_t), list_iter_alloca);
+  /* brach to check step */
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(loop_end_bb);
+  named_values_.erase(_loop->get_iterator()->get_name());
+  if (nullptr != old_iter_val) {
+    named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
+  }
+  return retlist;
+}
+
+llvm::Value * codegen::_visit_do_loop_vec(do_loop * const _loop) const
+{
+  /* save iter variable in case it shadows another variable */
+  llvm::Value * old_iter_val = nullptr;
+  if (auto it = named_values_.find(_loop->get_iterator()->get_name()); it != named_values_.end()) {
+    old_iter_val = it->second;
+  }
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * check_bb = llvm::BasicBlock::Create(*context_, "check", func);
+  llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
+  llvm::BasicBlock * update_bb = llvm::BasicBlock::Create(*context_, "update", func);
+  llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
+  llvm::AllocaInst * ret_alloca = _create_entry_alloca(
+    _type_to_llvm(_loop->get_loop_body()->get_return_expression()->get_type()), "loopret");
+  /* vecs are walked by index, so the loop has a known trip count */
+  llvm::AllocaInst * idx_alloca = _create_entry_alloca(llvm::Type::getInt64Ty(*context_), "idx");
+  llvm::Value * vec = _loop->get_iterator()->get_list()->accept(this);
+  std::function<llvm::Value *(llvm::Value *, llvm::BasicBlock *)> load;
+  llvm::Value * len = _vec_loop_source(_loop->get_iterator(), vec, load);
+  builder_->CreateStore(llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0), idx_alloca);
+  /* insert explicit fall-through to the check block */
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(check_bb);
+  llvm::Value * idx = builder_->CreateLoad(idx_alloca->getAllocatedType(), idx_alloca, "idx");
+  llvm::Value * cond = builder_->CreateCmp(
+    llvm::CmpInst::Predicate::ICMP_SLT, idx, len, "boundcheck");
+  builder_->CreateCondBr(cond, loop_bb, loop_end_bb);
   builder_->SetInsertPoint(loop_bb);
+  /* bind the loop variable to the current element */
+  named_values_[_loop->get_iterator()->get_name()] = load(idx, update_bb);
   /* emit the body */
+  builder_->CreateStore(_loop->get_loop_body()->accept(this), ret_alloca);
+  /* fall-through to the update step */
+  builder_->CreateBr(update_bb);
+  builder_->SetInsertPoint(update_bb);
   builder_->CreateStore(
-    _do_append(
-      builder_->CreateLoad(retlist_alloca->getAllocatedType(), retlist_alloca, "retlist"),
-      _loop->get_loop_body()->accept(this), _loop->get_loop_body()->get_return_expression()->get_type()->type),
-    retlist_alloca);
+    builder_->CreateNSWAdd(idx, llvm::ConstantInt::get(idx->getType(), 1), "next"), idx_alloca);
+  /* brach to check step */
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(loop_end_bb);
+  named_values_.erase(_loop->get_iterator()->get_name());
+  if (nullptr != old_iter_val) {
+    named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
+  }
+  return builder_->CreateLoad(
+    ret_alloca->getAllocatedType(), ret_alloca, "loopret");
+}
+
+llvm::Value * codegen::_visit_collect_loop_vec(collect_loop * const _loop) const
+{
+  /* save iter variable in case it shadows another variable */
+  llvm::Value * old_iter_val = nullptr;
+  if (auto it = named_values_.find(_loop->get_iterator()->get_name()); it != named_values_.end()) {
+    old_iter_val = it->second;
+  }
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * check_bb = llvm::BasicBlock::Create(*context_, "check", func);
+  llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
+  llvm::BasicBlock * update_bb = llvm::BasicBlock::Create(*context_, "update", func);
+  llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
+  const type_id ret_t = _loop->get_loop_body()->get_return_expression()->get_type()->type;
+  /* vecs are walked by index, so the loop has a known trip count */
+  llvm::AllocaInst * idx_alloca = _create_entry_alloca(llvm::Type::getInt64Ty(*context_), "idx");
+  llvm::Value * vec = _loop->get_iterator()->get_list()->accept(this);
+  std::function<llvm::Value *(llvm::Value *, llvm::BasicBlock *)> load;
+  llvm::Value * len = _vec_loop_source(_loop->get_iterator(), vec, load);
+  const type_id list_t = _loop->get_iterator()->get_list()->get_type()->type;
+  const bool table = list_t == type_id::MAP || list_t == type_id::SET;
+  /* the result has the same length, element x is written by iteration x */
+  record_definition * const ret_rec = (ret_t == type_id::RECORD) ?
+    _record_of(_loop->get_loop_body()->get_return_expression()->get_type()) : nullptr;
+  llvm::Value * n = table ? _do_table_field(vec, 0, "tablelen") : len;
+  llvm::Value * retvec = (nullptr != ret_rec) ?
+    _do_record_vec_create(n, ret_rec) : _do_vec_create(n, ret_t);
+  llvm::Value * out = (nullptr != ret_rec) ? nullptr : _do_vec_data(retvec);
+  /* except over a table, where only the full slots write, one after another */
+  llvm::AllocaInst * at_alloca = table ?
+    _create_entry_alloca(llvm::Type::getInt64Ty(*context_), "at") : nullptr;
+  if (table) {
+    builder_->CreateStore(llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0), at_alloca);
+  }
+  builder_->CreateStore(llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0), idx_alloca);
+  /* insert explicit fall-through to the check block */
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(check_bb);
+  llvm::Value * idx = builder_->CreateLoad(idx_alloca->getAllocatedType(), idx_alloca, "idx");
+  llvm::Value * cond = builder_->CreateCmp(
+    llvm::CmpInst::Predicate::ICMP_SLT, idx, len, "boundcheck");
+  builder_->CreateCondBr(cond, loop_bb, loop_end_bb);
+  builder_->SetInsertPoint(loop_bb);
+  /* bind the loop variable to the current element */
+  named_values_[_loop->get_iterator()->get_name()] = load(idx, update_bb);
+  /* emit the body, and write the result to the same index of the output */
+  llvm::Value * val = _loop->get_loop_body()->accept(this);
+  llvm::Value * at = idx;
+  if (table) {
+    at = builder_->CreateLoad(at_alloca->getAllocatedType(), at_alloca, "at");
+    builder_->CreateStore(
+      builder_->CreateNSWAdd(at, llvm::ConstantInt::get(at->getType(), 1), "nextat"), at_alloca);
+  }
+  if (nullptr != ret_rec) {
+    _do_record_vec_store(retvec, at, val, ret_rec);
+  } else {
+    _do_vec_store(out, at, val, ret_t);
+  }
   /* fall-through to the update step */
   builder_->CreateBr(update_bb);
   builder_->SetInsertPoint(update_bb);
-  /* update the tail iterator */
-  const type_id list_t = _loop->get_iterator()->get_type()->type;
-  builder_->CreateStore(_do_cdr(tail, list_t), list_iter_alloca);
-  builder_->CreateStore(_do_car(tail, list_t), iter_alloca);
+  builder_->CreateStore(
+    builder_->CreateNSWAdd(idx, llvm::ConstantInt::get(idx->getType(), 1), "next"), idx_alloca);
   /* brach to check step */
   builder_->CreateBr(check_bb);
   builder_->SetInsertPoint(loop_end_bb);
   named_values_.erase(_loop->get_iterator()->get_name());
-  named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
-  return builder_->CreateLoad(retlist_alloca->getAllocatedType(), retlist_alloca, "retlist");
+  if (nullptr != old_iter_val) {
+    named_values_[_loop->get_iterator()->get_name()] = old_iter_val;
+  }
+  return retvec;
+}
+
+llvm::Value * codegen::_vec_loop_source(
+  iterator_definition * const it, llvm::Value * const vec,
+  std::function<llvm::Value *(llvm::Value *, llvm::BasicBlock *)> & load) const
+{
+  /* set up everything the loads need before the loop, and return the trip count */
+  const type_id elem_t = it->get_type()->type;
+  switch (it->get_list()->get_type()->type) {
+    case type_id::MAT: {
+      /* the rows of a mat, each one is a view rewritten in place, cols past the last */
+      llvm::Value * data = _do_mat_data(vec);
+      llvm::Value * cols = _do_mat_cols(vec);
+      llvm::Value * row = _create_entry_alloca(_vec_struct_type(), "row");
+      const type_id row_t = it->get_type()->subtype->type;
+      load = [this, data, cols, row, row_t](llvm::Value * idx, llvm::BasicBlock *) {
+        return _do_mat_row(data, cols, idx, row, row_t);
+      };
+      return _do_mat_rows(vec);
+    }
+    case type_id::MAP:
+    case type_id::SET: {
+      /* the slots of a map or set, where the free ones are skipped */
+      llvm::Value * data = _do_table_field(vec, 3, "tablekeys");
+      llvm::Value * ctrl = _do_table_field(vec, 2, "tablectrl");
+      load = [this, data, ctrl, elem_t](llvm::Value * idx, llvm::BasicBlock * skip) {
+        _do_table_skip_free(ctrl, idx, skip);
+        return _do_vec_load(data, idx, elem_t);
+      };
+      return _do_table_field(vec, 1, "tablecap");
+    }
+    case type_id::PVEC: {
+      /* the elements of a pvec, a leaf at a time from the runtime */
+      llvm::AllocaInst * cursor = _pvec_cursor();
+      llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+      load = [this, vec, cursor, i64, elem_t](llvm::Value * idx, llvm::BasicBlock *) {
+        return _from_bits(
+          builder_->CreateLoad(i64, _do_pvec_slot(vec, idx, cursor), "bits"), elem_t);
+      };
+      return _do_pvec_length(vec);
+    }
+    default:
+      break;
+  }
+  if (elem_t == type_id::RECORD) {
+    record_definition * const rec = _record_of(it->get_type());
+    load = [this, vec, rec](llvm::Value * idx, llvm::BasicBlock *) {
+      return _do_record_vec_load(vec, idx, rec);
+    };
+  } else {
+    llvm::Value * data = _do_vec_data(vec);
+    load = [this, data, elem_t](llvm::Value * idx, llvm::BasicBlock *) {
+      return _do_vec_load(data, idx, elem_t);
+    };
+  }
+  return _do_vec_length(vec);
 }
 
 llvm::Value * codegen::visit_when_loop(when_loop * const) const
@@ -219,11 +473,56 @@ llvm::Value * codegen::_maybe_convert(node * const n, node * const match) const
     /* convert first */
     switch (match->get_type()->type) {
       case type_id::INT:
-        return _convert_to_int(n->accept(this), n->get_type()->type);
+      case type_id::I8:
+      case type_id::I16:
+      case type_id::I32:
+      case type_id::U32:
+      case type_id::U64:
+        return _convert_to_int(
+          n->accept(this), n->get_type()->type, match->get_type()->type);
       case type_id::FLOAT:
-        return _convert_to_float(n->accept(this), n->get_type()->type);
+      case type_id::F32:
+        return _convert_to_float(
+          n->accept(this), n->get_type()->type, match->get_type()->type);
       case type_id::BOOL:
         return _convert_to_bool(n->accept(this), n->get_type()->type);
+      case type_id::SIMD:
+        return _convert_to_simd(n, match->get_type());
+      case type_id::VEC:
+        if (n->get_type()->type == type_id::LIST && match->get_type()->subtype->subtype) {
+          /* list<list<T>> is flattened into rows over one array */
+          return _call_runtime(
+            type_id::VEC, match->get_type()->subtype->subtype->type, runtime_op::FROM_NESTED,
+            {n->accept(this)}, "tovectmp");
+        } else if (n->get_type()->type == type_id::LIST) {
+          return _do_list_to_vec(n->accept(this), match->get_type()->subtype->type);
+        }
+        return LogErrorV("unknown conversion function");
+      case type_id::MAT:
+        /* copies the rows into one array, both ways are by the element type */
+        return _call_runtime(
+          type_id::MAT, match->get_type()->subtype->type,
+          (n->get_type()->type == type_id::LIST) ? runtime_op::FROM_NESTED : runtime_op::FROM_ROWS,
+          {n->accept(this)}, "tomattmp");
+      case type_id::LIST:
+        if (n->get_type()->type == type_id::MAT) {
+          return _call_runtime(
+            type_id::MAT, match->get_type()->subtype->subtype->type, runtime_op::TO_NESTED,
+            {n->accept(this)}, "tolisttmp");
+        } else if (n->get_type()->type == type_id::VEC && match->get_type()->subtype->subtype) {
+          return _call_runtime(
+            type_id::VEC, match->get_type()->subtype->subtype->type, runtime_op::TO_NESTED,
+            {n->accept(this)}, "tolisttmp");
+        } else if (n->get_type()->type == type_id::VEC) {
+          return _do_vec_to_list(n->accept(this), match->get_type()->subtype->type);
+        }
+        return LogErrorV("unknown conversion function");
+      case type_id::STRING:
+        if (n->get_type()->type == type_id::SYMBOL) {
+          /* a symbol is already its string */
+          return n->accept(this);
+        }
+        return LogErrorV("unknown conversion function");
       default:
         return LogErrorV("unknown conversion function");
     }
@@ -237,11 +536,22 @@ llvm::Value * codegen::_maybe_convert(node * const n, const type_id tid) const
     /* convert first */
     switch (tid) {
       case type_id::INT:
-        return _convert_to_int(n->accept(this), n->get_type()->type);
+      case type_id::I8:
+      case type_id::I16:
+      case type_id::I32:
+      case type_id::U32:
+      case type_id::U64:
+        return _convert_to_int(n->accept(this), n->get_type()->type, tid);
       case type_id::FLOAT:
-        return _convert_to_float(n->accept(this), n->get_type()->type);
+      case type_id::F32:
+        return _convert_to_float(n->accept(this), n->get_type()->type, tid);
       case type_id::BOOL:
         return _convert_to_bool(n->accept(this), n->get_type()->type);
+      case type_id::STRING:
+        if (n->get_type()->type == type_id::SYMBOL) {
+          return n->accept(this);
+        }
+        return LogErrorV("cannot convert to requested type");
       default:
         return LogErrorV("cannot convert to requested type");
     }
@@ -249,18 +559,51 @@ llvm::Value * codegen::_maybe_convert(node * const n, const type_id tid) const
   return n->accept(this);
 }
 
-llvm::Value * codegen::_convert_to_float(llvm::Value * val, const type_id _type) const
+llvm::Value * codegen::_convert_to_simd(node * const n, const type_info * const to) const
+{
+  const type_info * from = n->get_type();
+  if (from->type != type_id::SIMD) {
+    /* a scalar is broadcast to every lane */
+    return builder_->CreateVectorSplat(to->lanes, _maybe_convert(n, to->subtype->type), "splat");
+  }
+  /* otherwise lane by lane, bools are unsigned so true stays 1 */
+  auto is_signed = [](const type_info * t) -> bool {
+      return !is_unsigned(t->subtype->type) && t->subtype->type != type_id::BOOL;
+    };
+  llvm::Value * val = n->accept(this);
+  llvm::Type * to_t = _type_to_llvm(to);
+  return builder_->CreateCast(
+    llvm::CastInst::getCastOpcode(val, is_signed(from), to_t, is_signed(to)), val, to_t,
+    "lanecast");
+}
+
+llvm::Value * codegen::_convert_to_float(
+  llvm::Value * val, const type_id _type, const type_id to) const
 {
+  if (_type == to) {
+    /* also covers the lanes of a vector, which are already the right type */
+    return val;
+  }
   switch (_type) {
     case type_id::INT:
-      return builder_->CreateSIToFP(val, llvm::Type::getDoubleTy(*context_), "doubletmp");
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+      return builder_->CreateSIToFP(val, _type_id_to_llvm(to), "doubletmp");
+    case type_id::U32:
+    case type_id::U64:
+      return builder_->CreateUIToFP(val, _type_id_to_llvm(to), "doubletmp");
     case type_id::BOOL:
-      return builder_->CreateUIToFP(val, llvm::Type::getDoubleTy(*context_), "booltmp");
+      return builder_->CreateUIToFP(val, _type_id_to_llvm(to), "booltmp");
     case type_id::FLOAT:
-      return val;
+    case type_id::F32:
+      return builder_->CreateFPCast(val, _type_id_to_llvm(to), "fpcasttmp");
     case type_id::STRING:
-      /* TODO */
-      return LogErrorV("strings are not implemented");
+    case type_id::SYMBOL:
+      /* parsed as a double, then narrowed */
+      return _convert_to_float(
+        _call_runtime(type_id::STRING, type_id::STRING, runtime_op::TO_FLOAT, {val}, "parsetmp"),
+        type_id::FLOAT, to);
     default:
       return LogErrorV("conversion from invalid type");
   }
@@ -271,11 +614,20 @@ llvm::Value * codegen::_convert_to_bool(llvm::Value * val, const type_id _type)
 {
   switch (_type) {
     case type_id::INT:
-      return val;
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+    case type_id::U32:
+    case type_id::U64:
+      return builder_->CreateICmpNE(
+        val, llvm::ConstantInt::get(val->getType(), 0), "booltmp");
     case type_id::BOOL:
       return val;
     case type_id::FLOAT:
-      return builder_->CreateFPToUI(val, llvm::Type::getInt1Ty(*context_), "booltmp");
+    case type_id::F32:
+      /* unordered, so NaN is true as it is in C */
+      return builder_->CreateFCmpUNE(
+        val, llvm::ConstantFP::get(val->getType(), 0.0), "booltmp");
     case type_id::STRING:
     case type_id::LIST:
       return val;
@@ -285,15 +637,35 @@ llvm::Value * codegen::_convert_to_bool(llvm::Value * val, const type_id _type)
   return LogErrorV("unknown error");
 }
 
-llvm::Value * codegen::_convert_to_int(llvm::Value * val, const type_id _type) const
+llvm::Value * codegen::_convert_to_int(
+  llvm::Value * val, const type_id _type, const type_id to) const
 {
+  if (_type == to) {
+    /* also covers the lanes of a vector, which are already the right type */
+    return val;
+  }
   switch (_type) {
     case type_id::INT:
-      return val;
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+    case type_id::U32:
+    case type_id::U64:
+      /* widening keeps the sign of the source, narrowing truncates */
+      return builder_->CreateIntCast(val, _type_id_to_llvm(to), !is_unsigned(_type), "inttmp");
     case type_id::BOOL:
-      return val;
+      return builder_->CreateZExt(val, _type_id_to_llvm(to), "inttmp");
     case type_id::FLOAT:
-      return builder_->CreateFPToSI(val, llvm::Type::getInt64Ty(*context_), "inttmp");
+    case type_id::F32:
+      if (is_unsigned(to)) {
+        return builder_->CreateFPToUI(val, _type_id_to_llvm(to), "inttmp");
+      }
+      return builder_->CreateFPToSI(val, _type_id_to_llvm(to), "inttmp");
+    case type_id::STRING:
+    case type_id::SYMBOL:
+      return _convert_to_int(
+        _call_runtime(type_id::STRING, type_id::STRING, runtime_op::TO_INT, {val}, "parsetmp"),
+        type_id::INT, to);
     default:
       return LogErrorV("conversion from invalid type");
   }
@@ -307,15 +679,60 @@ llvm::Value * codegen::visit_binary_op(binary_op * const op) const
   /* get codegen for lhs and rhs */
   if (op->get_op() == op_id::CONS) {
     return _create_cons(lhs, rhs);
+  } else if (op->get_op() == op_id::NTH && lhs->get_type()->type == type_id::VEC) {
+    return _do_vec_nth(lhs, rhs);
+  } else if (op->get_op() == op_id::NTH && lhs->get_type()->type == type_id::MAT) {
+    /* a row can outlive the expression, so it is a view from the runtime */
+    return _call_runtime(
+      type_id::MAT, lhs->get_type()->subtype->type, runtime_op::NTH,
+      {lhs->accept(this), _maybe_convert(rhs, type_id::INT)}, "rowtmp");
+  } else if (lhs->get_type()->type == type_id::PVEC) {
+    return _visit_pvec_op(op);
+  } else if (lhs->get_type()->type == type_id::QUEUE || lhs->get_type()->type == type_id::HEAP) {
+    return _visit_queue_push(op);
+  } else if (lhs->get_type()->type == type_id::BUILDER) {
+    /* the text is copied onto the end of the buffer, which grows in place */
+    return _call_runtime(
+      type_id::BUILDER, type_id::STRING, runtime_op::PUSH,
+      {lhs->accept(this), _maybe_convert(rhs, type_id::STRING)}, "pushtmp");
+  } else if (op->get_op() == op_id::MATMUL) {
+    return _call_runtime(
+      type_id::MAT, lhs->get_type()->subtype->type, runtime_op::MATMUL,
+      {lhs->accept(this), rhs->accept(this)}, "matmultmp");
+  } else if (op->get_op() == op_id::LOOKUP || op->get_op() == op_id::HAS ||
+    op->get_op() == op_id::REMOVE)
+  {
+    return _visit_table_op(op);
+  } else if (op->get_op() == op_id::NTH && lhs->get_type()->type == type_id::SIMD) {
+    return builder_->CreateExtractElement(
+      lhs->accept(this), _maybe_convert(rhs, type_id::INT), "lanetmp");
+  } else if (op->get_op() == op_id::NTH || op->get_op() == op_id::TAKE ||
+    op->get_op() == op_id::DROP || op->get_op() == op_id::CONCAT ||
+    op->get_op() == op_id::RANGE || op->get_op() == op_id::MAP ||
+    op->get_op() == op_id::FILTER)
+  {
+    return _visit_list_function(op);
   }
+  type_id lhs_t = lhs->get_type()->type;
+  type_id rhs_t = rhs->get_type()->type;
   llvm::Value * L = lhs->accept(this);
-  llvm::Value * R = rhs->accept(this);
+  llvm::Value * R = nullptr;
+  if (lhs_t == type_id::SIMD) {
+    /* lanes are compared pairwise, once rhs is a vector of the same type */
+    R = _maybe_convert(rhs, lhs);
+    lhs_t = rhs_t = lhs->get_type()->subtype->type;
+  } else {
+    R = rhs->accept(this);
+  }
   /* 0: eq, 1: gt, 2: lt, 3: ge, 4: le */
   std::vector<llvm::CmpInst::Predicate> predicates(5);
   /* check if the types are consistent, and see if we need to convert */
-  switch (lhs->get_type()->type) {
+  switch (lhs_t) {
     case type_id::INT:
-      R = _convert_to_int(R, rhs->get_type()->type);
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+      R = _convert_to_int(R, rhs_t, lhs_t);
       predicates = {
         llvm::CmpInst::Predicate::ICMP_EQ,
         llvm::CmpInst::Predicate::ICMP_SGT,
@@ -324,8 +741,19 @@ llvm::Value * codegen::visit_binary_op(binary_op * const op) const
         llvm::CmpInst::Predicate::ICMP_SLE,
       };
       break;
+    case type_id::U32:
+    case type_id::U64:
+      R = _convert_to_int(R, rhs_t, lhs_t);
+      predicates = {
+        llvm::CmpInst::Predicate::ICMP_EQ,
+        llvm::CmpInst::Predicate::ICMP_UGT,
+        llvm::CmpInst::Predicate::ICMP_ULT,
+        llvm::CmpInst::Predicate::ICMP_UGE,
+        llvm::CmpInst::Predicate::ICMP_ULE,
+      };
+      break;
     case type_id::BOOL:
-      R = _convert_to_bool(R, rhs->get_type()->type);
+      R = _convert_to_bool(R, rhs_t);
       predicates = {
         llvm::CmpInst::Predicate::ICMP_EQ,
         llvm::CmpInst::Predicate::ICMP_UGT,
@@ -335,7 +763,8 @@ llvm::Value * codegen::visit_binary_op(binary_op * const op) const
       };
       break;
     case type_id::FLOAT:
-      R = _convert_to_float(R, rhs->get_type()->type);
+    case type_id::F32:
+      R = _convert_to_float(R, rhs_t, lhs_t);
       predicates = {
         llvm::CmpInst::Predicate::FCMP_UEQ,
         llvm::CmpInst::Predicate::FCMP_UGT,
@@ -345,7 +774,29 @@ llvm::Value * codegen::visit_binary_op(binary_op * const op) const
       };
       break;
     case type_id::NIL:
-      R = _convert_to_bool(R, rhs->get_type()->type);
+      R = _convert_to_bool(R, rhs_t);
+      predicates = {
+        llvm::CmpInst::Predicate::ICMP_EQ,
+        llvm::CmpInst::Predicate::ICMP_UGT,
+        llvm::CmpInst::Predicate::ICMP_ULT,
+        llvm::CmpInst::Predicate::ICMP_UGE,
+        llvm::CmpInst::Predicate::ICMP_ULE,
+      };
+      break;
+    case type_id::STRING:
+      /* by contents, comparing the sign of strcmp with 0 */
+      L = _call_runtime(type_id::STRING, type_id::STRING, runtime_op::COMPARE, {L, R}, "strcmptmp");
+      R = llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0);
+      predicates = {
+        llvm::CmpInst::Predicate::ICMP_EQ,
+        llvm::CmpInst::Predicate::ICMP_SGT,
+        llvm::CmpInst::Predicate::ICMP_SLT,
+        llvm::CmpInst::Predicate::ICMP_SGE,
+        llvm::CmpInst::Predicate::ICMP_SLE,
+      };
+      break;
+    case type_id::SYMBOL:
+      /* interned, so equal symbols are the same pointer, only = gets here */
       predicates = {
         llvm::CmpInst::Predicate::ICMP_EQ,
         llvm::CmpInst::Predicate::ICMP_UGT,
@@ -393,13 +844,20 @@ llvm::Value * codegen::visit_function_body(function_body * const body) const
 
 llvm::Value * codegen::visit_function_call(function_call * const call) const
 {
+  if (nullptr != call->get_dynamic_target()) {
+    return _visit_dynamic_call(call);
+  } else if (nullptr != call->get_record()) {
+    return _visit_record_construction(call);
+  }
   llvm::Function * func = nullptr;
   lambda * as_lambda = dynamic_cast<lambda *>(call->get_resolution());
   if (nullptr != as_lambda) {
     /* this is a safe cast */
     func = module_->getFunction(as_lambda->get_name());
   } else {
-    func = module_->getFunction(call->get_name());
+    /* by the name of what the call resolved to, which is mangled for a generic's instance */
+    func = module_->getFunction(
+      dynamic_cast<function_definition *>(call->get_resolution())->get_name());
   }
   if (nullptr == func) {
     /* look for a lambda */
@@ -408,46 +866,172 @@ llvm::Value * codegen::visit_function_call(function_call * const call) const
   std::vector<llvm::Value *> args;
   callable * resolved = call->get_resolution();
   args.reserve(call->get_children().size());
+  if (nullptr != as_lambda) {
+    /* a known lambda is called directly, with the environment from its closure */
+    args.push_back(_lambda_env(as_lambda));
+  }
   for (size_t x = 0; x < call->get_children().size(); ++x) {
-    args.emplace_back(_maybe_convert(call->get_children()[x], resolved->get_formals()[x]));
+    if (resolved->get_formals()[x]->get_type()->type == type_id::LAMBDA) {
+      /* lambdas are passed as their closures */
+      args.emplace_back(call->get_children()[x]->accept(this));
+      continue;
+    }
+    args.emplace_back(
+      _pass_arg(
+        _maybe_convert(call->get_children()[x], resolved->get_formals()[x]),
+        resolved->get_formals()[x]->get_type()));
   }
   std::string call_name = "calltmp";
   return builder_->CreateCall(func, args, call_name);
 }
 
+llvm::Value * codegen::_visit_dynamic_call(function_call * const call) const
+{
+  const std::vector<lambda *> targets = call->get_dynamic_target()->get_targets();
+  llvm::Type * ret_t = _type_to_llvm(call->get_type());
+  if (targets.empty()) {
+    /* nothing is ever passed to this parameter, so the call is never reached */
+    return llvm::UndefValue::get(ret_t);
+  }
+  llvm::Value * closure = _load_definition(call->get_dynamic_target());
+  llvm::Value * env = builder_->CreateExtractValue(closure, 1, "env");
+  std::vector<llvm::Value *> vals;
+  for (node * arg : call->get_children()) {
+    vals.push_back(arg->accept(this));
+  }
+  /* every possible target is known, so each one gets a direct call */
+  auto call_target = [&](lambda * const fn) -> llvm::Value * {
+      std::vector<llvm::Value *> args = {env};
+      for (std::size_t x = 0; x < vals.size(); ++x) {
+        const type_id from = call->get_children()[x]->get_type()->type;
+        const type_id to = fn->get_formals()[x]->get_type()->type;
+        switch (to) {
+          case type_id::INT:
+          case type_id::I8:
+          case type_id::I16:
+          case type_id::I32:
+          case type_id::U32:
+          case type_id::U64:
+            args.push_back(_convert_to_int(vals[x], from, to));
+            break;
+          case type_id::FLOAT:
+          case type_id::F32:
+            args.push_back(_convert_to_float(vals[x], from, to));
+            break;
+          case type_id::BOOL:
+            args.push_back(_convert_to_bool(vals[x], from));
+            break;
+          default:
+            args.push_back(_pass_arg(vals[x], fn->get_formals()[x]->get_type()));
+            break;
+        }
+      }
+      return builder_->CreateCall(_lambda_function(fn), args, "calltmp");
+    };
+  if (targets.size() == 1) {
+    return call_target(targets[0]);
+  }
+  /* otherwise switch on the function pointer, the last target needs no test */
+  llvm::Value * tag = builder_->CreateExtractValue(closure, 0, "tag");
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * end_bb = llvm::BasicBlock::Create(*context_, "dispatch_end", func);
+  std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> results;
+  for (std::size_t x = 0; x < targets.size(); ++x) {
+    llvm::Function * target = _lambda_function(targets[x]);
+    llvm::BasicBlock * next_bb = nullptr;
+    if (x + 1 < targets.size()) {
+      llvm::BasicBlock * call_bb = llvm::BasicBlock::Create(*context_, "dispatch", func);
+      next_bb = llvm::BasicBlock::Create(*context_, "dispatch_next", func);
+      builder_->CreateCondBr(builder_->CreateICmpEQ(tag, target, "is_target"), call_bb, next_bb);
+      builder_->SetInsertPoint(call_bb);
+    }
+    llvm::Value * ret = call_target(targets[x]);
+    results.emplace_back(ret, builder_->GetInsertBlock());
+    builder_->CreateBr(end_bb);
+    if (nullptr != next_bb) {
+      builder_->SetInsertPoint(next_bb);
+    }
+  }
+  end_bb->moveAfter(&func->back());
+  builder_->SetInsertPoint(end_bb);
+  llvm::PHINode * phi = builder_->CreatePHI(ret_t, results.size(), "dispatchtmp");
+  for (const auto & [val, bb] : results) {
+    phi->addIncoming(val, bb);
+  }
+  return phi;
+}
+
 llvm::Value * codegen::visit_function_definition(function_definition * const func) const
 {
+  if (func->is_generic()) {
+    /* only the instances are emitted, a generic that is never called has none */
+    llvm::Value * ret = llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
+    for (function_definition * instance : func->get_instances()) {
+      ret = instance->accept(this);
+    }
+    return ret;
+  }
   std::vector<llvm::Type *> formals;
   formals.reserve(func->get_formals().size());
   for (const formal * param : func->get_formals()) {
-    formals.push_back(_type_id_to_llvm(param->get_type()->type));
+    formals.push_back(_param_type(param->get_type()));
   }
   llvm::FunctionType * func__ = llvm::FunctionType::get(
-    _type_id_to_llvm(func->get_type()->type), formals, false);
+    _type_to_llvm(func->get_type()), formals, false);
   llvm::Function * func_ = llvm::Function::Create(
     func__, llvm::Function::ExternalLinkage, func->get_name(), module_.get());
-  func_->addFnAttrs(
-    llvm::AttrBuilder(*context_)
-    .addAttribute(llvm::Attribute::AttrKind::NoInline)
-    .addAttribute(llvm::Attribute::AttrKind::OptimizeNone)
-  );
   std::string label = (func->get_name() + "_impl");
   /* record formal names */
   std::size_t x = 0;
   for (auto & arg : func_->args()) {
     arg.setName(func->get_formals()[x++]->get_name());
   }
-  /* map formal names */
-  for (auto & arg : func_->args()) {
-    named_values_[std::string(arg.getName())] = &arg;
-  }
   llvm::BasicBlock * bb = llvm::BasicBlock::Create(*context_, label, func_);
   builder_->SetInsertPoint(bb);
+  /* map formal names */
+  bindings_t saved;
+  for (std::size_t x = 0; x < func->get_formals().size(); ++x) {
+    _bind(
+      func->get_formals()[x]->get_name(),
+      _receive_arg(func_->getArg(x), func->get_formals()[x]->get_type()), saved);
+  }
   llvm::Value * ret = func->get_body()->accept(this);
   builder_->CreateRet(ret);
+  _unbind(saved);
+  if ("main" == func->get_name() && !func->get_formals().empty()) {
+    _emit_main(func_, func);
+  }
   return func_;
 }
 
+void codegen::_emit_main(llvm::Function * const body, function_definition * const func) const
+{
+  /* the body moves aside for the C entry point, which passes argc and argv along */
+  body->setName("slc.main");
+  body->setLinkage(llvm::Function::InternalLinkage);
+  llvm::Type * i32_t = llvm::Type::getInt32Ty(*context_);
+  llvm::Type * i64_t = llvm::Type::getInt64Ty(*context_);
+  llvm::Function * main_ = llvm::Function::Create(
+    llvm::FunctionType::get(i32_t, {i32_t, llvm::PointerType::get(*context_, 0)}, false),
+    llvm::Function::ExternalLinkage, "main", module_.get());
+  main_->getArg(0)->setName("argc");
+  main_->getArg(1)->setName("argv");
+  builder_->SetInsertPoint(llvm::BasicBlock::Create(*context_, "main_impl", main_));
+  llvm::Value * argc = builder_->CreateSExt(main_->getArg(0), i64_t, "argc64");
+  std::vector<llvm::Value *> args = {argc};
+  if (func->get_formals().size() > 1) {
+    /* args reads argv in place, no string is copied */
+    args.push_back(
+      _call_runtime(
+        type_id::LIST, type_id::STRING, runtime_op::FROM_ARGV, {argc, main_->getArg(1)}, "args"));
+  }
+  llvm::Value * ret = builder_->CreateCall(body, args, "calltmp");
+  /* the exit status is an int or bool result, anything else exits with 0 */
+  builder_->CreateRet(
+    ret->getType()->isIntegerTy() ?
+    builder_->CreateZExtOrTrunc(ret, i32_t, "status") : llvm::ConstantInt::get(i32_t, 0));
+}
+
 llvm::Value * codegen::visit_if_expr(if_expr * const if_stmt) const
 {
   llvm::Function * func = builder_->GetInsertBlock()->getParent();
@@ -487,8 +1071,7 @@ llvm::Value * codegen::visit_if_expr(if_expr * const if_stmt) const
   /* emit the merge block */
   func->insert(func->end(), bb_cont);
   builder_->SetInsertPoint(bb_cont);
-  llvm::PHINode * phi = builder_->CreatePHI(
-    _type_id_to_llvm(if_stmt->get_type()->type), 2, "iftmp");
+  llvm::PHINode * phi = builder_->CreatePHI(_type_to_llvm(if_stmt->get_type()), 2, "iftmp");
   phi->addIncoming(affirmative, bb_then);
   phi->addIncoming(else_value, bb_else);
   return phi;
@@ -503,39 +1086,132 @@ llvm::Value * codegen::visit_iterator_definition(iterator_definition * const ite
 
 llvm::Value * codegen::visit_lambda(lambda * const lambda) const
 {
-  std::vector<llvm::Type *> formals;
-  formals.reserve(lambda->get_formals().size());
-  for (const formal * param : lambda->get_formals()) {
-    formals.push_back(_type_id_to_llvm(param->get_type()->type));
-  }
-  llvm::FunctionType * func__ = llvm::FunctionType::get(
-    _type_id_to_llvm(lambda->get_type()->type), formals, false);
-  llvm::Function * func_ = llvm::Function::Create(
-    func__, llvm::Function::ExternalLinkage, lambda->get_name(), module_.get());
-  func_->addFnAttrs(
-    llvm::AttrBuilder(*context_)
-    .addAttribute(llvm::Attribute::AttrKind::NoInline)
-    .addAttribute(llvm::Attribute::AttrKind::OptimizeNone)
-  );
-  std::string label = (lambda->get_name() + "_impl");
-  /* record formal names */
-  std::size_t x = 0;
-  for (auto & arg : func_->args()) {
-    arg.setName(lambda->get_formals()[x++]->get_name());
+  llvm::PointerType * ptr_t = llvm::PointerType::get(*context_, 0);
+  /* captures are copied into the environment where the lambda is made */
+  std::vector<llvm::Value *> captured;
+  std::vector<llvm::Type *> fields;
+  for (variable_definition * def : lambda->get_captures()) {
+    captured.push_back(_load_definition(def));
+    fields.push_back(captured.back()->getType());
   }
-  /* map formal names */
-  for (auto & arg : func_->args()) {
-    named_values_[std::string(arg.getName())] = &arg;
+  llvm::StructType * env_t = llvm::StructType::get(*context_, fields);
+  env_types_[lambda] = env_t;
+  llvm::Value * env = llvm::ConstantPointerNull::get(ptr_t);
+  if (!captured.empty()) {
+    /* a lambda can't outlive the function that makes it, so neither can its environment */
+    env = _create_entry_alloca(env_t, lambda->get_name() + "_env");
+    for (std::size_t x = 0; x < captured.size(); ++x) {
+      builder_->CreateStore(captured[x], builder_->CreateStructGEP(env_t, env, x));
+    }
   }
+  llvm::Function * func_ = _lambda_function(lambda);
+  std::string label = (lambda->get_name() + "_impl");
   llvm::BasicBlock * bb_old = builder_->GetInsertBlock();
   llvm::BasicBlock * bb = llvm::BasicBlock::Create(*context_, label, func_);
   builder_->SetInsertPoint(bb);
+  /* map captured and formal names, a let-bound lambda sees itself through its own environment */
+  bindings_t saved;
+  if (lambda->get_parent()->is_variable_definition()) {
+    _bind(lambda->get_parent()->get_name(), _make_closure(func_, func_->getArg(0)), saved);
+  }
+  _bind_captures(lambda, func_->getArg(0), saved);
+  for (std::size_t x = 0; x < lambda->get_formals().size(); ++x) {
+    _bind(
+      lambda->get_formals()[x]->get_name(),
+      _receive_arg(func_->getArg(x + 1), lambda->get_formals()[x]->get_type()), saved);
+  }
   llvm::Value * ret = lambda->get_body()->accept(this);
   builder_->CreateRet(ret);
+  _unbind(saved);
   builder_->SetInsertPoint(bb_old);  /* continue with parent function */
+  return _make_closure(func_, env);
+}
+
+llvm::Function * codegen::_lambda_function(lambda * const fn) const
+{
+  /* a call through a parameter may come before the lambda itself */
+  if (llvm::Function * func = module_->getFunction(fn->get_name()); nullptr != func) {
+    return func;
+  }
+  /* the environment is passed ahead of the formals */
+  std::vector<llvm::Type *> formals = {llvm::PointerType::get(*context_, 0)};
+  formals.reserve(fn->get_formals().size() + 1);
+  for (const formal * param : fn->get_formals()) {
+    formals.push_back(_param_type(param->get_type()));
+  }
+  llvm::FunctionType * func__ = llvm::FunctionType::get(
+    _type_to_llvm(fn->get_type()), formals, false);
+  llvm::Function * func_ = llvm::Function::Create(
+    func__, llvm::Function::ExternalLinkage, fn->get_name(), module_.get());
+  /* bools cross the call as zero-extended bytes, the same as to and from the runtime */
+  if (fn->get_type()->type == type_id::BOOL) {
+    func_->addRetAttr(llvm::Attribute::AttrKind::ZExt);
+  }
+  for (std::size_t x = 0; x < fn->get_formals().size(); ++x) {
+    if (fn->get_formals()[x]->get_type()->type == type_id::BOOL) {
+      func_->addParamAttr(x + 1, llvm::Attribute::AttrKind::ZExt);
+    }
+  }
+  /* record formal names */
+  func_->getArg(0)->setName("env");
+  for (std::size_t x = 0; x < fn->get_formals().size(); ++x) {
+    func_->getArg(x + 1)->setName(fn->get_formals()[x]->get_name());
+  }
   return func_;
 }
 
+llvm::Value * codegen::_make_closure(llvm::Value * const func, llvm::Value * const env) const
+{
+  llvm::Value * closure = llvm::UndefValue::get(_type_id_to_llvm(type_id::LAMBDA));
+  closure = builder_->CreateInsertValue(closure, func, 0);
+  return builder_->CreateInsertValue(closure, env, 1, "closure");
+}
+
+llvm::Value * codegen::_lambda_env(lambda * const fn) const
+{
+  /* only let-bound lambdas are called by name */
+  return builder_->CreateExtractValue(
+    _load_definition(fn->get_parent()->as_variable_definition()), 1, "env");
+}
+
+void codegen::_bind(const std::string & name, llvm::Value * const val, bindings_t & saved) const
+{
+  auto it = named_values_.find(name);
+  saved.emplace_back(name, (it == named_values_.end()) ? nullptr : it->second);
+  named_values_[name] = val;
+}
+
+void codegen::_bind_captures(lambda * const fn, llvm::Value * const env, bindings_t & saved) const
+{
+  llvm::StructType * env_t = env_types_[fn];
+  for (std::size_t x = 0; x < fn->get_captures().size(); ++x) {
+    const std::string & name = fn->get_captures()[x]->get_name();
+    _bind(
+      name, builder_->CreateLoad(
+        env_t->getElementType(x), builder_->CreateStructGEP(env_t, env, x), name), saved);
+  }
+}
+
+void codegen::_unbind(const bindings_t & saved) const
+{
+  /* latest first, so a name bound twice ends up with what it had before either */
+  for (auto it = saved.rbegin(); it != saved.rend(); ++it) {
+    if (nullptr == it->second) {
+      named_values_.erase(it->first);
+    } else {
+      named_values_[it->first] = it->second;
+    }
+  }
+}
+
+llvm::Value * codegen::_load_definition(variable_definition * const def) const
+{
+  if (auto it = named_values_.find(def->get_name()); it != named_values_.end()) {
+    return it->second;
+  }
+  return _load_var(def->get_scope().get(), def->get_name());
+}
+
 llvm::Type * codegen::_type_id_to_llvm(const type_id id) const
 {
   switch (id) {
@@ -543,18 +1219,61 @@ llvm::Type * codegen::_type_id_to_llvm(const type_id id) const
       return llvm::Type::getInt64Ty(*context_);
     case type_id::FLOAT:
       return llvm::Type::getDoubleTy(*context_);
+    case type_id::I8:
+      return llvm::Type::getInt8Ty(*context_);
+    case type_id::I16:
+      return llvm::Type::getInt16Ty(*context_);
+    case type_id::I32:
+    case type_id::U32:
+      return llvm::Type::getInt32Ty(*context_);
+    case type_id::U64:
+      return llvm::Type::getInt64Ty(*context_);
+    case type_id::F32:
+      return llvm::Type::getFloatTy(*context_);
     case type_id::BOOL:
       return llvm::Type::getInt1Ty(*context_);
     case type_id::STRING:
       return llvm::Type::getInt8Ty(*context_)->getPointerTo();
     case type_id::LIST:
       return llvm::Type::getInt8Ty(*context_)->getPointerTo();
+    case type_id::SYMBOL:
+    case type_id::VEC:
+    case type_id::MAT:
+    case type_id::MAP:
+    case type_id::SET:
+    case type_id::PVEC:
+    case type_id::QUEUE:
+    case type_id::HEAP:
+    case type_id::BUILDER:
+      return llvm::PointerType::get(*context_, 0);
+    case type_id::LAMBDA:
+      /* a closure, {fn *, env *} */
+      return llvm::StructType::get(
+        *context_, {llvm::PointerType::get(*context_, 0), llvm::PointerType::get(*context_, 0)});
     default:
       return nullptr;
   }
   return nullptr;
 }
 
+llvm::Type * codegen::_type_to_llvm(const type_info * const t) const
+{
+  if (t->type == type_id::RECORD) {
+    return record_types_.at(t->name);
+  } else if (t->type == type_id::TUPLE) {
+    /* tuples are structural, so a literal struct of the elements */
+    std::vector<llvm::Type *> elems;
+    elems.reserve(t->elems.size());
+    for (const type_info & elem : t->elems) {
+      elems.push_back(_type_to_llvm(&elem));
+    }
+    return llvm::StructType::get(*context_, elems);
+  } else if (t->type == type_id::SIMD) {
+    return llvm::FixedVectorType::get(_type_id_to_llvm(t->subtype->type), t->lanes);
+  }
+  return _type_id_to_llvm(t->type);
+}
+
 llvm::Value * codegen::visit_variable_definition(variable_definition * const v) const
 {
   llvm::Type * type_ = _type_id_to_llvm(v->get_type()->type);
@@ -570,6 +1289,13 @@ llvm::Value * codegen::visit_variable_definition(variable_definition * const v)
       case type_id::FLOAT:
         type_ = llvm::Type::getDoubleTy(*context_);
         break;
+      case type_id::I8:
+      case type_id::I16:
+      case type_id::I32:
+      case type_id::U32:
+      case type_id::U64:
+      case type_id::F32:
+        break;
       default:
         return LogErrorV("unimplemented global type");
     }
@@ -588,8 +1314,8 @@ llvm::Value * codegen::visit_variable_definition(variable_definition * const v)
     *(scope_to_alloca_map_[v->get_parent()->get_scope().get()]);
   /* generate the initial value */
   llvm::Value * val = v->get_children()[0]->accept(this);
-  /* create alloca for the value */
-  llvm::AllocaInst * var_alloca = builder_->CreateAlloca(val->getType(), nullptr, v->get_name());
+  /* create alloca for the value, in the entry block since lambda bodies are inlined into loops */
+  llvm::AllocaInst * var_alloca = _create_entry_alloca(val->getType(), v->get_name());
   /* store the value in the allocated spot */
   builder_->CreateStore(val, var_alloca);
   /* update the map */
@@ -623,139 +1349,612 @@ llvm::Value * codegen::_store_var(
 
 llvm::Value * codegen::_create_cons(expression * const e, expression * const l) const
 {
+  const type_id elem_type = l->get_type()->subtype->type;
   std::vector<llvm::Value *> args = {
-    _maybe_convert(e, l->get_type()->subtype->type),
+    _to_storage(_maybe_convert(e, elem_type), elem_type),
     l->accept(this)
   };
-  llvm::Function * cons;
-  switch (l->get_type()->subtype->type) {
-    case type_id::INT:
-      cons = module_->getFunction("slc_int_list_cons");
-      break;
-    case type_id::FLOAT:
-      cons = module_->getFunction("slc_double_list_cons");
-      break;
-    default:
-      return LogErrorV("Unimplemented list type in create_cons");
-  }
-  return builder_->CreateCall(cons, args, "binop_cons");
+  return _call_runtime(type_id::LIST, elem_type, runtime_op::CONS, args, "binop_cons");
 }
 
-llvm::Value * codegen::_visit_int_list(list * const l) const
+llvm::AllocaInst * codegen::_create_entry_alloca(llvm::Type * type, const std::string & name) const
 {
-  llvm::Function * create = module_->getFunction("slc_int_list_create");
-  llvm::Function * cons = module_->getFunction("slc_int_list_cons");
-  llvm::Function * set_head = module_->getFunction("slc_int_list_set_head");
-  if (l->get_tail() == nullptr) {
-    llvm::Value * ret = builder_->CreateCall(create);
-    std::vector<llvm::Value *> args = {
-      ret,
-      l->get_head()->accept(this),
-    };
-    /* call set head */
-    builder_->CreateCall(set_head, args, "calltmp");
-    return ret;
-  }
-  std::vector<llvm::Value *> args = {
-    l->get_head()->accept(this),
-    l->get_tail()->accept(this),
-  };
-  /* call cons */
-  return builder_->CreateCall(cons, args, "constmp");
+  /* allocas go in the entry block so that loops don't grow the stack */
+  llvm::BasicBlock & entry = builder_->GetInsertBlock()->getParent()->getEntryBlock();
+  llvm::IRBuilder<llvm::NoFolder> entry_builder(&entry, entry.begin());
+  return entry_builder.CreateAlloca(type, nullptr, name);
 }
 
-llvm::Value * codegen::_visit_float_list(list * const l) const
+llvm::Value * codegen::_do_list_from_array(list * const l, const type_id elem_type) const
 {
-  llvm::Function * create = module_->getFunction("slc_double_list_create");
-  llvm::Function * cons = module_->getFunction("slc_double_list_cons");
-  llvm::Function * set_head = module_->getFunction("slc_double_list_set_head");
-  if (l->get_tail() == nullptr) {
-    llvm::Value * ret = builder_->CreateCall(create);
-    std::vector<llvm::Value *> args = {
-      ret,
-      l->get_head()->accept(this),
-    };
-    /* call set head */
-    builder_->CreateCall(set_head, args, "calltmp");
-    return ret;
+  std::vector<expression *> elems;
+  bool all_constant = true;
+  for (list * iter = l; nullptr != iter; iter = iter->get_tail()) {
+    elems.push_back(iter->get_head());
+    /* symbols are loaded from the slots they are interned into */
+    all_constant &= iter->get_head()->is_literal() &&
+      iter->get_head()->get_type()->type == elem_type && elem_type != type_id::SYMBOL;
+  }
+  llvm::ArrayType * array_t = llvm::ArrayType::get(_elem_storage_type(elem_type), elems.size());
+  llvm::Value * array = nullptr;
+  if (all_constant) {
+    /* constant literals live in read-only data, no stores needed */
+    std::vector<llvm::Constant *> vals;
+    vals.reserve(elems.size());
+    for (expression * const e : elems) {
+      vals.push_back(llvm::cast<llvm::Constant>(e->accept(this)));
+    }
+    auto * gv = new llvm::GlobalVariable(
+      *module_, array_t, true, llvm::GlobalValue::PrivateLinkage,
+      llvm::ConstantArray::get(array_t, vals), "list_literal");
+    gv->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    array = gv;
+  } else {
+    /* fill a stack array with the element values */
+    array = _create_entry_alloca(array_t, "list_elems");
+    for (std::size_t x = 0; x < elems.size(); ++x) {
+      builder_->CreateStore(
+        _to_storage(_maybe_convert(elems[x], elem_type), elem_type),
+        builder_->CreateConstInBoundsGEP2_32(array_t, array, 0, x));
+    }
   }
   std::vector<llvm::Value *> args = {
-    l->get_head()->accept(this),
-    l->get_tail()->accept(this),
+    array,
+    llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), elems.size()),
   };
-  /* call cons */
-  return builder_->CreateCall(cons, args, "constmp");
+  /* one call allocates every cell */
+  return _call_runtime(type_id::LIST, elem_type, runtime_op::FROM_ARRAY, args, "fromarraytmp");
 }
 
 llvm::Value * codegen::visit_list(list * const l) const
 {
-  if (l->get_type()->subtype->type == type_id::INT) {
-    return _visit_int_list(l);
-  } else if (l->get_type()->subtype->type == type_id::FLOAT) {
-    return _visit_float_list(l);
-  }
-
-  return LogErrorV("unimplemented list type in visit_list");
+  return _do_list_from_array(l, l->get_type()->subtype->type);
 }
 
-llvm::Value * codegen::_visit_list_op_int(list_op * const op) const
+llvm::Value * codegen::visit_list_op(list_op * const op) const
 {
-  std::vector<llvm::Value *> args = {
-    op->get_children()[0]->accept(this),
-  };
-  llvm::Function * op_impl;
+  if (op->get_op() == op_id::SLICE) {
+    return _visit_slice(op);
+  } else if (op->get_op() == op_id::VALUES) {
+    return _visit_values(op);
+  } else if (op->get_op() == op_id::FOLD) {
+    return _visit_fold(op);
+  } else if (op->get_op() == op_id::LANES) {
+    return _visit_lanes(op);
+  } else if (op->get_op() == op_id::SHUFFLE) {
+    return _visit_shuffle(op);
+  } else if (op->get_op() == op_id::TABLE && op->get_type()->type == type_id::BUILDER) {
+    return _visit_builder(op);
+  } else if (op->get_op() == op_id::TABLE || op->get_op() == op_id::MAX_HEAP) {
+    return (op->get_type()->type == type_id::QUEUE || op->get_type()->type == type_id::HEAP) ?
+      _visit_queue(op) : _visit_table(op);
+  } else if (op->get_op() == op_id::PUT) {
+    return _visit_put(op);
+  } else if (op->get_op() == op_id::ASSOC) {
+    return _visit_assoc(op);
+  } else if (op->get_type()->type == type_id::LIST || op->get_type()->type == type_id::VEC) {
+    return _visit_mask_op(op);
+  }
+  /* a single list or vec operand is reduced directly, otherwise reduce the arguments */
+  expression * operand = op->get_reduced_operand();
+  if (nullptr != operand && operand->get_type()->type == type_id::SIMD) {
+    return _visit_simd_reduce(op, operand);
+  } else if (nullptr == operand && op->get_type()->type == type_id::STRING) {
+    return _visit_string_concat(op);
+  } else if (nullptr == operand) {
+    if (op->get_type()->type == type_id::SIMD ||
+      (is_numeric(op->get_type()->type) &&
+      (op->get_op() == op_id::PLUS || op->get_op() == op_id::MINUS ||
+      op->get_op() == op_id::TIMES || op->get_op() == op_id::DIVIDE ||
+      op->get_op() == op_id::MIN || op->get_op() == op_id::MAX)))
+    {
+      return _visit_scalar_arith(op);
+    }
+    operand = op->get_children()[0]->as_expression();
+  }
+  std::vector<llvm::Value *> args = {operand->accept(this)};
+  runtime_op impl;
   switch (op->get_op()) {
     case op_id::PLUS:
-      op_impl = module_->getFunction("slc_int_list_add");
+      impl = runtime_op::ADD;
       break;
     case op_id::MINUS:
-      op_impl = module_->getFunction("slc_int_list_subtract");
+      impl = runtime_op::SUBTRACT;
       break;
     case op_id::TIMES:
-      op_impl = module_->getFunction("slc_int_list_multiply");
+      impl = runtime_op::MULTIPLY;
       break;
     case op_id::DIVIDE:
-      op_impl = module_->getFunction("slc_int_list_divide");
+      impl = runtime_op::DIVIDE;
+      break;
+    case op_id::MIN:
+      impl = runtime_op::MIN;
+      break;
+    case op_id::MAX:
+      impl = runtime_op::MAX;
+      break;
+    case op_id::AND:
+      impl = runtime_op::AND;
+      break;
+    case op_id::OR:
+      impl = runtime_op::OR;
+      break;
+    case op_id::XOR:
+      impl = runtime_op::XOR;
       break;
     default:
-      return LogErrorV("not a list op");
+      return LogErrorV("unimplemented list type in visit_list_op");
   }
-  return builder_->CreateCall(op_impl, args);
+  const type_id elem_type = operand->get_type()->subtype->type;
+  llvm::Value * ret = _call_runtime(operand->get_type()->type, elem_type, impl, args);
+  if (nullptr == ret || op->get_type()->type != type_id::BOOL) {
+    return ret;
+  }
+  /* the logical reductions return a byte */
+  return _from_storage(ret, type_id::BOOL);
 }
 
-llvm::Value * codegen::_visit_list_op_float(list_op * const op) const
+llvm::Value * codegen::_visit_string_concat(list_op * const op) const
 {
-  std::vector<llvm::Value *> args = {
-    op->get_children()[0]->accept(this),
-  };
-  llvm::Function * op_impl;
+  /* (+ a b c) hands every part to the runtime at once, which copies each one once */
+  std::vector<expression *> parts;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    parts.push_back(iter->get_head());
+  }
+  llvm::ArrayType * array_t = llvm::ArrayType::get(
+    llvm::PointerType::get(*context_, 0), parts.size());
+  llvm::Value * array = _create_entry_alloca(array_t, "string_parts");
+  for (std::size_t x = 0; x < parts.size(); ++x) {
+    builder_->CreateStore(
+      _maybe_convert(parts[x], type_id::STRING),
+      builder_->CreateConstInBoundsGEP2_32(array_t, array, 0, x));
+  }
+  return _call_runtime(
+    type_id::STRING, type_id::STRING, runtime_op::CONCAT,
+    {array, llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), parts.size())}, "concattmp");
+}
+
+llvm::Value * codegen::_visit_scalar_arith(list_op * const op) const
+{
+  /* (+ a b c) folds left with plain instructions, without building a list to reduce */
+  const type_id type = (op->get_type()->type == type_id::SIMD) ?
+    op->get_type()->subtype->type : op->get_type()->type;
+  const bool is_float = is_floating(type);
+  auto less_than = [&](llvm::Value * lhs, llvm::Value * rhs) -> llvm::Value * {
+      if (is_float) {
+        return builder_->CreateFCmpOLT(lhs, rhs, "cmptmp");
+      } else if (is_unsigned(type)) {
+        return builder_->CreateICmpULT(lhs, rhs, "cmptmp");
+      }
+      return builder_->CreateICmpSLT(lhs, rhs, "cmptmp");
+    };
+  llvm::Value * ret = nullptr;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    /* simd vectors are combined lane by lane, with scalars broadcast to every lane */
+    llvm::Value * val = _maybe_convert(iter->get_head(), op);
+    if (nullptr == ret) {
+      ret = val;
+      continue;
+    }
+    switch (op->get_op()) {
+      case op_id::PLUS:
+        ret = is_float ? builder_->CreateFAdd(ret, val, "addtmp") :
+          builder_->CreateAdd(ret, val, "addtmp");
+        break;
+      case op_id::MINUS:
+        ret = is_float ? builder_->CreateFSub(ret, val, "subtmp") :
+          builder_->CreateSub(ret, val, "subtmp");
+        break;
+      case op_id::TIMES:
+        ret = is_float ? builder_->CreateFMul(ret, val, "multmp") :
+          builder_->CreateMul(ret, val, "multmp");
+        break;
+      case op_id::DIVIDE:
+        if (is_float) {
+          ret = builder_->CreateFDiv(ret, val, "divtmp");
+        } else if (is_unsigned(type)) {
+          ret = builder_->CreateUDiv(ret, val, "divtmp");
+        } else {
+          ret = builder_->CreateSDiv(ret, val, "divtmp");
+        }
+        break;
+      case op_id::MIN:
+        ret = builder_->CreateSelect(less_than(val, ret), val, ret, "mintmp");
+        break;
+      case op_id::MAX:
+        ret = builder_->CreateSelect(less_than(ret, val), val, ret, "maxtmp");
+        break;
+      case op_id::AND:
+        ret = builder_->CreateAnd(ret, val, "andtmp");
+        break;
+      case op_id::OR:
+        ret = builder_->CreateOr(ret, val, "ortmp");
+        break;
+      case op_id::XOR:
+        ret = builder_->CreateXor(ret, val, "xortmp");
+        break;
+      default:
+        return LogErrorV("unimplemented scalar list op");
+    }
+  }
+  return ret;
+}
+
+llvm::Value * codegen::_visit_simd_reduce(list_op * const op, expression * const operand) const
+{
+  llvm::Value * v = operand->accept(this);
+  const type_id lane = operand->get_type()->subtype->type;
+  llvm::Type * lane_t = _type_id_to_llvm(lane);
+  llvm::CallInst * ret = nullptr;
   switch (op->get_op()) {
     case op_id::PLUS:
-      op_impl = module_->getFunction("slc_double_list_add");
-      break;
-    case op_id::MINUS:
-      op_impl = module_->getFunction("slc_double_list_subtract");
+      ret = is_floating(lane) ?
+        builder_->CreateFAddReduce(llvm::ConstantFP::get(lane_t, 0.0), v) :
+        builder_->CreateAddReduce(v);
       break;
     case op_id::TIMES:
-      op_impl = module_->getFunction("slc_double_list_multiply");
+      ret = is_floating(lane) ?
+        builder_->CreateFMulReduce(llvm::ConstantFP::get(lane_t, 1.0), v) :
+        builder_->CreateMulReduce(v);
       break;
-    case op_id::DIVIDE:
-      op_impl = module_->getFunction("slc_double_list_divide");
+    case op_id::MIN:
+      ret = is_floating(lane) ? builder_->CreateFPMinReduce(v) :
+        builder_->CreateIntMinReduce(v, !is_unsigned(lane));
+      break;
+    case op_id::MAX:
+      ret = is_floating(lane) ? builder_->CreateFPMaxReduce(v) :
+        builder_->CreateIntMaxReduce(v, !is_unsigned(lane));
+      break;
+    case op_id::AND:
+      ret = builder_->CreateAndReduce(v);
+      break;
+    case op_id::OR:
+      ret = builder_->CreateOrReduce(v);
+      break;
+    case op_id::XOR:
+      ret = builder_->CreateXorReduce(v);
       break;
     default:
-      return LogErrorV("not a list op");
+      return LogErrorV("no reduction across lanes for this operator");
+  }
+  if (is_floating(lane)) {
+    /* like the runtime's kernels, float sums and products are reassociated into a tree */
+    ret->setHasAllowReassoc(true);
   }
-  return builder_->CreateCall(op_impl, args);
+  return ret;
 }
 
-llvm::Value * codegen::visit_list_op(list_op * const op) const
+llvm::Value * codegen::_visit_lanes(list_op * const op) const
 {
-  if (op->get_type()->type == type_id::INT) {
-    return _visit_list_op_int(op);
-  } else if (op->get_type()->type == type_id::FLOAT) {
-    return _visit_list_op_float(op);
+  list * iter = op->get_children()[0]->as_list();
+  if (nullptr == iter->get_tail()) {
+    /* a scalar for every lane, or a vector converted lane by lane */
+    return _convert_to_simd(iter->get_head(), op->get_type());
+  }
+  llvm::Value * ret = llvm::UndefValue::get(_type_to_llvm(op->get_type()));
+  for (uint64_t lane = 0; nullptr != iter; iter = iter->get_tail(), ++lane) {
+    ret = builder_->CreateInsertElement(
+      ret, _maybe_convert(iter->get_head(), op->get_type()->subtype->type), lane, "lanetmp");
+  }
+  return ret;
+}
+
+llvm::Value * codegen::_visit_shuffle(list_op * const op) const
+{
+  list * iter = op->get_children()[0]->as_list();
+  llvm::Value * lhs = iter->get_head()->accept(this);
+  llvm::Value * rhs = llvm::UndefValue::get(lhs->getType());
+  iter = iter->get_tail();
+  if (iter->get_head()->get_type()->type == type_id::SIMD) {
+    rhs = iter->get_head()->accept(this);
+    iter = iter->get_tail();
+  }
+  /* the lane numbers were checked to be constants */
+  std::vector<int> mask;
+  for (; nullptr != iter; iter = iter->get_tail()) {
+    mask.push_back(dynamic_cast<literal *>(iter->get_head())->get_int());
   }
-  return LogErrorV("unimplemented list type in visit_list_op");
+  return builder_->CreateShuffleVector(lhs, rhs, mask, "shuffletmp");
+}
+
+llvm::Value * codegen::_visit_mask_op(list_op * const op) const
+{
+  runtime_op impl;
+  switch (op->get_op()) {
+    case op_id::AND:
+      impl = runtime_op::MASK_AND;
+      break;
+    case op_id::OR:
+      impl = runtime_op::MASK_OR;
+      break;
+    case op_id::XOR:
+      impl = runtime_op::MASK_XOR;
+      break;
+    default:
+      return LogErrorV("not a mask operation");
+  }
+  /* combine the masks pairwise, left to right */
+  list * iter = op->get_children()[0]->as_list();
+  llvm::Value * ret = iter->get_head()->accept(this);
+  for (iter = iter->get_tail(); nullptr != iter && nullptr != ret; iter = iter->get_tail()) {
+    ret = _call_runtime(
+      op->get_type()->type, type_id::BOOL, impl, {ret, iter->get_head()->accept(this)}, "masktmp");
+  }
+  return ret;
+}
+
+llvm::Value * codegen::_visit_slice(list_op * const op) const
+{
+  std::vector<expression *> args;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    args.push_back(iter->get_head());
+  }
+  std::vector<llvm::Value *> call_args = {
+    args[0]->accept(this),
+    _maybe_convert(args[1], type_id::INT),
+    _maybe_convert(args[2], type_id::INT),
+  };
+  if (args[0]->get_type()->type == type_id::PVEC) {
+    return _call_pvec(runtime_op::SLICE, call_args, "slicetmp");
+  }
+  return _call_runtime(
+    type_id::VEC, args[0]->get_type()->subtype->type, runtime_op::SLICE, call_args, "slicetmp");
+}
+
+llvm::Value * codegen::_visit_fold(list_op * const op) const
+{
+  std::vector<expression *> args;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    args.push_back(iter->get_head());
+  }
+  /* (fold f init l), the accumulator lives in a stack slot across iterations */
+  lambda * const fn = resolve_lambda(args[0]);
+  const type_id acc_type = fn->get_type()->type;
+  llvm::AllocaInst * acc_alloca = _create_entry_alloca(_type_to_llvm(fn->get_type()), "acc");
+  builder_->CreateStore(_maybe_convert(args[1], acc_type), acc_alloca);
+  _emit_list_loop(
+    args[2]->accept(this), args[2]->get_type()->subtype->type,
+    [&](llvm::Value * x) {
+      llvm::Value * acc = builder_->CreateLoad(acc_alloca->getAllocatedType(), acc_alloca, "acc");
+      builder_->CreateStore(_inline_lambda(fn, {acc, x}), acc_alloca);
+    });
+  return builder_->CreateLoad(acc_alloca->getAllocatedType(), acc_alloca, "foldtmp");
+}
+
+llvm::Value * codegen::_visit_map(binary_op * const op) const
+{
+  lambda * const fn = resolve_lambda(op->get_children()[0]->as_expression());
+  expression * const l = op->get_children()[1]->as_expression();
+  const type_id elem_type = l->get_type()->subtype->type;
+  const type_id ret_type = fn->get_type()->type;
+  llvm::Value * init = l->accept(this);
+  /* one element out per element in, so allocate the result up front */
+  llvm::Value * retlist = _do_reserve(_do_length(init, elem_type), ret_type);
+  llvm::AllocaInst * out_alloca =
+    _create_entry_alloca(llvm::PointerType::get(*context_, 0), "out");
+  builder_->CreateStore(retlist, out_alloca);
+  if (ret_type == type_id::BOOL) {
+    /* list<bool> is packed, so its elements are written one at a time */
+    _emit_list_loop(
+      init, elem_type,
+      [&](llvm::Value * x) {
+        llvm::Value * val = _inline_lambda(fn, {x});
+        llvm::Value * out = builder_->CreateLoad(out_alloca->getAllocatedType(), out_alloca, "out");
+        _do_set_head(out, val, ret_type);
+        builder_->CreateStore(_do_cdr(out, ret_type), out_alloca);
+      });
+    return retlist;
+  }
+  /* a reserved list is plain chunks, each run of one is written in place */
+  llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+  llvm::PointerType * ptr_t = llvm::PointerType::get(*context_, 0);
+  llvm::Type * ret_t = _elem_storage_type(ret_type);
+  llvm::AllocaInst * data_alloca = _create_entry_alloca(ptr_t, "outrun");
+  llvm::AllocaInst * n_alloca = _create_entry_alloca(i64, "outlen");
+  llvm::AllocaInst * at_alloca = _create_entry_alloca(i64, "outidx");
+  builder_->CreateStore(llvm::ConstantInt::get(i64, 0), n_alloca);
+  builder_->CreateStore(llvm::ConstantInt::get(i64, 0), at_alloca);
+  _emit_list_loop(
+    init, elem_type,
+    [&](llvm::Value * x) {
+      llvm::Value * val = _inline_lambda(fn, {x});
+      llvm::Function * func = builder_->GetInsertBlock()->getParent();
+      llvm::BasicBlock * refill_bb = llvm::BasicBlock::Create(*context_, "outrun", func);
+      llvm::BasicBlock * store_bb = llvm::BasicBlock::Create(*context_, "outstore", func);
+      llvm::Value * at = builder_->CreateLoad(i64, at_alloca, "outidx");
+      llvm::Value * full = builder_->CreateICmpEQ(
+        at, builder_->CreateLoad(i64, n_alloca, "outlen"), "outfull");
+      builder_->CreateCondBr(full, refill_bb, store_bb);
+      /* the current run is written, move on to the next one */
+      builder_->SetInsertPoint(refill_bb);
+      llvm::Value * out = builder_->CreateLoad(ptr_t, out_alloca, "out");
+      builder_->CreateStore(
+        _call_runtime(
+          type_id::LIST, ret_type, runtime_op::RUN,
+          {out, n_alloca, out_alloca, llvm::ConstantPointerNull::get(ptr_t)}, "outrun"),
+        data_alloca);
+      builder_->CreateStore(llvm::ConstantInt::get(i64, 0), at_alloca);
+      builder_->CreateBr(store_bb);
+      builder_->SetInsertPoint(store_bb);
+      at = builder_->CreateLoad(i64, at_alloca, "outidx");
+      llvm::Value * data = builder_->CreateLoad(ptr_t, data_alloca, "outrun");
+      builder_->CreateStore(
+        _to_storage(val, ret_type), builder_->CreateInBoundsGEP(ret_t, data, {at}));
+      builder_->CreateStore(
+        builder_->CreateNSWAdd(at, llvm::ConstantInt::get(i64, 1), "nextoutidx"), at_alloca);
+    });
+  return retlist;
+}
+
+llvm::Value * codegen::_visit_mat_map(binary_op * const op) const
+{
+  lambda * const fn = resolve_lambda(op->get_children()[0]->as_expression());
+  expression * const m = op->get_children()[1]->as_expression();
+  const type_id elem_type = m->get_type()->subtype->type;
+  const type_id ret_type = fn->get_type()->type;
+  llvm::Value * mat = m->accept(this);
+  llvm::Value * rows = _do_mat_rows(mat);
+  llvm::Value * cols = _do_mat_cols(mat);
+  llvm::Value * ret = _call_runtime(
+    type_id::MAT, ret_type, runtime_op::CREATE, {rows, cols}, "maptmp");
+  llvm::Value * data = _do_mat_data(mat);
+  llvm::Value * out = _do_mat_data(ret);
+  /* the elements are one array in both, so this is a single flat loop over them */
+  _emit_index_loop(
+    builder_->CreateNSWMul(rows, cols, "count"),
+    [&](llvm::Value * idx) {
+      _do_vec_store(out, idx, _inline_lambda(fn, {_do_vec_load(data, idx, elem_type)}), ret_type);
+    });
+  return ret;
+}
+
+llvm::Value * codegen::_visit_filter(binary_op * const op) const
+{
+  lambda * const fn = resolve_lambda(op->get_children()[0]->as_expression());
+  expression * const l = op->get_children()[1]->as_expression();
+  const type_id elem_type = l->get_type()->subtype->type;
+  llvm::Value * null = llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
+  /* matches are appended, which is amortized O(1) */
+  llvm::AllocaInst * out_alloca =
+    _create_entry_alloca(llvm::PointerType::get(*context_, 0), "out");
+  builder_->CreateStore(null, out_alloca);
+  _emit_list_loop(
+    l->accept(this), elem_type,
+    [&](llvm::Value * x) {
+      llvm::Function * func = builder_->GetInsertBlock()->getParent();
+      llvm::BasicBlock * keep_bb = llvm::BasicBlock::Create(*context_, "keep", func);
+      llvm::BasicBlock * next_bb = llvm::BasicBlock::Create(*context_, "next", func);
+      builder_->CreateCondBr(_inline_lambda(fn, {x}), keep_bb, next_bb);
+      builder_->SetInsertPoint(keep_bb);
+      llvm::Value * out = builder_->CreateLoad(out_alloca->getAllocatedType(), out_alloca, "out");
+      builder_->CreateStore(_do_append(out, x, elem_type), out_alloca);
+      builder_->CreateBr(next_bb);
+      builder_->SetInsertPoint(next_bb);
+    });
+  return builder_->CreateLoad(out_alloca->getAllocatedType(), out_alloca, "filtertmp");
+}
+
+void codegen::_emit_list_loop(
+  llvm::Value * const l, const type_id elem_type,
+  const std::function<void(llvm::Value *)> & body) const
+{
+  /* a chunk at a time from the runtime, whose elements are then read in place */
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * chunk_bb = llvm::BasicBlock::Create(*context_, "chunk", func);
+  llvm::BasicBlock * run_bb = llvm::BasicBlock::Create(*context_, "run", func);
+  llvm::BasicBlock * check_bb = llvm::BasicBlock::Create(*context_, "check", func);
+  llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
+  llvm::BasicBlock * next_bb = llvm::BasicBlock::Create(*context_, "nextchunk", func);
+  llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
+  llvm::PointerType * ptr_t = llvm::PointerType::get(*context_, 0);
+  llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+  llvm::Type * elem_t = _elem_storage_type(elem_type);
+  llvm::Value * null = llvm::ConstantPointerNull::get(ptr_t);
+  /* compact chunks and list<bool> are decoded into a buffer of SLC_LIST_RUN_MAX elements */
+  llvm::AllocaInst * buf = _create_entry_alloca(llvm::ArrayType::get(elem_t, 256), "runbuf");
+  llvm::AllocaInst * list_iter_alloca = _create_entry_alloca(ptr_t, "iter");
+  llvm::AllocaInst * next_alloca = _create_entry_alloca(ptr_t, "next");
+  llvm::AllocaInst * n_alloca = _create_entry_alloca(i64, "runlen");
+  llvm::AllocaInst * idx_alloca = _create_entry_alloca(i64, "idx");
+  builder_->CreateStore(l, list_iter_alloca);
+  builder_->CreateBr(chunk_bb);
+  builder_->SetInsertPoint(chunk_bb);
+  llvm::Value * iter = builder_->CreateLoad(ptr_t, list_iter_alloca, "iter");
+  llvm::Value * cond = builder_->CreateCmp(
+    llvm::CmpInst::Predicate::ICMP_EQ, iter, null, "nullcheck");
+  builder_->CreateCondBr(cond, loop_end_bb, run_bb);
+  builder_->SetInsertPoint(run_bb);
+  llvm::Value * data = _call_runtime(
+    type_id::LIST, elem_type, runtime_op::RUN, {iter, n_alloca, next_alloca, buf}, "run");
+  llvm::Value * n = builder_->CreateLoad(i64, n_alloca, "runlen");
+  builder_->CreateStore(llvm::ConstantInt::get(i64, 0), idx_alloca);
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(check_bb);
+  llvm::Value * idx = builder_->CreateLoad(i64, idx_alloca, "idx");
+  builder_->CreateCondBr(builder_->CreateICmpSLT(idx, n, "boundcheck"), loop_bb, next_bb);
+  builder_->SetInsertPoint(loop_bb);
+  /* the body may branch, so the update goes wherever it leaves off */
+  body(_from_storage(
+    builder_->CreateLoad(elem_t, builder_->CreateInBoundsGEP(elem_t, data, {idx}), "elem"),
+    elem_type));
+  builder_->CreateStore(
+    builder_->CreateNSWAdd(idx, llvm::ConstantInt::get(i64, 1), "nextidx"), idx_alloca);
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(next_bb);
+  builder_->CreateStore(builder_->CreateLoad(ptr_t, next_alloca, "next"), list_iter_alloca);
+  builder_->CreateBr(chunk_bb);
+  builder_->SetInsertPoint(loop_end_bb);
+}
+
+llvm::Value * codegen::_inline_lambda(
+  lambda * const fn, const std::vector<llvm::Value *> & args) const
+{
+  if (std::find(inlining_.begin(), inlining_.end(), fn) != inlining_.end()) {
+    /* a lambda that reaches itself again is called, it was emitted where it was bound */
+    std::vector<llvm::Value *> call_args = {_lambda_env(fn)};
+    for (std::size_t x = 0; x < args.size(); ++x) {
+      call_args.push_back(_pass_arg(args[x], fn->get_formals()[x]->get_type()));
+    }
+    return builder_->CreateCall(module_->getFunction(fn->get_name()), call_args, "calltmp");
+  }
+  /* bind captures from the closure and the formals to args, saving anything they shadow */
+  bindings_t saved;
+  if (!fn->get_captures().empty() && fn->get_parent()->is_variable_definition()) {
+    /* a lambda written in place needs none, its captures are already in reach */
+    _bind_captures(fn, _lambda_env(fn), saved);
+  }
+  for (std::size_t x = 0; x < args.size(); ++x) {
+    _bind(fn->get_formals()[x]->get_name(), args[x], saved);
+  }
+  inlining_.push_back(fn);
+  llvm::Value * ret = fn->get_body()->accept(this);
+  inlining_.pop_back();
+  _unbind(saved);
+  return ret;
+}
+
+llvm::Value * codegen::_visit_list_function(binary_op * const op) const
+{
+  expression * lhs = op->get_children()[0]->as_expression();
+  expression * rhs = op->get_children()[1]->as_expression();
+  switch (op->get_op()) {
+    case op_id::RANGE:
+      {
+        std::vector<llvm::Value *> args = {
+          _maybe_convert(lhs, type_id::INT), _maybe_convert(rhs, type_id::INT)};
+        return _call_runtime(type_id::LIST, type_id::INT, runtime_op::RANGE, args, "rangetmp");
+      }
+    case op_id::MAP:
+      return (rhs->get_type()->type == type_id::MAT) ? _visit_mat_map(op) : _visit_map(op);
+    case op_id::FILTER:
+      return _visit_filter(op);
+    default:
+      break;
+  }
+  const type_id list_type = lhs->get_type()->subtype->type;
+  llvm::Value * l = lhs->accept(this);
+  switch (op->get_op()) {
+    case op_id::NTH:
+      return _from_storage(
+        _call_runtime(
+          type_id::LIST, list_type, runtime_op::NTH, {l, _maybe_convert(rhs, type_id::INT)},
+          "nthtmp"),
+        list_type);
+    case op_id::TAKE:
+      return _call_runtime(
+        type_id::LIST, list_type, runtime_op::TAKE, {l, _maybe_convert(rhs, type_id::INT)},
+        "taketmp");
+    case op_id::DROP:
+      return _call_runtime(
+        type_id::LIST, list_type, runtime_op::DROP, {l, _maybe_convert(rhs, type_id::INT)},
+        "droptmp");
+    case op_id::CONCAT:
+      return _call_runtime(
+        type_id::LIST, list_type, runtime_op::CONCAT, {l, rhs->accept(this)}, "concattmp");
+    default:
+      break;
+  }
+  return LogErrorV("unimplemented list function");
 }
 
 llvm::Value * codegen::visit_node(node * const n) const
@@ -780,71 +1979,941 @@ llvm::Value * codegen::visit_simple_expression(simple_expression * const) const
 
 llvm::Value * codegen::visit_unary_op(unary_op * const op) const
 {
-  if (op->get_children()[0]->get_type()->type == type_id::LIST) {
-    if (op->get_children()[0]->get_type()->subtype->type == type_id::INT) {
-      return _visit_unary_op_int_list(op);
-    } else if (op->get_children()[0]->get_type()->subtype->type == type_id::FLOAT) {
-      return _visit_unary_op_float_list(op);
+  type_info * child_t = op->get_children()[0]->get_type();
+  if (op->get_op() == op_id::GET) {
+    return _visit_get(op);
+  } else if (op->get_op() == op_id::TO_VEC || op->get_op() == op_id::TO_LIST ||
+    op->get_op() == op_id::TO_MAT || op->get_op() == op_id::CAST)
+  {
+    return _maybe_convert(op->get_children()[0], op);
+  } else if (op->get_op() == op_id::TO_PVEC) {
+    return _visit_to_pvec(op);
+  } else if (op->get_op() == op_id::INTERN) {
+    return _visit_intern(op);
+  } else if (op->get_op() == op_id::TO_STRING) {
+    return _visit_to_string(op);
+  } else if (op->get_op() == op_id::LENGTH &&
+    (child_t->type == type_id::STRING || child_t->type == type_id::SYMBOL))
+  {
+    return _call_runtime(
+      type_id::STRING, type_id::STRING, runtime_op::LENGTH, {op->get_children()[0]->accept(this)},
+      "strlentmp");
+  } else if (op->get_op() == op_id::NOT && child_t->type == type_id::BOOL) {
+    return builder_->CreateNot(op->get_children()[0]->accept(this), "nottmp");
+  } else if (op->get_op() == op_id::NOT || op->get_op() == op_id::COUNT) {
+    /* whole masks, list<bool> or vec<bool> */
+    return _call_runtime(
+      child_t->type, child_t->subtype->type,
+      (op->get_op() == op_id::NOT) ? runtime_op::NOT : runtime_op::COUNT,
+      {op->get_children()[0]->accept(this)});
+  } else if (op->get_children()[0]->get_type()->type == type_id::MAT) {
+    return _visit_unary_op_mat(op);
+  } else if (child_t->type == type_id::MAP || child_t->type == type_id::SET) {
+    if (op->get_op() == op_id::LENGTH) {
+      return _do_table_field(op->get_children()[0]->accept(this), 0, "tablelen");
     }
-
+    return LogErrorV("unimplemented unary op");
+  } else if (op->get_children()[0]->get_type()->type == type_id::VEC) {
+    if (op->get_op() == op_id::LENGTH) {
+      return _do_vec_length(op->get_children()[0]->accept(this));
+    }
+    return LogErrorV("unimplemented unary op");
+  } else if (child_t->type == type_id::PVEC && op->get_op() == op_id::LENGTH) {
+    return _do_pvec_length(op->get_children()[0]->accept(this));
+  } else if (child_t->type == type_id::QUEUE || child_t->type == type_id::HEAP) {
+    return _visit_queue_op(op);
+  } else if (child_t->type == type_id::BUILDER && op->get_op() == op_id::LENGTH) {
+    return _call_runtime(
+      type_id::BUILDER, type_id::STRING, runtime_op::LENGTH,
+      {op->get_children()[0]->accept(this)}, "lentmp");
+  } else if (op->get_children()[0]->get_type()->type == type_id::LIST) {
+    return _visit_unary_op_list(op);
   }
   return LogErrorV("unimplemented unary op");
 }
 
+llvm::Value * codegen::_visit_intern(unary_op * const op) const
+{
+  node * const child = op->get_children()[0];
+  if (child->get_type()->type == type_id::SYMBOL) {
+    return child->accept(this);
+  } else if (literal * const lit = dynamic_cast<literal *>(child); nullptr != lit) {
+    /* a literal is interned once, before main */
+    return _symbol_literal(lit->get_str());
+  }
+  return _call_runtime(
+    type_id::SYMBOL, type_id::STRING, runtime_op::INTERN, {child->accept(this)}, "interntmp");
+}
+
+llvm::Value * codegen::_visit_to_string(unary_op * const op) const
+{
+  node * const child = op->get_children()[0];
+  const type_id from = child->get_type()->type;
+  if (from == type_id::STRING || from == type_id::SYMBOL) {
+    return child->accept(this);
+  } else if (from == type_id::BUILDER) {
+    return _call_runtime(
+      type_id::BUILDER, type_id::STRING, runtime_op::TO_STRING, {child->accept(this)}, "tostrtmp");
+  } else if (from == type_id::BOOL) {
+    return builder_->CreateSelect(
+      child->accept(this), _string_literal("true"), _string_literal("false"), "booltmp");
+  } else if (is_floating(from)) {
+    return _call_runtime(
+      type_id::STRING, type_id::STRING, runtime_op::FROM_FLOAT,
+      {_maybe_convert(child, type_id::FLOAT)}, "tostrtmp");
+  }
+  return _call_runtime(
+    type_id::STRING, type_id::STRING, runtime_op::FROM_INT, {_maybe_convert(child, type_id::INT)},
+    "tostrtmp");
+}
+
+llvm::Value * codegen::_do_set_head(
+  llvm::Value * const l, llvm::Value * const val,
+  const type_id list_type) const
+{
+  return _call_runtime(
+    type_id::LIST, list_type, runtime_op::SET_HEAD, {l, _to_storage(val, list_type)});
+}
+
 llvm::Value * codegen::_do_car(llvm::Value * l, const type_id list_type) const
 {
-  llvm::Function * op_impl;
-  std::vector<llvm::Value *> args = {l};
+  llvm::Value * head = _call_runtime(type_id::LIST, list_type, runtime_op::HEAD, {l});
+  if (nullptr == head) {
+    return nullptr;
+  }
+  return _from_storage(head, list_type);
+}
+
+llvm::Value * codegen::_do_length(llvm::Value * l, const type_id list_type) const
+{
+  return _call_runtime(type_id::LIST, list_type, runtime_op::LENGTH, {l});
+}
+
+llvm::Value * codegen::_do_reserve(llvm::Value * n, const type_id list_type) const
+{
+  return _call_runtime(type_id::LIST, list_type, runtime_op::RESERVE, {n});
+}
+
+llvm::StructType * codegen::_vec_struct_type() const
+{
+  /* the leading fields of every slc_<T>_vec: len, cap, data */
+  return llvm::StructType::get(
+    *context_, {
+      llvm::Type::getInt64Ty(*context_),
+      llvm::Type::getInt64Ty(*context_),
+      llvm::PointerType::get(*context_, 0),
+    });
+}
+
+llvm::Value * codegen::_do_vec_length(llvm::Value * v) const
+{
+  return builder_->CreateLoad(
+    llvm::Type::getInt64Ty(*context_),
+    builder_->CreateStructGEP(_vec_struct_type(), v, 0), "veclen");
+}
+
+llvm::Value * codegen::_do_vec_data(llvm::Value * v) const
+{
+  return builder_->CreateLoad(
+    llvm::PointerType::get(*context_, 0),
+    builder_->CreateStructGEP(_vec_struct_type(), v, 2), "vecdata");
+}
+
+llvm::Value * codegen::_do_vec_nth(expression * const v, expression * const idx) const
+{
+  llvm::Value * vec = v->accept(this);
+  if (v->get_type()->subtype->type == type_id::RECORD) {
+    return _do_record_vec_load(
+      vec, _maybe_convert(idx, type_id::INT), _record_of(v->get_type()->subtype));
+  }
+  return _do_vec_load(
+    _do_vec_data(vec), _maybe_convert(idx, type_id::INT), v->get_type()->subtype->type);
+}
+
+llvm::Value * codegen::_do_vec_load(
+  llvm::Value * const data, llvm::Value * const idx,
+  const type_id elem_type) const
+{
+  if (elem_type == type_id::BOOL) {
+    /* vec<bool> is packed, element idx is bit idx % 64 of word idx / 64 */
+    llvm::Type * word_t = llvm::Type::getInt64Ty(*context_);
+    llvm::Value * word = builder_->CreateLoad(
+      word_t, builder_->CreateInBoundsGEP(
+        word_t, data, {builder_->CreateLShr(idx, 6)}), "word");
+    llvm::Value * bit = builder_->CreateLShr(word, builder_->CreateAnd(idx, 63));
+    return builder_->CreateTrunc(bit, llvm::Type::getInt1Ty(*context_), "elem");
+  } else if (elem_type == type_id::VEC) {
+    /* the rows of a nested vec are vecs in place, hand out their address */
+    return builder_->CreateInBoundsGEP(_vec_struct_type(), data, {idx}, "row");
+  }
+  llvm::Type * elem_t = _type_id_to_llvm(elem_type);
+  return builder_->CreateLoad(elem_t, builder_->CreateInBoundsGEP(elem_t, data, {idx}), "elem");
+}
+
+void codegen::_do_vec_store(
+  llvm::Value * const data, llvm::Value * const idx, llvm::Value * const val,
+  const type_id elem_type) const
+{
+  if (elem_type == type_id::BOOL) {
+    /* read, modify and write back the word holding the bit */
+    llvm::Type * word_t = llvm::Type::getInt64Ty(*context_);
+    llvm::Value * ptr = builder_->CreateInBoundsGEP(
+      word_t, data, {builder_->CreateLShr(idx, 6)});
+    llvm::Value * shift = builder_->CreateAnd(idx, 63);
+    llvm::Value * word = builder_->CreateLoad(word_t, ptr, "word");
+    llvm::Value * cleared = builder_->CreateAnd(
+      word, builder_->CreateNot(builder_->CreateShl(llvm::ConstantInt::get(word_t, 1), shift)));
+    builder_->CreateStore(
+      builder_->CreateOr(cleared, builder_->CreateShl(builder_->CreateZExt(val, word_t), shift)),
+      ptr);
+    return;
+  } else if (elem_type == type_id::VEC) {
+    /* copy the row, which keeps pointing at the elements of val */
+    builder_->CreateStore(
+      builder_->CreateLoad(_vec_struct_type(), val, "row"),
+      builder_->CreateInBoundsGEP(_vec_struct_type(), data, {idx}));
+    return;
+  }
+  llvm::Type * elem_t = _type_id_to_llvm(elem_type);
+  builder_->CreateStore(val, builder_->CreateInBoundsGEP(elem_t, data, {idx}));
+}
+
+llvm::Value * codegen::_do_vec_create(llvm::Value * n, const type_id elem_type) const
+{
+  return _call_runtime(type_id::VEC, elem_type, runtime_op::CREATE, {n});
+}
+
+void codegen::_emit_index_loop(
+  llvm::Value * const n, const std::function<void(llvm::Value *)> & body) const
+{
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * check_bb = llvm::BasicBlock::Create(*context_, "check", func);
+  llvm::BasicBlock * loop_bb = llvm::BasicBlock::Create(*context_, "loop", func);
+  llvm::BasicBlock * loop_end_bb = llvm::BasicBlock::Create(*context_, "loopend", func);
+  llvm::AllocaInst * idx_alloca = _create_entry_alloca(llvm::Type::getInt64Ty(*context_), "idx");
+  builder_->CreateStore(llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0), idx_alloca);
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(check_bb);
+  llvm::Value * idx = builder_->CreateLoad(idx_alloca->getAllocatedType(), idx_alloca, "idx");
+  llvm::Value * cond = builder_->CreateCmp(
+    llvm::CmpInst::Predicate::ICMP_SLT, idx, n, "boundcheck");
+  builder_->CreateCondBr(cond, loop_bb, loop_end_bb);
+  builder_->SetInsertPoint(loop_bb);
+  body(idx);
+  builder_->CreateStore(
+    builder_->CreateNSWAdd(idx, llvm::ConstantInt::get(idx->getType(), 1), "next"), idx_alloca);
+  builder_->CreateBr(check_bb);
+  builder_->SetInsertPoint(loop_end_bb);
+}
+
+llvm::StructType * codegen::_mat_struct_type() const
+{
+  /* the fields of every slc_<T>_mat: rows, cols, data */
+  return llvm::StructType::get(
+    *context_, {
+      llvm::Type::getInt64Ty(*context_),
+      llvm::Type::getInt64Ty(*context_),
+      llvm::PointerType::get(*context_, 0),
+    });
+}
+
+llvm::Value * codegen::_do_mat_rows(llvm::Value * m) const
+{
+  return builder_->CreateLoad(
+    llvm::Type::getInt64Ty(*context_),
+    builder_->CreateStructGEP(_mat_struct_type(), m, 0), "matrows");
+}
+
+llvm::Value * codegen::_do_mat_cols(llvm::Value * m) const
+{
+  return builder_->CreateLoad(
+    llvm::Type::getInt64Ty(*context_),
+    builder_->CreateStructGEP(_mat_struct_type(), m, 1), "matcols");
+}
 
-  switch (list_type) {
+llvm::Value * codegen::_do_mat_data(llvm::Value * m) const
+{
+  return builder_->CreateLoad(
+    llvm::PointerType::get(*context_, 0),
+    builder_->CreateStructGEP(_mat_struct_type(), m, 2), "matdata");
+}
+
+llvm::Value * codegen::_do_mat_row(
+  llvm::Value * const data, llvm::Value * const cols, llvm::Value * const idx,
+  llvm::Value * const view, const type_id elem_type) const
+{
+  /* point view at row idx, which starts idx * cols elements in */
+  llvm::Value * start = builder_->CreateInBoundsGEP(
+    _type_id_to_llvm(elem_type), data, {builder_->CreateNSWMul(idx, cols)}, "rowdata");
+  builder_->CreateStore(cols, builder_->CreateStructGEP(_vec_struct_type(), view, 0));
+  builder_->CreateStore(
+    llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0),
+    builder_->CreateStructGEP(_vec_struct_type(), view, 1));
+  builder_->CreateStore(start, builder_->CreateStructGEP(_vec_struct_type(), view, 2));
+  return view;
+}
+
+llvm::StructType * codegen::_table_struct_type() const
+{
+  /* the fields of every slc_<K>_table: len, cap, ctrl, keys, vals, growth */
+  llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+  llvm::Type * ptr = llvm::PointerType::get(*context_, 0);
+  return llvm::StructType::get(*context_, {i64, i64, ptr, ptr, ptr, i64});
+}
+
+llvm::Value * codegen::_do_table_field(
+  llvm::Value * const t, const int field, const char * name) const
+{
+  return builder_->CreateLoad(
+    _table_struct_type()->getElementType(field),
+    builder_->CreateStructGEP(_table_struct_type(), t, field), name);
+}
+
+void codegen::_do_table_skip_free(
+  llvm::Value * const ctrl, llvm::Value * const idx, llvm::BasicBlock * const next) const
+{
+  /* a full slot's control byte is 7 bits of its hash, free ones have the top bit set */
+  llvm::Type * byte_t = llvm::Type::getInt8Ty(*context_);
+  llvm::Value * byte = builder_->CreateLoad(
+    byte_t, builder_->CreateInBoundsGEP(byte_t, ctrl, {idx}), "ctrl");
+  llvm::BasicBlock * full_bb = llvm::BasicBlock::Create(
+    *context_, "full", builder_->GetInsertBlock()->getParent());
+  builder_->CreateCondBr(
+    builder_->CreateICmpSGE(byte, llvm::ConstantInt::get(byte_t, 0), "isfull"), full_bb, next);
+  builder_->SetInsertPoint(full_bb);
+}
+
+llvm::Value * codegen::_table_key(expression * const key, const type_info * const table_t) const
+{
+  /* numbers are converted to the key type, strings and symbols are passed as they are */
+  if (!is_numeric(table_t->subtype->type)) {
+    return key->accept(this);
+  }
+  return _maybe_convert(key, table_t->subtype->type);
+}
+
+llvm::Value * codegen::_to_table_value(
+  expression * const val, const type_info * const table_t) const
+{
+  const type_id val_t = table_t->elems[0].type;
+  return _to_bits(is_numeric(val_t) ? _maybe_convert(val, val_t) : val->accept(this), val_t);
+}
+
+llvm::Value * codegen::_from_table_value(
+  llvm::Value * const bits, const type_info * const table_t) const
+{
+  return _from_bits(bits, table_t->elems[0].type);
+}
+
+/* the 64-bit form of a map value or a pvec or queue element, see asw/runtime/slc_table.h */
+llvm::Value * codegen::_to_bits(llvm::Value * const val, const type_id elem) const
+{
+  llvm::Type * bits_t = llvm::Type::getInt64Ty(*context_);
+  switch (elem) {
     case type_id::INT:
-      op_impl = module_->getFunction("slc_int_list_car");
-      return builder_->CreateLoad(
-        llvm::Type::getInt64Ty(*context_),
-        builder_->CreateCall(op_impl, args));
+      return val;
     case type_id::FLOAT:
-      op_impl = module_->getFunction("slc_double_list_car");
-      return builder_->CreateCall(op_impl, args);
+      return builder_->CreateBitCast(val, bits_t, "valbits");
+    case type_id::BOOL:
+      return builder_->CreateZExt(val, bits_t, "valbits");
     default:
-      return LogErrorV("unimplemented car type");
+      /* everything else is a pointer */
+      return builder_->CreatePtrToInt(val, bits_t, "valbits");
   }
-  return LogErrorV("unexpected return in _do_car");
 }
 
-llvm::Value * codegen::_do_create_list(const type_id list_type) const
+llvm::Value * codegen::_from_bits(llvm::Value * const bits, const type_id elem) const
 {
-  llvm::Function * op_impl;
-  std::vector<llvm::Value *> args = {};
-
-  switch (list_type) {
+  switch (elem) {
     case type_id::INT:
-      op_impl = module_->getFunction("slc_int_list_create");
-      return builder_->CreateCall(op_impl, args);
+      return bits;
     case type_id::FLOAT:
-      op_impl = module_->getFunction("slc_double_list_create");
-      return builder_->CreateCall(op_impl, args);
+      return builder_->CreateBitCast(bits, llvm::Type::getDoubleTy(*context_), "val");
+    case type_id::BOOL:
+      return builder_->CreateICmpNE(bits, llvm::ConstantInt::get(bits->getType(), 0), "val");
+    default:
+      return builder_->CreateIntToPtr(bits, llvm::PointerType::get(*context_, 0), "val");
+  }
+}
+
+llvm::Value * codegen::_visit_table(list_op * const op) const
+{
+  const type_info * table_t = op->get_type();
+  const type_id key_t = table_t->subtype->type;
+  std::vector<expression *> args;
+  for (list * iter = op->get_children().empty() ? nullptr : op->get_children()[0]->as_list();
+    nullptr != iter; iter = iter->get_tail())
+  {
+    args.push_back(iter->get_head()->as_expression());
+  }
+  if (table_t->type == type_id::SET && args.size() == 1 &&
+    args[0]->get_type()->type == type_id::LIST)
+  {
+    return _call_runtime(
+      type_id::SET, key_t, runtime_op::FROM_LIST, {args[0]->accept(this)}, "settmp");
+  } else if (table_t->type == type_id::SET && args.size() == 1 &&
+    args[0]->get_type()->type == type_id::VEC)
+  {
+    llvm::Value * vec = args[0]->accept(this);
+    return _call_runtime(
+      type_id::SET, key_t, runtime_op::FROM_ARRAY, {_do_vec_data(vec), _do_vec_length(vec)},
+      "settmp");
+  }
+  /* otherwise the entries are put in one at a time, a key and then a map's value */
+  llvm::Value * table = _call_runtime(table_t->type, key_t, runtime_op::CREATE, {}, "tabletmp");
+  const std::size_t step = (table_t->type == type_id::MAP) ? 2 : 1;
+  for (std::size_t x = 0; x + step <= args.size(); x += step) {
+    std::vector<llvm::Value *> put = {table, _table_key(args[x], table_t)};
+    if (table_t->type == type_id::MAP) {
+      put.push_back(_to_table_value(args[x + 1], table_t));
+    }
+    _call_runtime(table_t->type, key_t, runtime_op::PUT, put);
+  }
+  return table;
+}
+
+llvm::Value * codegen::_visit_put(list_op * const op) const
+{
+  std::vector<expression *> args;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    args.push_back(iter->get_head()->as_expression());
+  }
+  const type_info * table_t = args[0]->get_type();
+  std::vector<llvm::Value *> put = {args[0]->accept(this), _table_key(args[1], table_t)};
+  if (table_t->type == type_id::MAP) {
+    put.push_back(_to_table_value(args[2], table_t));
+  }
+  return _call_runtime(table_t->type, table_t->subtype->type, runtime_op::PUT, put, "puttmp");
+}
+
+llvm::Value * codegen::_visit_table_op(binary_op * const op) const
+{
+  expression * lhs = op->get_children()[0]->as_expression();
+  expression * rhs = op->get_children()[1]->as_expression();
+  const type_info * table_t = lhs->get_type();
+  std::vector<llvm::Value *> args = {lhs->accept(this), _table_key(rhs, table_t)};
+  switch (op->get_op()) {
+    case op_id::LOOKUP:
+      return _from_table_value(
+        _call_runtime(table_t->type, table_t->subtype->type, runtime_op::GET, args, "lookuptmp"),
+        table_t);
+    case op_id::HAS:
+      return _from_storage(
+        _call_runtime(table_t->type, table_t->subtype->type, runtime_op::HAS, args, "hastmp"),
+        type_id::BOOL);
+    case op_id::REMOVE:
+      return _from_storage(
+        _call_runtime(
+          table_t->type, table_t->subtype->type, runtime_op::REMOVE, args, "removetmp"),
+        type_id::BOOL);
     default:
       break;
   }
-  return LogErrorV("unexpected return in _do_create_list");
+  return LogErrorV("unimplemented table op");
 }
 
-llvm::Value * codegen::_do_init_list(llvm::Value * l, const type_id list_type) const
+llvm::Value * codegen::_call_pvec(
+  const runtime_op op, std::vector<llvm::Value *> args, const std::string & name) const
 {
-  llvm::Function * op_impl;
-  std::vector<llvm::Value *> args = {l};
+  /* every pvec shares one runtime, declared by int */
+  return _call_runtime(type_id::PVEC, type_id::INT, op, std::move(args), name);
+}
 
-  switch (list_type) {
-    case type_id::INT:
-      op_impl = module_->getFunction("slc_int_list_init");
-      return builder_->CreateCall(op_impl, args);
-    case type_id::FLOAT:
-      op_impl = module_->getFunction("slc_double_list_init");
-      return builder_->CreateCall(op_impl, args);
+llvm::Value * codegen::_do_pvec_length(llvm::Value * const p) const
+{
+  /* the length is the first field of a struct slc_pvec */
+  return builder_->CreateLoad(llvm::Type::getInt64Ty(*context_), p, "pveclen");
+}
+
+llvm::StructType * codegen::_pvec_cursor_type() const
+{
+  /* the leaf being walked: its slots, the index of its first one, and the index past its last */
+  return llvm::StructType::get(
+    *context_, {
+      llvm::PointerType::get(*context_, 0),
+      llvm::Type::getInt64Ty(*context_),
+      llvm::Type::getInt64Ty(*context_),
+    });
+}
+
+llvm::AllocaInst * codegen::_pvec_cursor() const
+{
+  llvm::AllocaInst * cursor = _create_entry_alloca(_pvec_cursor_type(), "pveccursor");
+  /* no leaf yet, so the first index fetches one */
+  builder_->CreateStore(
+    llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0),
+    builder_->CreateStructGEP(_pvec_cursor_type(), cursor, 2));
+  return cursor;
+}
+
+llvm::Value * codegen::_do_pvec_slot(
+  llvm::Value * const p, llvm::Value * const idx, llvm::AllocaInst * const cursor) const
+{
+  /* indices only go up, so a new leaf is needed once idx passes the end of the current one */
+  llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+  llvm::Value * slots_ptr = builder_->CreateStructGEP(_pvec_cursor_type(), cursor, 0);
+  llvm::Value * start_ptr = builder_->CreateStructGEP(_pvec_cursor_type(), cursor, 1);
+  llvm::Value * end_ptr = builder_->CreateStructGEP(_pvec_cursor_type(), cursor, 2);
+  llvm::Function * func = builder_->GetInsertBlock()->getParent();
+  llvm::BasicBlock * fetch_bb = llvm::BasicBlock::Create(*context_, "leaf", func);
+  llvm::BasicBlock * slot_bb = llvm::BasicBlock::Create(*context_, "slot", func);
+  llvm::Value * end = builder_->CreateLoad(i64, end_ptr, "leafend");
+  builder_->CreateCondBr(builder_->CreateICmpSLT(idx, end, "inleaf"), slot_bb, fetch_bb);
+  builder_->SetInsertPoint(fetch_bb);
+  builder_->CreateStore(_call_pvec(runtime_op::LEAF, {p, idx, end_ptr}, "leaftmp"), slots_ptr);
+  builder_->CreateStore(idx, start_ptr);
+  builder_->CreateBr(slot_bb);
+  builder_->SetInsertPoint(slot_bb);
+  llvm::Value * slots = builder_->CreateLoad(
+    llvm::PointerType::get(*context_, 0), slots_ptr, "leaf");
+  llvm::Value * start = builder_->CreateLoad(i64, start_ptr, "leafstart");
+  return builder_->CreateInBoundsGEP(
+    i64, slots, {builder_->CreateNSWSub(idx, start, "leafidx")}, "slot");
+}
+
+llvm::Value * codegen::_visit_to_pvec(unary_op * const op) const
+{
+  /* a pvec of the right length is built full of leaves, then written through them in order */
+  expression * src = op->get_children()[0]->as_expression();
+  const type_id elem = src->get_type()->subtype->type;
+  llvm::Type * i64 = llvm::Type::getInt64Ty(*context_);
+  llvm::Value * from = src->accept(this);
+  const bool list = src->get_type()->type == type_id::LIST;
+  llvm::Value * n = list ? _do_length(from, elem) : _do_vec_length(from);
+  llvm::Value * p = _call_pvec(runtime_op::RESERVE, {n}, "pvectmp");
+  llvm::AllocaInst * cursor = _pvec_cursor();
+  if (list) {
+    llvm::AllocaInst * idx_alloca = _create_entry_alloca(i64, "at");
+    builder_->CreateStore(llvm::ConstantInt::get(i64, 0), idx_alloca);
+    _emit_list_loop(
+      from, elem, [&](llvm::Value * val) {
+        llvm::Value * idx = builder_->CreateLoad(i64, idx_alloca, "at");
+        builder_->CreateStore(_to_bits(val, elem), _do_pvec_slot(p, idx, cursor));
+        builder_->CreateStore(
+          builder_->CreateNSWAdd(idx, llvm::ConstantInt::get(i64, 1), "nextat"), idx_alloca);
+      });
+  } else {
+    llvm::Value * data = _do_vec_data(from);
+    _emit_index_loop(
+      n, [&](llvm::Value * idx) {
+        builder_->CreateStore(
+          _to_bits(_do_vec_load(data, idx, elem), elem), _do_pvec_slot(p, idx, cursor));
+      });
+  }
+  return p;
+}
+
+llvm::Value * codegen::_visit_assoc(list_op * const op) const
+{
+  std::vector<expression *> args;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    args.push_back(iter->get_head()->as_expression());
+  }
+  const type_id elem = args[0]->get_type()->subtype->type;
+  return _call_pvec(
+    runtime_op::ASSOC, {
+      args[0]->accept(this),
+      _maybe_convert(args[1], type_id::INT),
+      _to_bits(_maybe_convert(args[2], elem), elem),
+    }, "assoctmp");
+}
+
+llvm::Value * codegen::_visit_pvec_op(binary_op * const op) const
+{
+  expression * lhs = op->get_children()[0]->as_expression();
+  expression * rhs = op->get_children()[1]->as_expression();
+  const type_id elem = lhs->get_type()->subtype->type;
+  switch (op->get_op()) {
+    case op_id::NTH:
+      return _from_bits(
+        _call_pvec(
+          runtime_op::NTH, {lhs->accept(this), _maybe_convert(rhs, type_id::INT)}, "nthtmp"),
+        elem);
+    case op_id::PUSH:
+      return _call_pvec(
+        runtime_op::PUSH, {lhs->accept(this), _to_bits(_maybe_convert(rhs, elem), elem)},
+        "pushtmp");
+    case op_id::CONCAT:
+      return _call_pvec(runtime_op::CONCAT, {lhs->accept(this), rhs->accept(this)}, "concattmp");
+    default:
+      break;
+  }
+  return LogErrorV("unimplemented pvec op");
+}
+
+llvm::Value * codegen::_to_queue_bits(
+  llvm::Value * const val, const type_info * const queue_t) const
+{
+  const type_id elem = queue_t->subtype->type;
+  llvm::Value * bits = _to_bits(val, elem);
+  if (queue_t->type != type_id::HEAP || elem != type_id::FLOAT) {
+    return bits;
+  }
+  /* the magnitude of a negative float is flipped, then its bits order as an int64_t the same way */
+  llvm::Value * magnitude = llvm::ConstantInt::get(*context_, llvm::APInt::getSignedMaxValue(64));
+  return builder_->CreateXor(
+    bits, builder_->CreateAnd(builder_->CreateAShr(bits, 63), magnitude), "keybits");
+}
+
+llvm::Value * codegen::_from_queue_bits(
+  llvm::Value * const bits, const type_info * const queue_t) const
+{
+  /* flipping the magnitude again undoes it, the sign bit is left alone */
+  const type_id elem = queue_t->subtype->type;
+  return _from_bits(
+    (queue_t->type == type_id::HEAP && elem == type_id::FLOAT) ? _to_queue_bits(bits, queue_t) :
+    bits, elem);
+}
+
+llvm::Value * codegen::_visit_queue(list_op * const op) const
+{
+  const type_info * queue_t = op->get_type();
+  const type_id elem = queue_t->subtype->type;
+  std::vector<llvm::Value *> create;
+  if (queue_t->type == type_id::HEAP) {
+    create.push_back(
+      llvm::ConstantInt::get(
+        llvm::Type::getInt8Ty(*context_), (op->get_op() == op_id::MAX_HEAP) ? 1 : 0));
+  }
+  llvm::Value * queue = _call_runtime(
+    queue_t->type, type_id::INT, runtime_op::CREATE, create, "queuetmp");
+  auto push = [&](llvm::Value * val) {
+      _call_runtime(
+        queue_t->type, type_id::INT, runtime_op::PUSH, {queue, _to_queue_bits(val, queue_t)});
+    };
+  std::vector<expression *> args;
+  for (list * iter = op->get_children().empty() ? nullptr : op->get_children()[0]->as_list();
+    nullptr != iter; iter = iter->get_tail())
+  {
+    args.push_back(iter->get_head()->as_expression());
+  }
+  /* the elements of a list or vec are pushed in order, or each argument is */
+  if (args.size() == 1 && args[0]->get_type()->type == type_id::LIST &&
+    *args[0]->get_type()->subtype == *queue_t->subtype)
+  {
+    _emit_list_loop(args[0]->accept(this), elem, push);
+  } else if (args.size() == 1 && args[0]->get_type()->type == type_id::VEC &&
+    *args[0]->get_type()->subtype == *queue_t->subtype)
+  {
+    llvm::Value * vec = args[0]->accept(this);
+    llvm::Value * data = _do_vec_data(vec);
+    _emit_index_loop(
+      _do_vec_length(vec), [&](llvm::Value * idx) {push(_do_vec_load(data, idx, elem));});
+  } else {
+    for (expression * arg : args) {
+      push(_maybe_convert(arg, elem));
+    }
+  }
+  return queue;
+}
+
+llvm::Value * codegen::_visit_queue_push(binary_op * const op) const
+{
+  expression * lhs = op->get_children()[0]->as_expression();
+  expression * rhs = op->get_children()[1]->as_expression();
+  const type_info * queue_t = lhs->get_type();
+  return _call_runtime(
+    queue_t->type, type_id::INT, runtime_op::PUSH, {
+      lhs->accept(this),
+      _to_queue_bits(_maybe_convert(rhs, queue_t->subtype->type), queue_t),
+    }, "pushtmp");
+}
+
+llvm::Value * codegen::_visit_queue_op(unary_op * const op) const
+{
+  const type_info * queue_t = op->get_children()[0]->get_type();
+  llvm::Value * queue = op->get_children()[0]->accept(this);
+  switch (op->get_op()) {
+    case op_id::LENGTH:
+      /* the length is the first field of a struct slc_queue or slc_heap */
+      return builder_->CreateLoad(llvm::Type::getInt64Ty(*context_), queue, "queuelen");
+    case op_id::POP:
+    case op_id::PEEK:
+      return _from_queue_bits(
+        _call_runtime(
+          queue_t->type, type_id::INT,
+          (op->get_op() == op_id::POP) ? runtime_op::POP : runtime_op::PEEK, {queue}, "poptmp"),
+        queue_t);
     default:
       break;
   }
-  return LogErrorV("unexpected return in _do_init_list");
+  return LogErrorV("unimplemented queue op");
+}
+
+llvm::Value * codegen::_visit_builder(list_op * const op) const
+{
+  llvm::Value * builder = _call_runtime(
+    type_id::BUILDER, type_id::STRING, runtime_op::CREATE, {}, "buildertmp");
+  auto push = [&](llvm::Value * str) {
+      _call_runtime(type_id::BUILDER, type_id::STRING, runtime_op::PUSH, {builder, str});
+    };
+  std::vector<expression *> args;
+  for (list * iter = op->get_children().empty() ? nullptr : op->get_children()[0]->as_list();
+    nullptr != iter; iter = iter->get_tail())
+  {
+    args.push_back(iter->get_head()->as_expression());
+  }
+  /* the strings of a list are pushed in order, or each argument is */
+  if (args.size() == 1 && args[0]->get_type()->type == type_id::LIST) {
+    _emit_list_loop(args[0]->accept(this), type_id::STRING, push);
+  } else {
+    for (expression * arg : args) {
+      push(arg->accept(this));
+    }
+  }
+  return builder;
+}
+
+llvm::Value * codegen::visit_record_definition(record_definition * const rec) const
+{
+  /* a record is a plain struct of its fields, bools are i1 like everywhere else */
+  std::vector<llvm::Type *> fields;
+  fields.reserve(rec->get_fields().size());
+  for (const formal * field : rec->get_fields()) {
+    fields.push_back(_type_id_to_llvm(field->get_type()->type));
+  }
+  records_[rec->get_name()] = rec;
+  record_types_[rec->get_name()] = llvm::StructType::create(*context_, fields, rec->get_name());
+  return llvm::ConstantPointerNull::get(llvm::PointerType::get(*context_, 0));
+}
+
+record_definition * codegen::_record_of(const type_info * const t) const
+{
+  return records_.at(t->name);
+}
+
+llvm::Value * codegen::_visit_record_construction(function_call * const call) const
+{
+  record_definition * const rec = call->get_record();
+  llvm::Value * ret = llvm::UndefValue::get(record_types_.at(rec->get_name()));
+  for (std::size_t x = 0; x < call->get_children().size(); ++x) {
+    ret = builder_->CreateInsertValue(
+      ret, _maybe_convert(call->get_children()[x], rec->get_fields()[x]), {(unsigned)x});
+  }
+  return ret;
+}
+
+llvm::Value * codegen::_visit_get(unary_op * const op) const
+{
+  node * const child = op->get_children()[0];
+  llvm::Value * val = child->accept(this);
+  if (child->get_type()->type == type_id::TUPLE) {
+    return builder_->CreateExtractValue(val, {(unsigned)std::stoul(op->get_name())}, "elem");
+  } else if (child->get_type()->type == type_id::RECORD) {
+    const int field = _record_of(child->get_type())->get_field_index(op->get_name());
+    return builder_->CreateExtractValue(val, {(unsigned)field}, op->get_name());
+  }
+  /* a column of a vec of records */
+  record_definition * const rec = _record_of(child->get_type()->subtype);
+  return _do_record_vec_get(val, rec, rec->get_field_index(op->get_name()));
+}
+
+llvm::Value * codegen::_visit_values(list_op * const op) const
+{
+  /* a first-class struct, returned in registers when it fits in two of them */
+  llvm::Value * ret = llvm::UndefValue::get(_type_to_llvm(op->get_type()));
+  unsigned x = 0;
+  for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+    ret = builder_->CreateInsertValue(ret, iter->get_head()->accept(this), {x++});
+  }
+  return ret;
+}
+
+std::size_t codegen::_value_size(const type_info * const t) const
+{
+  std::vector<const type_info *> elems;
+  if (t->type == type_id::RECORD) {
+    for (const formal * field : _record_of(t)->get_fields()) {
+      elems.push_back(field->get_type());
+    }
+  } else if (t->type == type_id::TUPLE) {
+    for (const type_info & elem : t->elems) {
+      elems.push_back(&elem);
+    }
+  } else if (is_sized(t->type)) {
+    return _type_id_to_llvm(t->type)->getPrimitiveSizeInBits() / 8;
+  } else if (t->type == type_id::SIMD) {
+    return t->lanes * _value_size(t->subtype);
+  } else {
+    return (t->type == type_id::BOOL) ? 1 : (t->type == type_id::LAMBDA) ? 16 : 8;
+  }
+  /* fields are at most 8-byte aligned, and a closure is two pointers */
+  std::size_t bytes = 0;
+  for (const type_info * elem : elems) {
+    const std::size_t size = _value_size(elem);
+    const std::size_t align = std::min<std::size_t>(size, 8);
+    bytes = (bytes + align - 1) / align * align + size;
+  }
+  return bytes;
+}
+
+bool codegen::_by_reference(const type_info * const t) const
+{
+  /* records and tuples that fit in two registers are passed in them, bigger ones by pointer */
+  return (t->type == type_id::RECORD || t->type == type_id::TUPLE) && _value_size(t) > 16;
+}
+
+llvm::Type * codegen::_param_type(const type_info * const t) const
+{
+  if (_by_reference(t)) {
+    return llvm::PointerType::get(*context_, 0);
+  }
+  return _type_to_llvm(t);
+}
+
+llvm::Value * codegen::_pass_arg(llvm::Value * const val, const type_info * const t) const
+{
+  if (!_by_reference(t)) {
+    return val;
+  }
+  /* the callee only reads it, so a copy in the caller's frame will do */
+  llvm::AllocaInst * arg = _create_entry_alloca(val->getType(), "recarg");
+  builder_->CreateStore(val, arg);
+  return arg;
+}
+
+llvm::Value * codegen::_receive_arg(llvm::Value * const arg, const type_info * const t) const
+{
+  if (!_by_reference(t)) {
+    return arg;
+  }
+  return builder_->CreateLoad(_type_to_llvm(t), arg, "recarg");
+}
+
+llvm::StructType * codegen::_record_vec_struct_type() const
+{
+  /* slc_record_vec: len, cap, data, fields, then a vec header per column */
+  return llvm::StructType::get(
+    *context_, {
+      llvm::Type::getInt64Ty(*context_),
+      llvm::Type::getInt64Ty(*context_),
+      llvm::PointerType::get(*context_, 0),
+      llvm::Type::getInt64Ty(*context_),
+      llvm::ArrayType::get(_vec_struct_type(), 0),
+    });
+}
+
+llvm::Value * codegen::_do_record_vec_create(
+  llvm::Value * const n, record_definition * const rec) const
+{
+  llvm::StructType * rec_t = record_types_.at(rec->get_name());
+  if (!rec->is_soa()) {
+    return _call_runtime(
+      type_id::VEC, type_id::RECORD, runtime_op::CREATE,
+      {n, llvm::ConstantExpr::getSizeOf(rec_t)});
+  }
+  /* size each column in whole words, so the next one starts aligned */
+  llvm::Type * i64_t = llvm::Type::getInt64Ty(*context_);
+  const std::size_t fields = rec->get_fields().size();
+  llvm::AllocaInst * bytes = _create_entry_alloca(llvm::ArrayType::get(i64_t, fields), "colbytes");
+  for (std::size_t x = 0; x < fields; ++x) {
+    const type_info * field_t = rec->get_fields()[x]->get_type();
+    llvm::Value * words = n;
+    if (field_t->type == type_id::BOOL) {
+      words = builder_->CreateLShr(builder_->CreateAdd(n, llvm::ConstantInt::get(i64_t, 63)), 6);
+    } else if (is_sized(field_t->type)) {
+      /* narrow numbers share words */
+      words = builder_->CreateLShr(
+        builder_->CreateAdd(
+          builder_->CreateMul(n, llvm::ConstantInt::get(i64_t, _value_size(field_t))),
+          llvm::ConstantInt::get(i64_t, 7)), 3);
+    }
+    builder_->CreateStore(
+      builder_->CreateMul(words, llvm::ConstantInt::get(i64_t, 8)),
+      builder_->CreateConstInBoundsGEP2_64(bytes->getAllocatedType(), bytes, 0, x));
+  }
+  return _call_runtime(
+    type_id::VEC, type_id::RECORD, runtime_op::CREATE_SOA,
+    {n, llvm::ConstantInt::get(i64_t, fields), bytes});
+}
+
+llvm::Value * codegen::_do_record_vec_column(llvm::Value * const v, const int field) const
+{
+  /* the header of column field, which is laid out like any other vec */
+  return builder_->CreateInBoundsGEP(
+    _record_vec_struct_type(), v,
+    {builder_->getInt32(0), builder_->getInt32(4), builder_->getInt32(field)}, "column");
+}
+
+llvm::Value * codegen::_do_record_vec_load(
+  llvm::Value * const v, llvm::Value * const idx, record_definition * const rec) const
+{
+  llvm::StructType * rec_t = record_types_.at(rec->get_name());
+  if (!rec->is_soa()) {
+    return builder_->CreateLoad(
+      rec_t, builder_->CreateInBoundsGEP(rec_t, _do_vec_data(v), {idx}), "rec");
+  }
+  /* gather the record from its columns */
+  llvm::Value * ret = llvm::UndefValue::get(rec_t);
+  for (std::size_t x = 0; x < rec->get_fields().size(); ++x) {
+    llvm::Value * column = _do_vec_data(_do_record_vec_column(v, x));
+    ret = builder_->CreateInsertValue(
+      ret, _do_vec_load(column, idx, rec->get_fields()[x]->get_type()->type), {(unsigned)x});
+  }
+  return ret;
+}
+
+void codegen::_do_record_vec_store(
+  llvm::Value * const v, llvm::Value * const idx, llvm::Value * const val,
+  record_definition * const rec) const
+{
+  llvm::StructType * rec_t = record_types_.at(rec->get_name());
+  if (!rec->is_soa()) {
+    builder_->CreateStore(val, builder_->CreateInBoundsGEP(rec_t, _do_vec_data(v), {idx}));
+    return;
+  }
+  /* scatter the record to its columns */
+  for (std::size_t x = 0; x < rec->get_fields().size(); ++x) {
+    llvm::Value * column = _do_vec_data(_do_record_vec_column(v, x));
+    _do_vec_store(
+      column, idx, builder_->CreateExtractValue(val, {(unsigned)x}),
+      rec->get_fields()[x]->get_type()->type);
+  }
+}
+
+llvm::Value * codegen::_do_record_vec_get(
+  llvm::Value * const v, record_definition * const rec, const int field) const
+{
+  if (rec->is_soa()) {
+    /* the column is already a vec */
+    return _do_record_vec_column(v, field);
+  }
+  /* an aos vec has to gather the field into a new vec */
+  const type_id field_t = rec->get_fields()[field]->get_type()->type;
+  llvm::StructType * rec_t = record_types_.at(rec->get_name());
+  llvm::Value * len = _do_vec_length(v);
+  llvm::Value * data = _do_vec_data(v);
+  llvm::Value * ret = _do_vec_create(len, field_t);
+  llvm::Value * out = _do_vec_data(ret);
+  _emit_index_loop(
+    len, [&](llvm::Value * idx) {
+      llvm::Value * elem = builder_->CreateLoad(
+        _type_id_to_llvm(field_t),
+        builder_->CreateInBoundsGEP(
+          rec_t, data, {idx, builder_->getInt32(field)}), "field");
+      _do_vec_store(out, idx, elem, field_t);
+    });
+  return ret;
+}
+
+llvm::Value * codegen::_do_list_to_vec(llvm::Value * l, const type_id elem_type) const
+{
+  return _call_runtime(type_id::VEC, elem_type, runtime_op::FROM_LIST, {l}, "tovectmp");
+}
+
+llvm::Value * codegen::_do_vec_to_list(llvm::Value * v, const type_id elem_type) const
+{
+  return _call_runtime(type_id::VEC, elem_type, runtime_op::TO_LIST, {v}, "tolisttmp");
+}
+
+llvm::Value * codegen::_do_create_list(const type_id list_type) const
+{
+  return _call_runtime(type_id::LIST, list_type, runtime_op::CREATE, {});
+}
+
+llvm::Value * codegen::_do_init_list(llvm::Value * l, const type_id list_type) const
+{
+  return _call_runtime(type_id::LIST, list_type, runtime_op::INIT, {l});
 }
 
 llvm::Value * codegen::_do_car(expression * const l) const
@@ -854,19 +2923,7 @@ llvm::Value * codegen::_do_car(expression * const l) const
 
 llvm::Value * codegen::_do_cdr(llvm::Value * l, const type_id list_type) const
 {
-  llvm::Function * op_impl;
-  std::vector<llvm::Value *> args = {l};
-  switch (list_type) {
-    case type_id::INT:
-      op_impl = module_->getFunction("slc_int_list_cdr");
-      break;
-    case type_id::FLOAT:
-      op_impl = module_->getFunction("slc_double_list_cdr");
-      break;
-    default:
-      return LogErrorV("unimplemented cdr type in _do_cdr");
-  }
-  return builder_->CreateCall(op_impl, args);
+  return _call_runtime(type_id::LIST, list_type, runtime_op::CDR, {l});
 }
 
 llvm::Value * codegen::_do_cdr(expression * const l) const
@@ -876,19 +2933,8 @@ llvm::Value * codegen::_do_cdr(expression * const l) const
 
 llvm::Value * codegen::_do_append(llvm::Value * const l, llvm::Value * const val, const type_id list_type) const
 {
-  llvm::Function * op_impl;
-  std::vector<llvm::Value *> args = {l, val};
-  switch (list_type) {
-    case type_id::INT:
-      op_impl = module_->getFunction("slc_int_list_append");
-      break;
-    case type_id::FLOAT:
-      op_impl = module_->getFunction("slc_double_list_append");
-      break;
-    default:
-      return LogErrorV("unimplemented append type in _do_append");
-  }
-  return builder_->CreateCall(op_impl, args);
+  return _call_runtime(
+    type_id::LIST, list_type, runtime_op::APPEND, {l, _to_storage(val, list_type)});
 }
 
 llvm::Value * codegen::_do_append(expression * const l, expression * const r) const
@@ -896,46 +2942,46 @@ llvm::Value * codegen::_do_append(expression * const l, expression * const r) co
   return _do_append(l->accept(this), r->accept(this), r->get_type()->type);
 }
 
-llvm::Value * codegen::_visit_unary_op_int_list(unary_op * const op) const
+llvm::Value * codegen::_visit_unary_op_list(unary_op * const op) const
 {
-  llvm::Function * op_impl;
+  const type_id list_type = op->get_children()[0]->get_type()->subtype->type;
   llvm::Value * arg = op->get_children()[0]->accept(this);
-  std::vector<llvm::Value *> args = {
-    arg
-  };
   switch (op->get_op()) {
     case op_id::CAR:
-      op_impl = module_->getFunction("slc_int_list_car");
-      return builder_->CreateLoad(
-        llvm::Type::getInt64Ty(*context_),
-        builder_->CreateCall(op_impl, args));
+      return _do_car(arg, list_type);
     case op_id::CDR:
-      op_impl = module_->getFunction("slc_int_list_cdr");
-      return builder_->CreateCall(op_impl, args);
+      return _do_cdr(arg, list_type);
+    case op_id::LENGTH:
+      return _do_length(arg, list_type);
+    case op_id::COMPACT:
+      return _call_runtime(type_id::LIST, list_type, runtime_op::COMPACT, {arg}, "compacttmp");
+    case op_id::REVERSE:
+      return _call_runtime(type_id::LIST, list_type, runtime_op::REVERSE, {arg}, "reversetmp");
     default:
       break;
   }
   return LogErrorV("unimplemented unary op");
 }
 
-llvm::Value * codegen::_visit_unary_op_float_list(unary_op * const op) const
+llvm::Value * codegen::_visit_unary_op_mat(unary_op * const op) const
 {
-  llvm::Function * op_impl;
+  const type_id elem_type = op->get_children()[0]->get_type()->subtype->type;
   llvm::Value * arg = op->get_children()[0]->accept(this);
-  std::vector<llvm::Value *> args = {
-    arg
-  };
   switch (op->get_op()) {
-    case op_id::CAR:
-      op_impl = module_->getFunction("slc_double_list_car");
-      break;
-    case op_id::CDR:
-      op_impl = module_->getFunction("slc_double_list_cdr");
-      break;
+    case op_id::LENGTH:
+      return _do_mat_rows(arg);
+    case op_id::COLS:
+      return _do_mat_cols(arg);
+    case op_id::TRANSPOSE:
+      return _call_runtime(type_id::MAT, elem_type, runtime_op::TRANSPOSE, {arg}, "transposetmp");
+    case op_id::ROW_SUMS:
+      return _call_runtime(type_id::MAT, elem_type, runtime_op::ROW_SUMS, {arg}, "rowsumtmp");
+    case op_id::COL_SUMS:
+      return _call_runtime(type_id::MAT, elem_type, runtime_op::COL_SUMS, {arg}, "colsumtmp");
     default:
-      return LogErrorV("unimplemented unary op");
+      break;
   }
-  return builder_->CreateCall(op_impl, args);
+  return LogErrorV("unimplemented unary op");
 }
 
 llvm::Value * codegen::visit_variable(variable * const var) const
@@ -75,6 +75,7 @@ int main(int argc, char ** argv)
   if (!ir) {
     return 1;
   }
+  llvm_codegen.optimize();
   FILE * llvm_out_f = fopen(llvm_out.c_str(), "w");
   auto file_out = llvm::raw_fd_ostream(fileno(llvm_out_f), true);
   /* write IR to file */
@@ -0,0 +1,574 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_bool_list.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * list<bool> keeps one bit per element in 64-bit words. Chunks otherwise
+ * work like the other lists (see slc_list_impl.h): cons fills a chunk
+ * downward, append fills it upward, and positions give O(1) length.
+ *
+ * A bit has no address of its own, so a list value is the address of its
+ * chunk with the index of the head bit in the top 16 bits. A chunk whose
+ * address doesn't leave those clear aborts the program, see
+ * asw/runtime/slc_bool_list.h for where that holds. Chunks
+ * don't need to be aligned, so they are sized to fit: small ones for cons
+ * and append, and up to 64K bits each when a list is built in bulk.
+ *
+ * The whole-list operations stream bits through in words of up to 64, so
+ * and/or/xor/count are popcounts and the masks are word-wide bit ops.
+ */
+_Static_assert(sizeof(void *) == 8, "list<bool> packs an index into pointer bits");
+
+#define SLC_BOOL_LIST_INDEX_SHIFT 48
+#define SLC_BOOL_LIST_CHUNK_MASK ((UINT64_C(1) << SLC_BOOL_LIST_INDEX_SHIFT) - 1)
+/* bits in a chunk made by cons or append */
+#define SLC_BOOL_LIST_CHUNK_BITS 256
+/* bits in the largest chunk, the index of the last one must fit in 16 bits */
+#define SLC_BOOL_LIST_MAX_BITS 65536
+
+struct slc_bool_list_chunk
+{
+  /* list that follows the last live bit of this chunk */
+  struct slc_bool_list * next;
+  /* hint to the last chunk reachable from this one */
+  struct slc_bool_list_chunk * last;
+  /* position of bit 0 */
+  int64_t base;
+  /* live bits are [first, end) */
+  uint32_t first;
+  uint32_t end;
+  uint32_t cap;
+  uint64_t words[];
+};
+
+/* a place in a list, used to stream through its bits */
+struct slc_bool_list_cursor
+{
+  struct slc_bool_list_chunk * chunk;
+  uint32_t index;
+};
+
+enum slc_bool_list_mask_op
+{
+  SLC_BOOL_LIST_MASK_AND,
+  SLC_BOOL_LIST_MASK_OR,
+  SLC_BOOL_LIST_MASK_XOR,
+  SLC_BOOL_LIST_MASK_NOT,
+};
+
+static inline struct slc_bool_list_chunk * _chunk_of(struct slc_bool_list * list)
+{
+  return (struct slc_bool_list_chunk *)((uintptr_t)list & SLC_BOOL_LIST_CHUNK_MASK);
+}
+
+static inline uint32_t _index_of(struct slc_bool_list * list)
+{
+  return (uintptr_t)list >> SLC_BOOL_LIST_INDEX_SHIFT;
+}
+
+static inline struct slc_bool_list * _list_at(struct slc_bool_list_chunk * chunk, uint32_t index)
+{
+  return (struct slc_bool_list *)((uintptr_t)chunk | ((uintptr_t)index << SLC_BOOL_LIST_INDEX_SHIFT));
+}
+
+static inline int64_t _position(struct slc_bool_list * list)
+{
+  return _chunk_of(list)->base + _index_of(list);
+}
+
+/* find the last chunk reachable from chunk, refreshing its hint */
+static struct slc_bool_list_chunk * _last_chunk(struct slc_bool_list_chunk * chunk)
+{
+  struct slc_bool_list_chunk * last = chunk->last;
+  while (NULL != last->next) {
+    last = _chunk_of(last->next)->last;
+  }
+  chunk->last = last;
+  return last;
+}
+
+static inline int8_t _get_bit(const struct slc_bool_list_chunk * chunk, uint32_t x)
+{
+  return (chunk->words[x / 64] >> (x % 64)) & 1;
+}
+
+static inline void _set_bit(struct slc_bool_list_chunk * chunk, uint32_t x, int8_t val)
+{
+  uint64_t bit = UINT64_C(1) << (x % 64);
+  if (val) {
+    chunk->words[x / 64] |= bit;
+  } else {
+    chunk->words[x / 64] &= ~bit;
+  }
+}
+
+static inline uint64_t _mask_of(uint32_t n)
+{
+  return (n < 64) ? (UINT64_C(1) << n) - 1 : ~UINT64_C(0);
+}
+
+/* read n <= 64 bits starting at bit x */
+static inline uint64_t _get_bits(const struct slc_bool_list_chunk * chunk, uint32_t x, uint32_t n)
+{
+  uint32_t word = x / 64, shift = x % 64;
+  uint64_t bits = chunk->words[word] >> shift;
+  if (0 != shift && shift + n > 64) {
+    bits |= chunk->words[word + 1] << (64 - shift);
+  }
+  return bits & _mask_of(n);
+}
+
+/* write the low n <= 64 bits of bits starting at bit x */
+static inline void _put_bits(struct slc_bool_list_chunk * chunk, uint32_t x, uint64_t bits, uint32_t n)
+{
+  uint32_t word = x / 64, shift = x % 64;
+  uint64_t mask = _mask_of(n);
+  bits &= mask;
+  chunk->words[word] = (chunk->words[word] & ~(mask << shift)) | (bits << shift);
+  if (0 != shift && shift + n > 64) {
+    chunk->words[word + 1] =
+      (chunk->words[word + 1] & ~(mask >> (64 - shift))) | (bits >> (64 - shift));
+  }
+}
+
+/* number of set bits in [from, to) of chunk */
+static int64_t _popcount(const struct slc_bool_list_chunk * chunk, uint32_t from, uint32_t to)
+{
+  int64_t count = 0;
+  while (from < to) {
+    /* stop at word boundaries so that each read is a single word */
+    uint32_t n = 64 - from % 64;
+    n = (n < to - from) ? n : to - from;
+    count += __builtin_popcountll(_get_bits(chunk, from, n));
+    from += n;
+  }
+  return count;
+}
+
+static inline struct slc_bool_list_cursor _cursor(struct slc_bool_list * list)
+{
+  struct slc_bool_list_cursor cursor = {_chunk_of(list), _index_of(list)};
+  return cursor;
+}
+
+/* bits left in the chunk under the cursor */
+static inline uint32_t _cursor_run(const struct slc_bool_list_cursor * cursor)
+{
+  return cursor->chunk->end - cursor->index;
+}
+
+static inline void _cursor_advance(struct slc_bool_list_cursor * cursor, uint32_t n)
+{
+  cursor->index += n;
+  if (cursor->index == cursor->chunk->end && NULL != cursor->chunk->next) {
+    *cursor = _cursor(cursor->chunk->next);
+  }
+}
+
+static struct slc_bool_list_chunk * _chunk_create(uint32_t cap)
+{
+  /* whole words only */
+  cap = (cap + 63) / 64 * 64;
+  struct slc_bool_list_chunk * chunk =
+    calloc(1, sizeof(struct slc_bool_list_chunk) + cap / 8);
+  if (NULL == chunk) {
+    return NULL;
+  }
+  /* the top bits carry the index, see asw/runtime/slc_bool_list.h */
+  if (0 != ((uintptr_t)chunk >> SLC_BOOL_LIST_INDEX_SHIFT)) {
+    fprintf(
+      stderr, "slc: list<bool> chunk at %p is above 2^48, its index bits would be lost\n",
+      (void *)chunk);
+    abort();
+  }
+  chunk->last = chunk;
+  chunk->cap = cap;
+  return chunk;
+}
+
+struct slc_bool_list * slc_bool_list_create()
+{
+  struct slc_bool_list_chunk * chunk = _chunk_create(SLC_BOOL_LIST_CHUNK_BITS);
+  if (NULL == chunk) {
+    return NULL;
+  }
+  /* start at the top so later conses can fill in below */
+  chunk->first = chunk->cap - 1;
+  chunk->end = chunk->cap;
+  return _list_at(chunk, chunk->first);
+}
+
+int8_t slc_bool_list_destroy(struct slc_bool_list * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  free(_chunk_of(list));
+  return 1;
+}
+
+int8_t slc_bool_list_init(struct slc_bool_list * list)
+{
+  struct slc_bool_list_chunk * chunk = _chunk_of(list);
+  _set_bit(chunk, _index_of(list), 0);
+  chunk->end = _index_of(list) + 1;
+  chunk->next = NULL;
+  chunk->last = chunk;
+  return 1;
+}
+
+int8_t slc_bool_list_fini(struct slc_bool_list * list)
+{
+  struct slc_bool_list_chunk * chunk = _chunk_of(list);
+  struct slc_bool_list * tail = chunk->next;
+  chunk->next = NULL;
+  chunk->last = chunk;
+  chunk->end = _index_of(list) + 1;
+  while (NULL != tail) {
+    struct slc_bool_list * next = _chunk_of(tail)->next;
+    slc_bool_list_destroy(tail);
+    tail = next;
+  }
+  return 1;
+}
+
+int8_t slc_bool_list_set_head(struct slc_bool_list * list, int8_t val)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  _set_bit(_chunk_of(list), _index_of(list), val);
+  return 1;
+}
+
+int8_t slc_bool_list_head(struct slc_bool_list * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  return _get_bit(_chunk_of(list), _index_of(list));
+}
+
+struct slc_bool_list * slc_bool_list_cdr(struct slc_bool_list * list)
+{
+  if (NULL == list) {
+    return NULL;
+  }
+  struct slc_bool_list_chunk * chunk = _chunk_of(list);
+  uint32_t index = _index_of(list) + 1;
+  if (index != chunk->end) {
+    return _list_at(chunk, index);
+  }
+  return chunk->next;
+}
+
+int64_t slc_bool_list_length(struct slc_bool_list * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  struct slc_bool_list_chunk * last = _last_chunk(_chunk_of(list));
+  return last->base + last->end - _position(list);
+}
+
+struct slc_bool_list * slc_bool_list_cons(int8_t head, struct slc_bool_list * tail)
+{
+  if (NULL != tail) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(tail);
+    if (_index_of(tail) == chunk->first && chunk->first > 0) {
+      /* the bit below the head is unclaimed, use it */
+      _set_bit(chunk, --chunk->first, head);
+      return _list_at(chunk, chunk->first);
+    }
+  }
+  struct slc_bool_list * ret = slc_bool_list_create();
+  if (NULL == ret) {
+    return NULL;
+  }
+  struct slc_bool_list_chunk * chunk = _chunk_of(ret);
+  _set_bit(chunk, chunk->first, head);
+  if (NULL != tail) {
+    chunk->next = tail;
+    chunk->last = _last_chunk(_chunk_of(tail));
+    chunk->base = _position(tail) - chunk->end;
+  }
+  return ret;
+}
+
+struct slc_bool_list * slc_bool_list_append(struct slc_bool_list * list, int8_t val)
+{
+  struct slc_bool_list_chunk * last = NULL;
+  if (NULL != list) {
+    last = _last_chunk(_chunk_of(list));
+    if (last->end < last->cap) {
+      _set_bit(last, last->end++, val);
+      return list;
+    }
+  }
+  /* start a new chunk that fills upward */
+  struct slc_bool_list_chunk * chunk = _chunk_create(SLC_BOOL_LIST_CHUNK_BITS);
+  if (NULL == chunk) {
+    return NULL;
+  }
+  _set_bit(chunk, 0, val);
+  chunk->end = 1;
+  if (NULL == last) {
+    return _list_at(chunk, 0);
+  }
+  chunk->base = last->base + last->end;
+  last->next = _list_at(chunk, 0);
+  last->last = chunk;
+  _chunk_of(list)->last = chunk;
+  return list;
+}
+
+struct slc_bool_list * slc_bool_list_reserve(size_t n)
+{
+  if (0 == n) {
+    return NULL;
+  }
+  /* the head chunk takes the remainder, top-aligned so cons can extend it */
+  size_t count = (n + SLC_BOOL_LIST_MAX_BITS - 1) / SLC_BOOL_LIST_MAX_BITS;
+  uint32_t remainder = n - (count - 1) * SLC_BOOL_LIST_MAX_BITS;
+  struct slc_bool_list_chunk * head = _chunk_create(remainder);
+  if (NULL == head) {
+    return NULL;
+  }
+  head->first = head->cap - remainder;
+  head->end = head->cap;
+  struct slc_bool_list_chunk * chunk = head;
+  for (size_t x = 1; x < count; ++x) {
+    struct slc_bool_list_chunk * next = _chunk_create(SLC_BOOL_LIST_MAX_BITS);
+    if (NULL == next) {
+      slc_bool_list_fini(_list_at(head, head->first));
+      free(head);
+      return NULL;
+    }
+    next->end = next->cap;
+    next->base = chunk->base + chunk->end;
+    chunk->next = _list_at(next, 0);
+    chunk = next;
+  }
+  for (struct slc_bool_list_chunk * iter = head; ; iter = _chunk_of(iter->next)) {
+    iter->last = chunk;
+    if (iter == chunk) {
+      break;
+    }
+  }
+  return _list_at(head, head->first);
+}
+
+struct slc_bool_list * slc_bool_list_from_array(const int8_t * vals, size_t n)
+{
+  struct slc_bool_list * ret = slc_bool_list_reserve(n);
+  if (NULL == ret) {
+    return NULL;
+  }
+  struct slc_bool_list_cursor out = _cursor(ret);
+  while (n > 0) {
+    uint32_t k = _cursor_run(&out);
+    k = (k < 64) ? k : 64;
+    k = (k < n) ? k : n;
+    uint64_t bits = 0;
+    for (uint32_t x = 0; x < k; ++x) {
+      bits |= (uint64_t)(0 != vals[x]) << x;
+    }
+    _put_bits(out.chunk, out.index, bits, k);
+    _cursor_advance(&out, k);
+    vals += k;
+    n -= k;
+  }
+  return ret;
+}
+
+const int8_t * slc_bool_list_run(
+  struct slc_bool_list * list, int64_t * n, struct slc_bool_list ** next, int8_t * buf)
+{
+  struct slc_bool_list_chunk * chunk = _chunk_of(list);
+  uint32_t index = _index_of(list);
+  uint32_t count = chunk->end - index;
+  count = (count < SLC_BOOL_LIST_RUN) ? count : SLC_BOOL_LIST_RUN;
+  for (uint32_t x = 0; x < count; x += 64) {
+    uint32_t k = (count - x < 64) ? count - x : 64;
+    uint64_t bits = _get_bits(chunk, index + x, k);
+    for (uint32_t y = 0; y < k; ++y) {
+      buf[x + y] = (bits >> y) & 1;
+    }
+  }
+  *n = count;
+  *next = (index + count != chunk->end) ? _list_at(chunk, index + count) : chunk->next;
+  return buf;
+}
+
+size_t slc_bool_list_to_array(struct slc_bool_list * list, int8_t * out)
+{
+  size_t n = 0;
+  for (; NULL != list; list = _chunk_of(list)->next) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(list);
+    for (uint32_t x = _index_of(list); x < chunk->end; ++x) {
+      out[n++] = _get_bit(chunk, x);
+    }
+  }
+  return n;
+}
+
+struct slc_bool_list * slc_bool_list_from_words(const uint64_t * words, size_t n)
+{
+  struct slc_bool_list * ret = slc_bool_list_reserve(n);
+  if (NULL == ret) {
+    return NULL;
+  }
+  struct slc_bool_list_cursor out = _cursor(ret);
+  for (size_t x = 0; x < n; ) {
+    /* take what is left of the current word, or what fits in the chunk */
+    uint32_t k = 64 - x % 64;
+    k = (k < _cursor_run(&out)) ? k : _cursor_run(&out);
+    k = (k < n - x) ? k : n - x;
+    _put_bits(out.chunk, out.index, words[x / 64] >> (x % 64), k);
+    _cursor_advance(&out, k);
+    x += k;
+  }
+  return ret;
+}
+
+size_t slc_bool_list_to_words(struct slc_bool_list * list, uint64_t * words)
+{
+  size_t n = 0;
+  for (; NULL != list; list = _chunk_of(list)->next) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(list);
+    for (uint32_t x = _index_of(list); x < chunk->end; ) {
+      /* fill up to the end of the current output word */
+      uint32_t k = 64 - n % 64;
+      k = (k < chunk->end - x) ? k : chunk->end - x;
+      uint64_t bits = _get_bits(chunk, x, k) << (n % 64);
+      words[n / 64] = (0 == n % 64) ? bits : words[n / 64] | bits;
+      x += k;
+      n += k;
+    }
+  }
+  return n;
+}
+
+int64_t slc_bool_list_count(struct slc_bool_list * list)
+{
+  int64_t count = 0;
+  for (; NULL != list; list = _chunk_of(list)->next) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(list);
+    count += _popcount(chunk, _index_of(list), chunk->end);
+  }
+  return count;
+}
+
+int8_t slc_bool_list_and(struct slc_bool_list * list)
+{
+  for (; NULL != list; list = _chunk_of(list)->next) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(list);
+    if (_popcount(chunk, _index_of(list), chunk->end) != chunk->end - _index_of(list)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int8_t slc_bool_list_or(struct slc_bool_list * list)
+{
+  for (; NULL != list; list = _chunk_of(list)->next) {
+    struct slc_bool_list_chunk * chunk = _chunk_of(list);
+    if (_popcount(chunk, _index_of(list), chunk->end) != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int8_t slc_bool_list_xor(struct slc_bool_list * list)
+{
+  return slc_bool_list_count(list) & 1;
+}
+
+static struct slc_bool_list * _mask(
+  struct slc_bool_list * lhs, struct slc_bool_list * rhs, enum slc_bool_list_mask_op op)
+{
+  int64_t n = slc_bool_list_length(lhs);
+  if (SLC_BOOL_LIST_MASK_NOT != op) {
+    int64_t rhs_n = slc_bool_list_length(rhs);
+    n = (n < rhs_n) ? n : rhs_n;
+  }
+  struct slc_bool_list * ret = slc_bool_list_reserve(n);
+  if (NULL == ret) {
+    return NULL;
+  }
+  struct slc_bool_list_cursor out = _cursor(ret), l = _cursor(lhs), r = l;
+  if (SLC_BOOL_LIST_MASK_NOT != op) {
+    r = _cursor(rhs);
+  }
+  while (n > 0) {
+    /* as many bits as all three lists have left in their chunks */
+    uint32_t k = (n < 64) ? n : 64;
+    k = (k < _cursor_run(&out)) ? k : _cursor_run(&out);
+    k = (k < _cursor_run(&l)) ? k : _cursor_run(&l);
+    k = (k < _cursor_run(&r)) ? k : _cursor_run(&r);
+    uint64_t lbits = _get_bits(l.chunk, l.index, k);
+    uint64_t rbits = _get_bits(r.chunk, r.index, k);
+    uint64_t bits = 0;
+    switch (op) {
+      case SLC_BOOL_LIST_MASK_AND:
+        bits = lbits & rbits;
+        break;
+      case SLC_BOOL_LIST_MASK_OR:
+        bits = lbits | rbits;
+        break;
+      case SLC_BOOL_LIST_MASK_XOR:
+        bits = lbits ^ rbits;
+        break;
+      case SLC_BOOL_LIST_MASK_NOT:
+        bits = ~lbits;
+        break;
+    }
+    _put_bits(out.chunk, out.index, bits, k);
+    _cursor_advance(&out, k);
+    _cursor_advance(&l, k);
+    if (SLC_BOOL_LIST_MASK_NOT != op) {
+      _cursor_advance(&r, k);
+    } else {
+      r = l;
+    }
+    n -= k;
+  }
+  return ret;
+}
+
+struct slc_bool_list * slc_bool_list_not(struct slc_bool_list * list)
+{
+  return _mask(list, NULL, SLC_BOOL_LIST_MASK_NOT);
+}
+
+struct slc_bool_list * slc_bool_list_mask_and(struct slc_bool_list * lhs, struct slc_bool_list * rhs)
+{
+  return _mask(lhs, rhs, SLC_BOOL_LIST_MASK_AND);
+}
+
+struct slc_bool_list * slc_bool_list_mask_or(struct slc_bool_list * lhs, struct slc_bool_list * rhs)
+{
+  return _mask(lhs, rhs, SLC_BOOL_LIST_MASK_OR);
+}
+
+struct slc_bool_list * slc_bool_list_mask_xor(struct slc_bool_list * lhs, struct slc_bool_list * rhs)
+{
+  return _mask(lhs, rhs, SLC_BOOL_LIST_MASK_XOR);
+}
@@ -0,0 +1,196 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_bool_list.h>
+#include <asw/runtime/slc_bool_vec.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Everything here works on whole words. The only care needed is the last
+ * word, whose bits past len are masked off before they are counted.
+ */
+
+#define SLC_BOOL_VEC_WORDS(n) (((n) + 63) / 64)
+
+/* the live bits of the last word of vec */
+static inline uint64_t _tail_mask(const struct slc_bool_vec * vec)
+{
+  return (0 == vec->len % 64) ? ~UINT64_C(0) : (UINT64_C(1) << (vec->len % 64)) - 1;
+}
+
+struct slc_bool_vec * slc_bool_vec_create(size_t n)
+{
+  struct slc_bool_vec * vec =
+    calloc(1, sizeof(struct slc_bool_vec) + SLC_BOOL_VEC_WORDS(n) * sizeof(uint64_t));
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = n;
+  vec->cap = n;
+  vec->data = vec->storage;
+  return vec;
+}
+
+int8_t slc_bool_vec_destroy(struct slc_bool_vec * vec)
+{
+  if (NULL == vec) {
+    return 0;
+  }
+  free(vec);
+  return 1;
+}
+
+int64_t slc_bool_vec_length(struct slc_bool_vec * vec)
+{
+  return vec->len;
+}
+
+int64_t slc_bool_vec_count(struct slc_bool_vec * vec)
+{
+  const int64_t words = SLC_BOOL_VEC_WORDS(vec->len);
+  if (0 == words) {
+    return 0;
+  }
+  int64_t count = 0;
+  for (int64_t x = 0; x < words - 1; ++x) {
+    count += __builtin_popcountll(vec->data[x]);
+  }
+  return count + __builtin_popcountll(vec->data[words - 1] & _tail_mask(vec));
+}
+
+struct slc_bool_vec * slc_bool_vec_not(struct slc_bool_vec * vec)
+{
+  struct slc_bool_vec * ret = slc_bool_vec_create(vec->len);
+  if (NULL == ret) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < SLC_BOOL_VEC_WORDS(vec->len); ++x) {
+    ret->data[x] = ~vec->data[x];
+  }
+  return ret;
+}
+
+struct slc_bool_vec * slc_bool_vec_slice(struct slc_bool_vec * vec, int64_t start, int64_t end)
+{
+  /* clamp to [0, len] so a slice never reaches outside of vec */
+  start = (start < 0) ? 0 : (start > vec->len) ? vec->len : start;
+  end = (end < start) ? start : (end > vec->len) ? vec->len : end;
+  if (0 == start % 64) {
+    /* starts on a word, so it can share them */
+    struct slc_bool_vec * view = malloc(sizeof(struct slc_bool_vec));
+    if (NULL == view) {
+      return NULL;
+    }
+    view->len = end - start;
+    view->cap = 0;
+    view->data = vec->data + start / 64;
+    return view;
+  }
+  struct slc_bool_vec * ret = slc_bool_vec_create(end - start);
+  if (NULL == ret) {
+    return NULL;
+  }
+  /* shift the words down into place */
+  const int64_t shift = start % 64;
+  const uint64_t * src = vec->data + start / 64;
+  const int64_t src_words = SLC_BOOL_VEC_WORDS(vec->len) - start / 64;
+  for (int64_t x = 0; x < SLC_BOOL_VEC_WORDS(ret->len); ++x) {
+    uint64_t bits = src[x] >> shift;
+    if (x + 1 < src_words) {
+      bits |= src[x + 1] << (64 - shift);
+    }
+    ret->data[x] = bits;
+  }
+  return ret;
+}
+
+struct slc_bool_vec * slc_bool_vec_from_array(const int8_t * vals, size_t n)
+{
+  struct slc_bool_vec * vec = slc_bool_vec_create(n);
+  if (NULL == vec) {
+    return NULL;
+  }
+  for (size_t x = 0; x < n; ++x) {
+    vec->data[x / 64] |= (uint64_t)(0 != vals[x]) << (x % 64);
+  }
+  return vec;
+}
+
+struct slc_bool_vec * slc_bool_vec_from_list(struct slc_bool_list * list)
+{
+  struct slc_bool_vec * vec = slc_bool_vec_create(slc_bool_list_length(list));
+  if (NULL == vec) {
+    return NULL;
+  }
+  slc_bool_list_to_words(list, vec->data);
+  return vec;
+}
+
+struct slc_bool_list * slc_bool_vec_to_list(struct slc_bool_vec * vec)
+{
+  return slc_bool_list_from_words(vec->data, vec->len);
+}
+
+int8_t slc_bool_vec_and(struct slc_bool_vec * vec)
+{
+  return slc_bool_vec_count(vec) == vec->len;
+}
+
+int8_t slc_bool_vec_or(struct slc_bool_vec * vec)
+{
+  return slc_bool_vec_count(vec) != 0;
+}
+
+int8_t slc_bool_vec_xor(struct slc_bool_vec * vec)
+{
+  return slc_bool_vec_count(vec) & 1;
+}
+
+struct slc_bool_vec * slc_bool_vec_mask_and(struct slc_bool_vec * lhs, struct slc_bool_vec * rhs)
+{
+  struct slc_bool_vec * ret = slc_bool_vec_create((lhs->len < rhs->len) ? lhs->len : rhs->len);
+  if (NULL == ret) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < SLC_BOOL_VEC_WORDS(ret->len); ++x) {
+    ret->data[x] = lhs->data[x] & rhs->data[x];
+  }
+  return ret;
+}
+
+struct slc_bool_vec * slc_bool_vec_mask_or(struct slc_bool_vec * lhs, struct slc_bool_vec * rhs)
+{
+  struct slc_bool_vec * ret = slc_bool_vec_create((lhs->len < rhs->len) ? lhs->len : rhs->len);
+  if (NULL == ret) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < SLC_BOOL_VEC_WORDS(ret->len); ++x) {
+    ret->data[x] = lhs->data[x] | rhs->data[x];
+  }
+  return ret;
+}
+
+struct slc_bool_vec * slc_bool_vec_mask_xor(struct slc_bool_vec * lhs, struct slc_bool_vec * rhs)
+{
+  struct slc_bool_vec * ret = slc_bool_vec_create((lhs->len < rhs->len) ? lhs->len : rhs->len);
+  if (NULL == ret) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < SLC_BOOL_VEC_WORDS(ret->len); ++x) {
+    ret->data[x] = lhs->data[x] ^ rhs->data[x];
+  }
+  return ret;
+}
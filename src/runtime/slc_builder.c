@@ -0,0 +1,95 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_builder.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLC_BUILDER_MIN_CAP 64
+
+struct slc_builder
+{
+  int64_t len;
+  int64_t cap;
+  char * bytes;
+};
+
+struct slc_builder * slc_builder_create()
+{
+  struct slc_builder * builder = malloc(sizeof(struct slc_builder));
+  if (NULL == builder) {
+    return NULL;
+  }
+  builder->bytes = malloc(SLC_BUILDER_MIN_CAP);
+  if (NULL == builder->bytes) {
+    free(builder);
+    return NULL;
+  }
+  builder->len = 0;
+  builder->cap = SLC_BUILDER_MIN_CAP;
+  return builder;
+}
+
+int8_t slc_builder_destroy(struct slc_builder * builder)
+{
+  if (NULL == builder) {
+    return 0;
+  }
+  free(builder->bytes);
+  free(builder);
+  return 1;
+}
+
+/* double the capacity until len bytes fit */
+static int _grow(struct slc_builder * builder, int64_t len)
+{
+  int64_t cap = builder->cap;
+  while (cap < len) {
+    cap *= 2;
+  }
+  char * bytes = realloc(builder->bytes, cap);
+  if (NULL == bytes) {
+    return 0;
+  }
+  builder->bytes = bytes;
+  builder->cap = cap;
+  return 1;
+}
+
+struct slc_builder * slc_builder_push(struct slc_builder * builder, const char * s)
+{
+  const int64_t n = strlen(s);
+  if (builder->len + n > builder->cap && !_grow(builder, builder->len + n)) {
+    return NULL;
+  }
+  memcpy(&builder->bytes[builder->len], s, n);
+  builder->len += n;
+  return builder;
+}
+
+const char * slc_builder_string(struct slc_builder * builder)
+{
+  char * ret = malloc(builder->len + 1);
+  if (NULL == ret) {
+    return NULL;
+  }
+  memcpy(ret, builder->bytes, builder->len);
+  ret[builder->len] = '\0';
+  return ret;
+}
+
+int64_t slc_builder_length(struct slc_builder * builder)
+{
+  return builder->len;
+}
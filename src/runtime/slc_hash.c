@@ -0,0 +1,121 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_hash.h>
+#include <asw/runtime/slc_symbol.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slc_hash_group.h"
+
+static inline uint64_t _hash_double(double key)
+{
+  /* -0.0 == 0.0, so they have to hash the same */
+  uint64_t bits = 0;
+  if (key != key) {
+    /* every NaN is the same key, see SLC_TABLE_EQ below */
+    bits = UINT64_C(0x7ff8000000000000);
+  } else if (0.0 != key) {
+    memcpy(&bits, &key, sizeof(bits));
+  }
+  return slc_hash_mix(bits);
+}
+
+#define SLC_TABLE_NAME int
+#define SLC_TABLE_K int64_t
+#define SLC_TABLE_FMT "%ld"
+#define SLC_TABLE_HASH(k) slc_hash_mix((uint64_t)(k))
+#define SLC_TABLE_EQ(a, b) ((a) == (b))
+#include "slc_table_impl.h"
+
+#define SLC_TABLE_NAME double
+#define SLC_TABLE_K double
+#define SLC_TABLE_FMT "%f"
+#define SLC_TABLE_HASH(k) _hash_double(k)
+/* NaN != NaN, so without this a NaN key could be put but never found */
+#define SLC_TABLE_EQ(a, b) ((a) == (b) || ((a) != (a) && (b) != (b)))
+#include "slc_table_impl.h"
+
+#define SLC_TABLE_NAME string
+#define SLC_TABLE_K const char *
+#define SLC_TABLE_FMT "%s"
+#define SLC_TABLE_HASH(k) slc_hash_string(k)
+#define SLC_TABLE_EQ(a, b) ((a) == (b) || 0 == strcmp((a), (b)))
+#include "slc_table_impl.h"
+
+/* interned, so equal symbols are the same pointer */
+#define SLC_TABLE_NAME symbol
+#define SLC_TABLE_K const char *
+#define SLC_TABLE_FMT "%s"
+#define SLC_TABLE_HASH(k) slc_hash_mix((uintptr_t)(k))
+#define SLC_TABLE_EQ(a, b) ((a) == (b))
+#include "slc_table_impl.h"
+
+/**
+ * The interner is a set<string> of the canonical copies, so it can use the
+ * table's own find to get at the copy it stores. Symbols are never freed,
+ * so the copies are carved out of blocks rather than allocated one by one.
+ */
+#define SLC_SYMBOL_BLOCK_BYTES 65536
+
+static struct slc_string_table * _symbols = NULL;
+
+static const char * _copy_symbol(const char * s)
+{
+  static char * block = NULL;
+  static size_t left = 0;
+  size_t n = strlen(s) + 1;
+  if (n > SLC_SYMBOL_BLOCK_BYTES / 4) {
+    /* a long string gets its own allocation, so it doesn't waste a block */
+    char * copy = malloc(n);
+    return (NULL == copy) ? NULL : memcpy(copy, s, n);
+  } else if (n > left) {
+    if (NULL == (block = malloc(SLC_SYMBOL_BLOCK_BYTES))) {
+      left = 0;
+      return NULL;
+    }
+    left = SLC_SYMBOL_BLOCK_BYTES;
+  }
+  char * copy = memcpy(block, s, n);
+  block += n;
+  left -= n;
+  return copy;
+}
+
+static const char * _intern(const char * s, int8_t copy)
+{
+  if (NULL == _symbols && NULL == (_symbols = slc_string_set_create())) {
+    return NULL;
+  }
+  int64_t x = slc_string_table_find(_symbols, s, slc_hash_string(s));
+  if (x >= 0) {
+    return _symbols->keys[x];
+  }
+  const char * symbol = copy ? _copy_symbol(s) : s;
+  if (NULL == symbol || slc_string_table_insert(_symbols, symbol) < 0) {
+    return NULL;
+  }
+  return symbol;
+}
+
+const char * slc_symbol_intern(const char * s)
+{
+  return _intern(s, 1);
+}
+
+const char * slc_symbol_intern_static(const char * s)
+{
+  return _intern(s, 0);
+}
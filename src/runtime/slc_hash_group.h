@@ -0,0 +1,89 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_HASH_GROUP_H_
+#define ASW__SLC__RUNTIME__SLC_HASH_GROUP_H_
+
+#include <stdint.h>
+
+/**
+ * Control bytes of a hash table are probed a group at a time. A full
+ * slot holds 7 bits of its key's hash, so its top bit is clear, and the
+ * two free states both have it set. Each match returns a mask with bit x
+ * set when slot x of the group matches.
+ */
+#define SLC_HASH_GROUP 16
+#define SLC_HASH_EMPTY ((int8_t)-128)
+#define SLC_HASH_DELETED ((int8_t)-2)
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+static inline uint32_t slc_hash_match(const int8_t * group, int8_t h2)
+{
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+}
+
+/* empty or deleted, the top bit of the byte is exactly what movemask takes */
+static inline uint32_t slc_hash_match_free(const int8_t * group)
+{
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#else
+static inline uint32_t slc_hash_match(const int8_t * group, int8_t h2)
+{
+  uint32_t mask = 0;
+  for (uint32_t x = 0; x < SLC_HASH_GROUP; ++x) {
+    mask |= (uint32_t)(group[x] == h2) << x;
+  }
+  return mask;
+}
+
+static inline uint32_t slc_hash_match_free(const int8_t * group)
+{
+  uint32_t mask = 0;
+  for (uint32_t x = 0; x < SLC_HASH_GROUP; ++x) {
+    mask |= (uint32_t)(group[x] < 0) << x;
+  }
+  return mask;
+}
+#endif
+
+static inline uint32_t slc_hash_match_empty(const int8_t * group)
+{
+  return slc_hash_match(group, SLC_HASH_EMPTY);
+}
+
+/* the splitmix64 finalizer, every input bit reaches every output bit */
+static inline uint64_t slc_hash_mix(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= UINT64_C(0xbf58476d1ce4e5b9);
+  x ^= x >> 27;
+  x *= UINT64_C(0x94d049bb133111eb);
+  return x ^ (x >> 31);
+}
+
+/* FNV-1a, mixed again since it leaves the low bits weak */
+static inline uint64_t slc_hash_string(const char * key)
+{
+  uint64_t hash = UINT64_C(0xcbf29ce484222325);
+  for (; '\0' != *key; ++key) {
+    hash = (hash ^ (unsigned char)*key) * UINT64_C(0x100000001b3);
+  }
+  return slc_hash_mix(hash);
+}
+
+#endif  /* ASW__SLC__RUNTIME__SLC_HASH_GROUP_H_ */
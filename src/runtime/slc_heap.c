@@ -0,0 +1,144 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <asw/runtime/slc_heap.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLC_HEAP_ARITY 4
+#define SLC_HEAP_MIN_CAP 16
+/**
+ * keys starts this many slots into a cache aligned block, so the children
+ * of element i, 4i + 1 to 4i + 4, are slots 4 (i + 1) to 4 (i + 1) + 3 of
+ * the block: 32 bytes on a 32 byte boundary, half of one cache line.
+ */
+#define SLC_HEAP_OFFSET (SLC_HEAP_ARITY - 1)
+#define SLC_HEAP_ALIGN 64
+
+static inline int64_t * _alloc_keys(int64_t cap)
+{
+  size_t bytes = (cap + SLC_HEAP_OFFSET) * sizeof(int64_t);
+  bytes = (bytes + SLC_HEAP_ALIGN - 1) & ~(size_t)(SLC_HEAP_ALIGN - 1);
+  int64_t * block = aligned_alloc(SLC_HEAP_ALIGN, bytes);
+  return (NULL == block) ? NULL : block + SLC_HEAP_OFFSET;
+}
+
+static inline void _free_keys(int64_t * keys)
+{
+  free(keys - SLC_HEAP_OFFSET);
+}
+
+struct slc_heap * slc_heap_create(int8_t max)
+{
+  struct slc_heap * heap = malloc(sizeof(struct slc_heap));
+  if (NULL == heap) {
+    return NULL;
+  }
+  heap->keys = _alloc_keys(SLC_HEAP_MIN_CAP);
+  if (NULL == heap->keys) {
+    free(heap);
+    return NULL;
+  }
+  heap->len = 0;
+  heap->cap = SLC_HEAP_MIN_CAP;
+  heap->flip = max ? ~INT64_C(0) : 0;
+  return heap;
+}
+
+int8_t slc_heap_destroy(struct slc_heap * heap)
+{
+  if (NULL == heap) {
+    return 0;
+  }
+  _free_keys(heap->keys);
+  free(heap);
+  return 1;
+}
+
+/* move the hole at x up until key fits there */
+static void _sift_up(int64_t * keys, int64_t x, int64_t key)
+{
+  while (x > 0) {
+    int64_t parent = (x - 1) / SLC_HEAP_ARITY;
+    if (keys[parent] <= key) {
+      break;
+    }
+    keys[x] = keys[parent];
+    x = parent;
+  }
+  keys[x] = key;
+}
+
+/* move the hole at the root down until key fits there */
+static void _sift_down(int64_t * keys, int64_t len, int64_t key)
+{
+  int64_t x = 0;
+  for (;;) {
+    int64_t first = SLC_HEAP_ARITY * x + 1;
+    int64_t best = first;
+    if (first + SLC_HEAP_ARITY <= len) {
+      /* all four children are there, pick the smallest without branching on them */
+      int64_t a = first + (keys[first + 1] < keys[first]);
+      int64_t b = first + 2 + (keys[first + 3] < keys[first + 2]);
+      best = (keys[b] < keys[a]) ? b : a;
+    } else if (first < len) {
+      for (int64_t y = first + 1; y < len; ++y) {
+        best = (keys[y] < keys[best]) ? y : best;
+      }
+    } else {
+      break;
+    }
+    if (keys[best] >= key) {
+      break;
+    }
+    keys[x] = keys[best];
+    x = best;
+  }
+  keys[x] = key;
+}
+
+struct slc_heap * slc_heap_push(struct slc_heap * heap, int64_t key)
+{
+  if (heap->len == heap->cap) {
+    int64_t * keys = _alloc_keys(2 * heap->cap);
+    if (NULL == keys) {
+      return NULL;
+    }
+    memcpy(keys, heap->keys, heap->len * sizeof(int64_t));
+    _free_keys(heap->keys);
+    heap->keys = keys;
+    heap->cap *= 2;
+  }
+  _sift_up(heap->keys, heap->len++, key ^ heap->flip);
+  return heap;
+}
+
+int64_t slc_heap_pop(struct slc_heap * heap)
+{
+  if (0 == heap->len) {
+    return 0;
+  }
+  int64_t top = heap->keys[0];
+  int64_t last = heap->keys[--heap->len];
+  if (0 != heap->len) {
+    _sift_down(heap->keys, heap->len, last);
+  }
+  return top ^ heap->flip;
+}
+
+int64_t slc_heap_peek(struct slc_heap * heap)
+{
+  return (0 == heap->len) ? 0 : heap->keys[0] ^ heap->flip;
+}
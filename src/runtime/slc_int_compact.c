@@ -0,0 +1,237 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_int_compact.h>
+#include <asw/runtime/slc_int_list.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A compact list is frame-of-reference coded: each chunk of up to 128
+ * elements stores its smallest element, and every element as its offset
+ * from that in just enough bits for the largest offset. A sorted list
+ * with small gaps packs into a handful of bits per element, and any
+ * element is still a single load and shift, so car and cdr stay O(1).
+ *
+ * Offsets are packed back to back, little-endian, and read with one
+ * unaligned 8-byte load. Widths over 56 bits could straddle that load,
+ * so they are rounded up to 64. Each chunk is padded by a word so the
+ * load never runs off the end.
+ *
+ * All chunks of a list are laid out back to back in one allocation and
+ * each knows how many elements remain from its start, so there is no
+ * next pointer and length is O(1). Like list<bool>, a list value is the
+ * address of its chunk with the index of the head in the top 16 bits,
+ * plus the tag in the low bit. If the allocation would reach into those
+ * bits the list is left as it is.
+ */
+_Static_assert(sizeof(void *) == 8, "compact lists pack an index into pointer bits");
+_Static_assert(
+  __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "compact lists are packed little-endian");
+
+#define SLC_INT_COMPACT_INDEX_SHIFT 48
+#define SLC_INT_COMPACT_CHUNK_MASK \
+  (((UINT64_C(1) << SLC_INT_COMPACT_INDEX_SHIFT) - 1) & ~(uint64_t)SLC_INT_COMPACT_TAG)
+/* the first chunk of an allocation, destroy frees the whole list from it */
+#define SLC_INT_COMPACT_BLOCK_HEAD 0x1
+
+struct slc_int_compact_chunk
+{
+  /* elements from the start of this chunk to the end of the list */
+  int64_t remaining;
+  /* frame of reference, the smallest element */
+  int64_t ref;
+  uint16_t count;
+  uint8_t width;
+  uint8_t flags;
+  /* size of data */
+  uint32_t words;
+  uint64_t data[];
+};
+
+static inline struct slc_int_compact_chunk * _chunk_of(struct slc_int_list * list)
+{
+  return (struct slc_int_compact_chunk *)((uintptr_t)list & SLC_INT_COMPACT_CHUNK_MASK);
+}
+
+static inline uint32_t _index_of(struct slc_int_list * list)
+{
+  return (uintptr_t)list >> SLC_INT_COMPACT_INDEX_SHIFT;
+}
+
+static inline struct slc_int_list * _list_at(struct slc_int_compact_chunk * chunk, uint32_t index)
+{
+  return (struct slc_int_list *)((uintptr_t)chunk |
+         ((uintptr_t)index << SLC_INT_COMPACT_INDEX_SHIFT) | SLC_INT_COMPACT_TAG);
+}
+
+static inline struct slc_int_compact_chunk * _next_chunk(struct slc_int_compact_chunk * chunk)
+{
+  if (chunk->remaining == chunk->count) {
+    return NULL;
+  }
+  return (struct slc_int_compact_chunk *)&chunk->data[chunk->words];
+}
+
+static inline uint64_t _mask_of(uint8_t width)
+{
+  return (width == 64) ? ~UINT64_C(0) : (UINT64_C(1) << width) - 1;
+}
+
+static inline uint64_t _get(const struct slc_int_compact_chunk * chunk, uint32_t index)
+{
+  size_t bit = (size_t)index * chunk->width;
+  uint64_t word;
+  memcpy(&word, (const char *)chunk->data + (bit >> 3), sizeof(word));
+  return (word >> (bit & 7)) & _mask_of(chunk->width);
+}
+
+static inline void _put(struct slc_int_compact_chunk * chunk, uint32_t index, uint64_t val)
+{
+  size_t bit = (size_t)index * chunk->width;
+  uint64_t word;
+  memcpy(&word, (char *)chunk->data + (bit >> 3), sizeof(word));
+  word |= val << (bit & 7);
+  memcpy((char *)chunk->data + (bit >> 3), &word, sizeof(word));
+}
+
+/* bits needed for every offset in vals[0, n) from their minimum */
+static uint8_t _width_of(const int64_t * vals, size_t n, int64_t * ref)
+{
+  int64_t min = vals[0], max = vals[0];
+  for (size_t x = 1; x < n; ++x) {
+    min = (vals[x] < min) ? vals[x] : min;
+    max = (vals[x] > max) ? vals[x] : max;
+  }
+  *ref = min;
+  uint64_t range = (uint64_t)max - (uint64_t)min;
+  uint8_t width = (0 == range) ? 0 : 64 - __builtin_clzll(range);
+  return (width > 56) ? 64 : width;
+}
+
+static inline uint32_t _words_for(size_t count, uint8_t width)
+{
+  /* one word of padding for the unaligned loads */
+  return (count * width + 63) / 64 + 1;
+}
+
+int64_t slc_int_compact_head(struct slc_int_list * list)
+{
+  struct slc_int_compact_chunk * chunk = _chunk_of(list);
+  return (int64_t)((uint64_t)chunk->ref + _get(chunk, _index_of(list)));
+}
+
+struct slc_int_list * slc_int_compact_cdr(struct slc_int_list * list)
+{
+  struct slc_int_compact_chunk * chunk = _chunk_of(list);
+  uint32_t index = _index_of(list) + 1;
+  if (index < chunk->count) {
+    return _list_at(chunk, index);
+  }
+  chunk = _next_chunk(chunk);
+  return (NULL == chunk) ? NULL : _list_at(chunk, 0);
+}
+
+int64_t slc_int_compact_length(struct slc_int_list * list)
+{
+  return _chunk_of(list)->remaining - _index_of(list);
+}
+
+struct slc_int_list * slc_int_compact_drop(struct slc_int_list * list, int64_t n)
+{
+  if (n >= slc_int_compact_length(list)) {
+    return NULL;
+  }
+  /* skip whole chunks, they know their own sizes */
+  struct slc_int_compact_chunk * chunk = _chunk_of(list);
+  n += _index_of(list);
+  for (; n >= chunk->count; chunk = _next_chunk(chunk)) {
+    n -= chunk->count;
+  }
+  return _list_at(chunk, n);
+}
+
+int8_t slc_int_compact_destroy(struct slc_int_list * list)
+{
+  struct slc_int_compact_chunk * chunk = _chunk_of(list);
+  if (0 != _index_of(list) || !(chunk->flags & SLC_INT_COMPACT_BLOCK_HEAD)) {
+    /* a tail of a compact list, it is released with the whole list */
+    return 0;
+  }
+  free(chunk);
+  return 1;
+}
+
+size_t slc_int_compact_decode(
+  struct slc_int_list * list, int64_t * out, struct slc_int_list ** next)
+{
+  struct slc_int_compact_chunk * chunk = _chunk_of(list);
+  uint32_t index = _index_of(list);
+  size_t n = chunk->count - index;
+  for (size_t x = 0; x < n; ++x) {
+    out[x] = (int64_t)((uint64_t)chunk->ref + _get(chunk, index + x));
+  }
+  struct slc_int_compact_chunk * after = _next_chunk(chunk);
+  *next = (NULL == after) ? NULL : _list_at(after, 0);
+  return n;
+}
+
+struct slc_int_list * slc_int_list_compact(struct slc_int_list * list)
+{
+  if (NULL == list || slc_int_compact_is(list)) {
+    return list;
+  }
+  size_t n = slc_int_list_length(list);
+  /* compacting is only an optimization, on any failure the list stays as it is */
+  int64_t * vals = malloc(n * sizeof(int64_t));
+  if (NULL == vals) {
+    return list;
+  }
+  slc_int_list_to_array(list, vals);
+  /* size every chunk first, so the list is one allocation */
+  size_t bytes = 0;
+  for (size_t x = 0; x < n; x += SLC_INT_COMPACT_RUN) {
+    size_t count = (n - x < SLC_INT_COMPACT_RUN) ? n - x : SLC_INT_COMPACT_RUN;
+    int64_t ref;
+    bytes += sizeof(struct slc_int_compact_chunk) +
+      _words_for(count, _width_of(&vals[x], count, &ref)) * sizeof(uint64_t);
+  }
+  struct slc_int_compact_chunk * head = calloc(1, bytes);
+  if (NULL == head) {
+    free(vals);
+    return list;
+  }
+  /* the top bits carry the index, see asw/runtime/slc_int_compact.h */
+  if (0 != (((uintptr_t)head + bytes - 1) >> SLC_INT_COMPACT_INDEX_SHIFT)) {
+    free(head);
+    free(vals);
+    return list;
+  }
+  struct slc_int_compact_chunk * chunk = head;
+  for (size_t x = 0; x < n; x += SLC_INT_COMPACT_RUN) {
+    size_t count = (n - x < SLC_INT_COMPACT_RUN) ? n - x : SLC_INT_COMPACT_RUN;
+    chunk->remaining = n - x;
+    chunk->count = count;
+    chunk->width = _width_of(&vals[x], count, &chunk->ref);
+    chunk->flags = (chunk == head) ? SLC_INT_COMPACT_BLOCK_HEAD : 0;
+    chunk->words = _words_for(count, chunk->width);
+    for (size_t y = 0; y < count; ++y) {
+      _put(chunk, y, (uint64_t)vals[x + y] - (uint64_t)chunk->ref);
+    }
+    chunk = (struct slc_int_compact_chunk *)&chunk->data[chunk->words];
+  }
+  free(vals);
+  return _list_at(head, 0);
+}
@@ -12,167 +12,33 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <asw/runtime/slc_int_compact.h>
 #include <asw/runtime/slc_int_list.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <string.h>
 
-struct slc_int_list
-{
-  int64_t head;
-  struct slc_int_list * tail;
-};
-
-struct slc_int_list * slc_int_list_create()
-{
-  struct slc_int_list * ret = malloc(sizeof(*ret));
-  return ret;
-}
+#define SLC_LIST_NAME int
+#define SLC_LIST_NUMERIC
+#define SLC_LIST_COMPACT
+#define SLC_LIST_COMPACT_RUN SLC_INT_COMPACT_RUN
+#include "slc_list_impl.h"
 
-int8_t slc_int_list_destroy(struct slc_int_list * list)
+struct slc_int_list * slc_int_list_range(int64_t a, int64_t b)
 {
-  if (NULL == list) {
-    return 0;
+  if (b < a) {
+    return NULL;
   }
-  free(list);
-  return 1;
-}
-
-int8_t slc_int_list_init(struct slc_int_list * list)
-{
-  list->head = 0;
-  list->tail = NULL;
-  return 1;
-}
-
-int8_t slc_int_list_fini(struct slc_int_list * list)
-{
-  struct slc_int_list ** tail = &list->tail;
-  for (; (*tail)->tail != NULL; tail = &(*tail)->tail) {
-    if (!slc_int_list_destroy(*tail)) {
-      return 0;
+  struct slc_int_list * ret = slc_int_list_reserve(b - a + 1);
+  for (struct slc_int_list * list = ret, * end, * next; NULL != list; list = next) {
+    next = _slc_int_list_span(list, &end);
+    for (; list != end; ++list) {
+      list->head = a++;
     }
   }
-  return 1;
-}
-
-int8_t slc_int_list_set_head(struct slc_int_list * list, int64_t val)
-{
-  if (NULL == list) {
-    return 0;
-  }
-  list->head = val;
-  return 1;
-}
-
-int8_t slc_int_list_set_tail(struct slc_int_list * list, struct slc_int_list * tail)
-{
-  if (NULL == list) {
-    return 0;
-  }
-  list->tail = tail;
-  return 1;
-}
-
-struct slc_int_list * slc_int_list_cons(int64_t head, struct slc_int_list * tail)
-{
-  struct slc_int_list * ret = slc_int_list_create();
-  if (!slc_int_list_init(ret)) {
-    return NULL;
-  }
-  ret->head = head;
-  ret->tail = tail;
   return ret;
 }
 
-struct slc_int_list * slc_int_list_append(struct slc_int_list * list, int64_t val)
-{
-  if (NULL == list) {
-    list = slc_int_list_create();
-    list->head = val;
-    list->tail = NULL;
-    return list;
-  }
-  struct slc_int_list * iter = list;
-  for (; iter->tail != NULL; iter = iter->tail) {
-    /* go to the end of the list */
-  }
-  iter->tail = slc_int_list_create();
-  slc_int_list_init(iter->tail);
-  iter->tail->head = val;
-  return list;
-}
-
-int64_t * slc_int_list_car(struct slc_int_list * list)
-{
-  if (list) {
-    return &list->head;
-  }
-  return NULL;
-}
-
-struct slc_int_list * slc_int_list_cdr(struct slc_int_list * list)
-{
-  if (list) {
-    return list->tail;
-  }
-  return NULL;
-}
-
-int64_t slc_int_list_add(struct slc_int_list * list)
-{
-  if (NULL == list) {
-    return 0;
-  }
-  struct slc_int_list ** tail = &list->tail;
-  int64_t sum = list->head;
-  for (; *tail != NULL; tail = &(*tail)->tail) {
-    sum += (*tail)->head;
-  }
-  return sum;
-}
-
-int64_t slc_int_list_subtract(struct slc_int_list * list)
-{
-  if (NULL == list) {
-    return 0;
-  }
-  struct slc_int_list ** tail = &list->tail;
-  int64_t diff = list->head;
-  for (; *tail != NULL; tail = &(*tail)->tail) {
-    diff -= (*tail)->head;
-  }
-  return diff;
-}
-
-int64_t slc_int_list_multiply(struct slc_int_list * list)
-{
-  if (NULL == list) {
-    return 0;
-  }
-  struct slc_int_list ** tail = &list->tail;
-  int64_t prod = list->head;
-  for (; *tail != NULL; tail = &(*tail)->tail) {
-    prod *= (*tail)->head;
-  }
-  return prod;
-}
-
-int64_t slc_int_list_divide(struct slc_int_list * list)
-{
-  if (NULL == list) {
-    /* this is probably correct most of the time anyway */
-    return 0;
-  }
-  struct slc_int_list ** tail = &list->tail;
-  int64_t div = list->head;
-  for (; *tail != NULL; tail = &(*tail)->tail) {
-    div /= (*tail)->head;
-  }
-  return div;
-}
-
 int64_t print_int(int64_t i)
 {
   return printf("%ld\n", i);
@@ -205,10 +71,14 @@ int8_t print_slc_int_list(struct slc_int_list * l)
   if (NULL == l) {
     return 0;
   }
+  int64_t buf[SLC_INT_COMPACT_RUN];
   printf("(");
-  struct slc_int_list * iter = l;
-  for (; iter != NULL; iter = iter->tail) {
-    printf(" %ld", iter->head);
+  for (struct slc_int_list * next; NULL != l; l = next) {
+    size_t n;
+    const int64_t * run = _slc_int_list_run(l, &n, &next, buf);
+    for (size_t x = 0; x < n; ++x) {
+      printf(" %ld", run[x]);
+    }
   }
   printf(" )\n");
   return 1;
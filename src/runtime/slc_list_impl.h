@@ -0,0 +1,730 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Defines the list runtime for one element type. Include it once per
+ * element type, after the matching public header, with the same
+ * SLC_LIST_NAME and SLC_LIST_NUMERIC that the header was declared with
+ * (see asw/runtime/slc_list.h), the element type comes from the header.
+ * The SLC_LIST_NUMERIC reductions use the slc_reduce_<name>_* kernels.
+ *
+ * Lists are stored unrolled: elements live in fixed-size, aligned chunks
+ * and a list value is a pointer to its head element inside a chunk. The
+ * chunk header is recovered by masking the pointer, so car is a load and
+ * cdr is an increment until the end of the chunk is reached.
+ *
+ * Chunks fill downward from the top when built with cons, so consing
+ * onto the first live element of a chunk claims the free slot below it
+ * rather than allocating. Elements are never moved or overwritten by
+ * cons, which keeps lists persistent.
+ *
+ * Every element also has a position: chunk->base + its index. Positions
+ * increase by one along a list and are assigned relative to the tail, so
+ * lists sharing a tail agree on them. The length of a list is the end
+ * position of its last chunk minus the position of its head, and each
+ * chunk keeps a hint to the last chunk reachable from it so that length
+ * and append don't walk the list.
+ *
+ * With SLC_LIST_COMPACT defined, a list can also be a compact one, told
+ * apart by its low bit and handled by slc_<name>_compact_* (see
+ * asw/runtime/slc_int_compact.h and asw/runtime/slc_string_argv.h), which
+ * decode at most SLC_LIST_COMPACT_RUN elements at a time. A regular chunk
+ * may have a compact list as its tail, so every walk stops or hands off
+ * when it reaches one.
+ */
+#ifndef ASW__SLC__RUNTIME__SLC_LIST_H_
+#error "include the public header for the list type before slc_list_impl.h"
+#endif
+
+#include <asw/runtime/slc_reduce.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ASW__SLC__RUNTIME__SLC_LIST_IMPL_H_
+#define ASW__SLC__RUNTIME__SLC_LIST_IMPL_H_
+#define SLC_LIST_CHUNK_BYTES 256
+#define SLC_LIST_CHUNK_SHARED_BLOCK 0x1
+#endif  /* ASW__SLC__RUNTIME__SLC_LIST_IMPL_H_ */
+
+#define SLC_LIST SLC_LIST_CAT(slc_, SLC_LIST_NAME, _list)
+#define SLC_LIST_CHUNK SLC_LIST_CAT(slc_, SLC_LIST_NAME, _list_chunk)
+#define SLC_LIST_FN(fn) SLC_LIST_CAT(SLC_LIST, _, fn)
+#define SLC_LIST_ELEM SLC_LIST_CAT(slc_, SLC_LIST_NAME, _list_elem)
+/* file-local helpers, named per element type so instantiations can share a file */
+#define SLC_LIST_(fn) SLC_LIST_CAT(_, SLC_LIST, _ ## fn)
+#define SLC_LIST_REDUCE(fn) SLC_LIST_CAT(slc_reduce_, SLC_LIST_NAME, _ ## fn)
+#ifdef SLC_LIST_COMPACT
+#define SLC_LIST_COMPACT_FN(fn) SLC_LIST_CAT(slc_, SLC_LIST_NAME, _compact_ ## fn)
+#define SLC_LIST_IS_COMPACT(list) SLC_LIST_COMPACT_FN(is)(list)
+/* elements of a decoded compact chunk, set by the instantiation */
+#define SLC_LIST_RUN SLC_LIST_COMPACT_RUN
+#else
+#define SLC_LIST_IS_COMPACT(list) 0
+#define SLC_LIST_RUN 1
+#endif
+
+struct SLC_LIST
+{
+  SLC_LIST_ELEM head;
+};
+
+struct SLC_LIST_CHUNK
+{
+  /* list that follows the last live element of this chunk */
+  struct SLC_LIST * next;
+  /* hint to the last chunk reachable from this one */
+  struct SLC_LIST_CHUNK * last;
+  /* position of cells[0] */
+  int64_t base;
+  /* live elements are [first, end) */
+  uint16_t first;
+  uint16_t end;
+  uint16_t flags;
+  struct SLC_LIST cells[];
+};
+
+#define SLC_LIST_CAP \
+  ((SLC_LIST_CHUNK_BYTES - sizeof(struct SLC_LIST_CHUNK)) / sizeof(struct SLC_LIST))
+
+static inline struct SLC_LIST_CHUNK * SLC_LIST_(chunk_of)(struct SLC_LIST * list)
+{
+  return (struct SLC_LIST_CHUNK *)((uintptr_t)list & ~(uintptr_t)(SLC_LIST_CHUNK_BYTES - 1));
+}
+
+/* find the last chunk reachable from chunk, refreshing its hint */
+static struct SLC_LIST_CHUNK * SLC_LIST_(last_chunk)(struct SLC_LIST_CHUNK * chunk)
+{
+  struct SLC_LIST_CHUNK * last = chunk->last;
+  while (NULL != last->next && !SLC_LIST_IS_COMPACT(last->next)) {
+    last = SLC_LIST_(chunk_of)(last->next)->last;
+  }
+  chunk->last = last;
+  return last;
+}
+
+static inline int64_t SLC_LIST_(position)(struct SLC_LIST * list)
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  return chunk->base + (list - chunk->cells);
+}
+
+/* return the list after this chunk, and set *end to the end of the run starting at list */
+static inline struct SLC_LIST * SLC_LIST_(span)(struct SLC_LIST * list, struct SLC_LIST ** end)
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  *end = &chunk->cells[chunk->end];
+  return chunk->next;
+}
+
+/**
+ * return the elements from list to the end of its chunk, set *n to how many
+ * there are and *next to the list after them. a compact chunk is decoded
+ * into buf, which holds SLC_LIST_RUN elements.
+ */
+static inline const SLC_LIST_ELEM * SLC_LIST_(run)(
+  struct SLC_LIST * list, size_t * n, struct SLC_LIST ** next, SLC_LIST_ELEM * buf)
+{
+#ifdef SLC_LIST_COMPACT
+  if (SLC_LIST_IS_COMPACT(list)) {
+    *n = SLC_LIST_COMPACT_FN(decode)(list, buf, next);
+    return buf;
+  }
+#else
+  (void)buf;
+#endif
+  struct SLC_LIST * end;
+  *next = SLC_LIST_(span)(list, &end);
+  *n = end - list;
+  return &list->head;
+}
+
+/* start pulling in the chunk holding list while the current one is reduced */
+static inline void SLC_LIST_(prefetch)(struct SLC_LIST * list)
+{
+  if (NULL == list || SLC_LIST_IS_COMPACT(list)) {
+    return;
+  }
+  const char * chunk = (const char *)SLC_LIST_(chunk_of)(list);
+  for (size_t x = 0; x < SLC_LIST_CHUNK_BYTES; x += 64) {
+    __builtin_prefetch(chunk + x);
+  }
+}
+
+static struct SLC_LIST_CHUNK * SLC_LIST_(chunk_create)(size_t count)
+{
+  struct SLC_LIST_CHUNK * chunks = aligned_alloc(SLC_LIST_CHUNK_BYTES, count * SLC_LIST_CHUNK_BYTES);
+  if (NULL == chunks) {
+    return NULL;
+  }
+  for (size_t x = 0; x < count; ++x) {
+    struct SLC_LIST_CHUNK * chunk =
+      (struct SLC_LIST_CHUNK *)((char *)chunks + x * SLC_LIST_CHUNK_BYTES);
+    chunk->next = NULL;
+    chunk->last = chunk;
+    chunk->base = 0;
+    chunk->first = chunk->end = 0;
+    chunk->flags = (count > 1) ? SLC_LIST_CHUNK_SHARED_BLOCK : 0;
+  }
+  return chunks;
+}
+
+/* make tail follow the end of chunk */
+static void SLC_LIST_(link)(struct SLC_LIST_CHUNK * chunk, struct SLC_LIST * tail)
+{
+  chunk->next = tail;
+  chunk->last = chunk;
+  if (NULL == tail) {
+    return;
+  } else if (SLC_LIST_IS_COMPACT(tail)) {
+    /* a compact tail keeps its own positions, the chunk before it ends at 0 */
+    chunk->base = -(int64_t)chunk->end;
+    return;
+  }
+  chunk->base = SLC_LIST_(position)(tail) - chunk->end;
+  chunk->last = SLC_LIST_(last_chunk)(SLC_LIST_(chunk_of)(tail));
+}
+
+struct SLC_LIST * SLC_LIST_FN(create)()
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_create)(1);
+  if (NULL == chunk) {
+    return NULL;
+  }
+  /* start at the top so later conses can fill in below */
+  chunk->first = SLC_LIST_CAP - 1;
+  chunk->end = SLC_LIST_CAP;
+  return &chunk->cells[chunk->first];
+}
+
+int8_t SLC_LIST_FN(destroy)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+#ifdef SLC_LIST_COMPACT
+  if (SLC_LIST_IS_COMPACT(list)) {
+    return SLC_LIST_COMPACT_FN(destroy)(list);
+  }
+#endif
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  if (chunk->flags & SLC_LIST_CHUNK_SHARED_BLOCK) {
+    /* part of a bulk allocation, can't be released on its own */
+    return 0;
+  }
+  free(chunk);
+  return 1;
+}
+
+int8_t SLC_LIST_FN(init)(struct SLC_LIST * list)
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  memset(&list->head, 0, sizeof(list->head));
+  chunk->end = list - chunk->cells + 1;
+  chunk->next = NULL;
+  chunk->last = chunk;
+  return 1;
+}
+
+int8_t SLC_LIST_FN(fini)(struct SLC_LIST * list)
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  struct SLC_LIST * tail = chunk->next;
+  chunk->next = NULL;
+  chunk->last = chunk;
+  chunk->end = list - chunk->cells + 1;
+  while (NULL != tail) {
+    if (SLC_LIST_IS_COMPACT(tail)) {
+      /* one allocation holds all of it */
+      SLC_LIST_FN(destroy)(tail);
+      break;
+    }
+    struct SLC_LIST * end;
+    struct SLC_LIST * next = SLC_LIST_(span)(tail, &end);
+    SLC_LIST_FN(destroy)(tail);
+    tail = next;
+  }
+  return 1;
+}
+
+int8_t SLC_LIST_FN(set_head)(struct SLC_LIST * list, SLC_LIST_ELEM val)
+{
+  if (NULL == list || SLC_LIST_IS_COMPACT(list)) {
+    return 0;
+  }
+  list->head = val;
+  return 1;
+}
+
+struct SLC_LIST * SLC_LIST_FN(cons)(SLC_LIST_ELEM head, struct SLC_LIST * tail)
+{
+  if (NULL != tail && !SLC_LIST_IS_COMPACT(tail)) {
+    struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(tail);
+    if (tail == &chunk->cells[chunk->first] && chunk->first > 0) {
+      /* the slot below the head is unclaimed, use it */
+      struct SLC_LIST * ret = &chunk->cells[--chunk->first];
+      ret->head = head;
+      return ret;
+    }
+  }
+  struct SLC_LIST * ret = SLC_LIST_FN(create)();
+  if (NULL == ret) {
+    return NULL;
+  }
+  ret->head = head;
+  SLC_LIST_(link)(SLC_LIST_(chunk_of)(ret), tail);
+  return ret;
+}
+
+struct SLC_LIST * SLC_LIST_FN(append)(struct SLC_LIST * list, SLC_LIST_ELEM val)
+{
+  struct SLC_LIST_CHUNK * last = NULL;
+  if (NULL != list) {
+    if (SLC_LIST_IS_COMPACT(list)) {
+      return NULL;
+    }
+    last = SLC_LIST_(last_chunk)(SLC_LIST_(chunk_of)(list));
+    if (NULL != last->next) {
+      /* ends in a compact list, which can't grow */
+      return NULL;
+    }
+    if (last->end < SLC_LIST_CAP) {
+      last->cells[last->end++].head = val;
+      return list;
+    }
+  }
+  /* start a new chunk that fills upward */
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_create)(1);
+  if (NULL == chunk) {
+    return NULL;
+  }
+  chunk->cells[0].head = val;
+  chunk->end = 1;
+  if (NULL == last) {
+    return &chunk->cells[0];
+  }
+  chunk->base = last->base + last->end;
+  last->next = &chunk->cells[0];
+  last->last = chunk;
+  SLC_LIST_(chunk_of)(list)->last = chunk;
+  return list;
+}
+
+struct SLC_LIST * SLC_LIST_FN(reserve)(size_t n)
+{
+  if (0 == n) {
+    return NULL;
+  }
+  /* allocate every chunk in one block, in list order */
+  size_t count = (n + SLC_LIST_CAP - 1) / SLC_LIST_CAP;
+  struct SLC_LIST_CHUNK * chunks = SLC_LIST_(chunk_create)(count);
+  if (NULL == chunks) {
+    return NULL;
+  }
+  struct SLC_LIST_CHUNK * last =
+    (struct SLC_LIST_CHUNK *)((char *)chunks + (count - 1) * SLC_LIST_CHUNK_BYTES);
+  /* the head chunk takes the remainder, top-aligned so cons can extend it */
+  size_t remainder = n - (count - 1) * SLC_LIST_CAP;
+  chunks->first = SLC_LIST_CAP - remainder;
+  struct SLC_LIST_CHUNK * chunk = chunks;
+  for (size_t x = 0; x < count; ++x) {
+    chunk->end = SLC_LIST_CAP;
+    chunk->last = last;
+    chunk->base = x * SLC_LIST_CAP;
+    memset(&chunk->cells[chunk->first], 0, (chunk->end - chunk->first) * sizeof(chunk->cells[0]));
+    if (chunk != last) {
+      struct SLC_LIST_CHUNK * next =
+        (struct SLC_LIST_CHUNK *)((char *)chunk + SLC_LIST_CHUNK_BYTES);
+      chunk->next = &next->cells[0];
+      chunk = next;
+    }
+  }
+  return &chunks->cells[chunks->first];
+}
+
+struct SLC_LIST * SLC_LIST_FN(from_array)(const SLC_LIST_ELEM * vals, size_t n)
+{
+  struct SLC_LIST * ret = SLC_LIST_FN(reserve)(n);
+  for (struct SLC_LIST * list = ret, * end, * next; NULL != list; list = next) {
+    next = SLC_LIST_(span)(list, &end);
+    /* each run of a chunk is contiguous */
+    memcpy(list, vals, (end - list) * sizeof(SLC_LIST_ELEM));
+    vals += end - list;
+  }
+  return ret;
+}
+
+const SLC_LIST_ELEM * SLC_LIST_FN(run)(
+  struct SLC_LIST * list, int64_t * n, struct SLC_LIST ** next, SLC_LIST_ELEM * buf)
+{
+  _Static_assert(SLC_LIST_RUN <= SLC_LIST_RUN_MAX, "a decoded run must fit the caller's buffer");
+  size_t count;
+  const SLC_LIST_ELEM * ret = SLC_LIST_(run)(list, &count, next, buf);
+  *n = count;
+  return ret;
+}
+
+size_t SLC_LIST_FN(to_array)(struct SLC_LIST * list, SLC_LIST_ELEM * out)
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  size_t n = 0;
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t count;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &count, &next, buf);
+    memcpy(out + n, run, count * sizeof(SLC_LIST_ELEM));
+    n += count;
+  }
+  return n;
+}
+
+int64_t SLC_LIST_FN(length)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+#ifdef SLC_LIST_COMPACT
+  if (SLC_LIST_IS_COMPACT(list)) {
+    return SLC_LIST_COMPACT_FN(length)(list);
+  }
+#endif
+  struct SLC_LIST_CHUNK * last = SLC_LIST_(last_chunk)(SLC_LIST_(chunk_of)(list));
+  int64_t length = last->base + last->end - SLC_LIST_(position)(list);
+#ifdef SLC_LIST_COMPACT
+  if (NULL != last->next) {
+    length += SLC_LIST_COMPACT_FN(length)(last->next);
+  }
+#endif
+  return length;
+}
+
+SLC_LIST_ELEM * SLC_LIST_FN(car)(struct SLC_LIST * list)
+{
+  /* compact elements are decoded on read and have no address */
+  if (list && !SLC_LIST_IS_COMPACT(list)) {
+    return &list->head;
+  }
+  return NULL;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(head)(struct SLC_LIST * list)
+{
+#ifdef SLC_LIST_COMPACT
+  if (SLC_LIST_IS_COMPACT(list)) {
+    return SLC_LIST_COMPACT_FN(head)(list);
+  }
+#endif
+  if (list) {
+    return list->head;
+  }
+  return 0;
+}
+
+struct SLC_LIST * SLC_LIST_FN(cdr)(struct SLC_LIST * list)
+{
+#ifdef SLC_LIST_COMPACT
+  if (SLC_LIST_IS_COMPACT(list)) {
+    return SLC_LIST_COMPACT_FN(cdr)(list);
+  }
+#endif
+  if (list) {
+    struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+    if (++list != &chunk->cells[chunk->end]) {
+      return list;
+    }
+    return chunk->next;
+  }
+  return NULL;
+}
+
+/* the list after the first n elements of list, which shares them */
+static struct SLC_LIST * SLC_LIST_(advance)(struct SLC_LIST * list, int64_t n)
+{
+  for (struct SLC_LIST * end, * next; NULL != list && n > 0; list = next) {
+#ifdef SLC_LIST_COMPACT
+    if (SLC_LIST_IS_COMPACT(list)) {
+      return SLC_LIST_COMPACT_FN(drop)(list, n);
+    }
+#endif
+    /* skip whole chunks */
+    next = SLC_LIST_(span)(list, &end);
+    if (n < end - list) {
+      return list + n;
+    }
+    n -= end - list;
+  }
+  return list;
+}
+
+/* element x of a list made by reserve, which lays its chunks out in order */
+static inline struct SLC_LIST * SLC_LIST_(reserved_at)(struct SLC_LIST * list, size_t x)
+{
+  struct SLC_LIST_CHUNK * chunk = SLC_LIST_(chunk_of)(list);
+  x += list - chunk->cells;
+  chunk = (struct SLC_LIST_CHUNK *)((char *)chunk + (x / SLC_LIST_CAP) * SLC_LIST_CHUNK_BYTES);
+  return &chunk->cells[x % SLC_LIST_CAP];
+}
+
+/* copy the first n elements of src into dst, a list made by reserve */
+static void SLC_LIST_(copy)(struct SLC_LIST * dst, struct SLC_LIST * src, size_t n)
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  struct SLC_LIST * dst_end;
+  struct SLC_LIST * dst_next = SLC_LIST_(span)(dst, &dst_end);
+  for (struct SLC_LIST * next; n > 0; src = next) {
+    size_t count;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(src, &count, &next, buf);
+    count = (count < n) ? count : n;
+    n -= count;
+    /* a run of src may cover the end of a chunk of dst, or the other way around */
+    while (count > 0) {
+      if (dst == dst_end) {
+        dst = dst_next;
+        dst_next = SLC_LIST_(span)(dst, &dst_end);
+      }
+      size_t copied = ((size_t)(dst_end - dst) < count) ? (size_t)(dst_end - dst) : count;
+      memcpy(dst, run, copied * sizeof(SLC_LIST_ELEM));
+      dst += copied;
+      run += copied;
+      count -= copied;
+    }
+  }
+}
+
+struct SLC_LIST * SLC_LIST_FN(reverse)(struct SLC_LIST * list)
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  size_t x = SLC_LIST_FN(length)(list);
+  struct SLC_LIST * ret = SLC_LIST_FN(reserve)(x);
+  /* fill the copy from the back */
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    for (size_t y = 0; y < n; ++y) {
+      SLC_LIST_(reserved_at)(ret, --x)->head = run[y];
+    }
+  }
+  return ret;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(nth)(struct SLC_LIST * list, int64_t n)
+{
+  if (n < 0) {
+    return 0;
+  }
+  return SLC_LIST_FN(head)(SLC_LIST_(advance)(list, n));
+}
+
+struct SLC_LIST * SLC_LIST_FN(take)(struct SLC_LIST * list, int64_t n)
+{
+  int64_t length = SLC_LIST_FN(length)(list);
+  n = (n < length) ? n : length;
+  if (n <= 0) {
+    return NULL;
+  }
+  struct SLC_LIST * ret = SLC_LIST_FN(reserve)(n);
+  if (NULL != ret) {
+    SLC_LIST_(copy)(ret, list, n);
+  }
+  return ret;
+}
+
+struct SLC_LIST * SLC_LIST_FN(drop)(struct SLC_LIST * list, int64_t n)
+{
+  return SLC_LIST_(advance)(list, n);
+}
+
+struct SLC_LIST * SLC_LIST_FN(concat)(struct SLC_LIST * a, struct SLC_LIST * b)
+{
+  /* a is copied, b is shared */
+  struct SLC_LIST * ret = SLC_LIST_FN(take)(a, SLC_LIST_FN(length)(a));
+  if (NULL == ret) {
+    return b;
+  }
+  /* the copy is one block of chunks, shift its positions so that it ends where b starts */
+  struct SLC_LIST_CHUNK * first = SLC_LIST_(chunk_of)(ret);
+  struct SLC_LIST_CHUNK * last = first->last;
+  const int64_t start = (NULL == b || SLC_LIST_IS_COMPACT(b)) ? 0 : SLC_LIST_(position)(b);
+  const int64_t shift = start - (last->base + last->end);
+  for (struct SLC_LIST_CHUNK * chunk = first; chunk != last;
+    chunk = (struct SLC_LIST_CHUNK *)((char *)chunk + SLC_LIST_CHUNK_BYTES))
+  {
+    chunk->base += shift;
+  }
+  last->base += shift;
+  last->next = b;
+  if (NULL != b && !SLC_LIST_IS_COMPACT(b)) {
+    last->last = SLC_LIST_(last_chunk)(SLC_LIST_(chunk_of)(b));
+  }
+  return ret;
+}
+
+struct SLC_LIST * SLC_LIST_FN(map)(
+  struct SLC_LIST * list, SLC_LIST_ELEM (* fn)(SLC_LIST_ELEM))
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  struct SLC_LIST * ret = SLC_LIST_FN(reserve)(SLC_LIST_FN(length)(list));
+  size_t x = 0;
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    for (size_t y = 0; y < n; ++y) {
+      SLC_LIST_(reserved_at)(ret, x++)->head = fn(run[y]);
+    }
+  }
+  return ret;
+}
+
+struct SLC_LIST * SLC_LIST_FN(filter)(
+  struct SLC_LIST * list, int8_t (* fn)(SLC_LIST_ELEM))
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  /* keep the matches in order, then copy them into a list of the right size */
+  SLC_LIST_ELEM * kept = malloc(SLC_LIST_FN(length)(list) * sizeof(SLC_LIST_ELEM));
+  if (NULL == kept) {
+    return NULL;
+  }
+  size_t x = 0;
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    for (size_t y = 0; y < n; ++y) {
+      if (fn(run[y])) {
+        kept[x++] = run[y];
+      }
+    }
+  }
+  struct SLC_LIST * ret = SLC_LIST_FN(from_array)(kept, x);
+  free(kept);
+  return ret;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(fold)(
+  struct SLC_LIST * list, SLC_LIST_ELEM (* fn)(SLC_LIST_ELEM, SLC_LIST_ELEM), SLC_LIST_ELEM acc)
+{
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    for (size_t y = 0; y < n; ++y) {
+      acc = fn(acc, run[y]);
+    }
+  }
+  return acc;
+}
+
+#ifdef SLC_LIST_NUMERIC
+SLC_LIST_ELEM SLC_LIST_FN(add)(struct SLC_LIST * list)
+{
+  SLC_LIST_ELEM sum = 0;
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    SLC_LIST_(prefetch)(next);
+    sum = SLC_LIST_REDUCE(sum)(run, n, sum);
+  }
+  return sum;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(subtract)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  /* a - b - c - ... == a - (b + c + ...) */
+  return SLC_LIST_FN(head)(list) - SLC_LIST_FN(add)(SLC_LIST_FN(cdr)(list));
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(multiply)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  SLC_LIST_ELEM prod = 1;
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    SLC_LIST_(prefetch)(next);
+    prod = SLC_LIST_REDUCE(prod)(run, n, prod);
+  }
+  return prod;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(divide)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    /* this is probably correct most of the time anyway */
+    return 0;
+  }
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  SLC_LIST_ELEM div = SLC_LIST_FN(head)(list);
+  list = SLC_LIST_FN(cdr)(list);
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    for (size_t x = 0; x < n; ++x) {
+      div /= run[x];
+    }
+  }
+  return div;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(min)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  SLC_LIST_ELEM min = SLC_LIST_FN(head)(list);
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    SLC_LIST_(prefetch)(next);
+    min = SLC_LIST_REDUCE(min)(run, n, min);
+  }
+  return min;
+}
+
+SLC_LIST_ELEM SLC_LIST_FN(max)(struct SLC_LIST * list)
+{
+  if (NULL == list) {
+    return 0;
+  }
+  SLC_LIST_ELEM max = SLC_LIST_FN(head)(list);
+  SLC_LIST_ELEM buf[SLC_LIST_RUN];
+  for (struct SLC_LIST * next; NULL != list; list = next) {
+    size_t n;
+    const SLC_LIST_ELEM * run = SLC_LIST_(run)(list, &n, &next, buf);
+    SLC_LIST_(prefetch)(next);
+    max = SLC_LIST_REDUCE(max)(run, n, max);
+  }
+  return max;
+}
+#endif  /* SLC_LIST_NUMERIC */
+
+#undef SLC_LIST_RUN
+#undef SLC_LIST_IS_COMPACT
+#undef SLC_LIST_COMPACT_FN
+#undef SLC_LIST_COMPACT_RUN
+#undef SLC_LIST_COMPACT
+#undef SLC_LIST_CAP
+#undef SLC_LIST_REDUCE
+#undef SLC_LIST_
+#undef SLC_LIST_ELEM
+#undef SLC_LIST_FN
+#undef SLC_LIST_CHUNK
+#undef SLC_LIST
+#undef SLC_LIST_NUMERIC
+#undef SLC_LIST_NAME
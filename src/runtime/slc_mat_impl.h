@@ -0,0 +1,273 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Defines the mat runtime for one numeric element type. Include it once
+ * per element type, after the public header, with these defined:
+ *
+ *   SLC_MAT_NAME  the same name the header was declared with
+ *   SLC_MAT_T     C type of an element
+ *   SLC_MAT_FMT   printf conversion for an element
+ *
+ * transpose and matmul work a tile at a time, so each tile of the inputs
+ * and the output stays in L1 while it is used. The innermost loops run
+ * along a row, which is contiguous, so they are auto-vectorized, and like
+ * the reductions they are cloned for the widest SIMD the machine has.
+ */
+#ifndef ASW__SLC__RUNTIME__SLC_MAT_H_
+#error "include the public header for the mat type before slc_mat_impl.h"
+#endif
+
+#include <asw/runtime/slc_ptr_list.h>
+#include <asw/runtime/slc_ptr_vec.h>
+#include <asw/runtime/slc_reduce.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slc_target.h"
+
+#ifndef SLC_MAT_TILE
+/* 32 x 32 doubles is 8 KiB, three tiles of it fit in a 32 KiB L1 */
+#define SLC_MAT_TILE 32
+#endif
+
+#define SLC_MAT SLC_MAT_CAT(slc_, SLC_MAT_NAME, _mat)
+#define SLC_MAT_FN(fn) SLC_MAT_CAT(SLC_MAT, _, fn)
+#define SLC_MAT_VEC SLC_MAT_CAT(slc_, SLC_MAT_NAME, _vec)
+#define SLC_MAT_VEC_FN(fn) SLC_MAT_CAT(SLC_MAT_VEC, _, fn)
+#define SLC_MAT_LIST_FN(fn) SLC_MAT_CAT(slc_, SLC_MAT_NAME, _list_ ## fn)
+#define SLC_MAT_REDUCE(fn) SLC_MAT_CAT(slc_reduce_, SLC_MAT_NAME, fn)
+
+struct SLC_MAT * SLC_MAT_FN(create)(int64_t rows, int64_t cols)
+{
+  struct SLC_MAT * mat = calloc(1, sizeof(struct SLC_MAT) + rows * cols * sizeof(SLC_MAT_T));
+  if (NULL == mat) {
+    return NULL;
+  }
+  mat->rows = rows;
+  mat->cols = cols;
+  mat->data = mat->storage;
+  return mat;
+}
+
+int8_t SLC_MAT_FN(destroy)(struct SLC_MAT * mat)
+{
+  if (NULL == mat) {
+    return 0;
+  }
+  free(mat);
+  return 1;
+}
+
+struct SLC_MAT_VEC * SLC_MAT_FN(row)(struct SLC_MAT * mat, int64_t x)
+{
+  struct SLC_MAT_VEC * view = malloc(sizeof(struct SLC_MAT_VEC));
+  if (NULL == view) {
+    return NULL;
+  }
+  view->len = mat->cols;
+  view->cap = 0;
+  view->data = mat->data + x * mat->cols;
+  return view;
+}
+
+struct SLC_MAT * SLC_MAT_FN(from_nested)(struct slc_ptr_list * list)
+{
+  int64_t cols = 0;
+  for (struct slc_ptr_list * iter = list; NULL != iter; iter = slc_ptr_list_cdr(iter)) {
+    int64_t len = SLC_MAT_LIST_FN(length)(slc_ptr_list_head(iter));
+    cols = (len > cols) ? len : cols;
+  }
+  struct SLC_MAT * mat = SLC_MAT_FN(create)(slc_ptr_list_length(list), cols);
+  if (NULL == mat) {
+    return NULL;
+  }
+  SLC_MAT_T * row = mat->data;
+  for (; NULL != list; list = slc_ptr_list_cdr(list), row += cols) {
+    SLC_MAT_LIST_FN(to_array)(slc_ptr_list_head(list), row);
+  }
+  return mat;
+}
+
+struct SLC_MAT * SLC_MAT_FN(from_rows)(struct slc_ptr_vec * vec)
+{
+  int64_t cols = 0;
+  for (int64_t x = 0; x < vec->len; ++x) {
+    cols = (vec->data[x].len > cols) ? vec->data[x].len : cols;
+  }
+  struct SLC_MAT * mat = SLC_MAT_FN(create)(vec->len, cols);
+  if (NULL == mat) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < vec->len; ++x) {
+    memcpy(&mat->data[x * cols], vec->data[x].data, vec->data[x].len * sizeof(SLC_MAT_T));
+  }
+  return mat;
+}
+
+struct slc_ptr_list * SLC_MAT_FN(to_nested)(struct SLC_MAT * mat)
+{
+  struct slc_ptr_list * ret = slc_ptr_list_reserve(mat->rows);
+  struct slc_ptr_list * iter = ret;
+  for (int64_t x = 0; x < mat->rows; ++x, iter = slc_ptr_list_cdr(iter)) {
+    slc_ptr_list_set_head(
+      iter, SLC_MAT_LIST_FN(from_array)(&mat->data[x * mat->cols], mat->cols));
+  }
+  return ret;
+}
+
+SLC_TARGET_CLONES
+struct SLC_MAT * SLC_MAT_FN(transpose)(struct SLC_MAT * mat)
+{
+  const int64_t rows = mat->rows, cols = mat->cols;
+  struct SLC_MAT * ret = SLC_MAT_FN(create)(cols, rows);
+  if (NULL == ret) {
+    return NULL;
+  }
+  const SLC_MAT_T * restrict in = mat->data;
+  SLC_MAT_T * restrict out = ret->data;
+  /* a tile is read along its rows and written along its columns, both stay in cache */
+  for (int64_t ib = 0; ib < rows; ib += SLC_MAT_TILE) {
+    const int64_t iend = (ib + SLC_MAT_TILE < rows) ? ib + SLC_MAT_TILE : rows;
+    for (int64_t jb = 0; jb < cols; jb += SLC_MAT_TILE) {
+      const int64_t jend = (jb + SLC_MAT_TILE < cols) ? jb + SLC_MAT_TILE : cols;
+      for (int64_t i = ib; i < iend; ++i) {
+        for (int64_t j = jb; j < jend; ++j) {
+          out[j * rows + i] = in[i * cols + j];
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+SLC_TARGET_CLONES
+struct SLC_MAT * SLC_MAT_FN(matmul)(struct SLC_MAT * a, struct SLC_MAT * b)
+{
+  if (a->cols != b->rows) {
+    return NULL;
+  }
+  const int64_t n = a->rows, k = a->cols, m = b->cols;
+  struct SLC_MAT * ret = SLC_MAT_FN(create)(n, m);
+  if (NULL == ret) {
+    return NULL;
+  }
+  const SLC_MAT_T * restrict lhs = a->data;
+  const SLC_MAT_T * restrict rhs = b->data;
+  SLC_MAT_T * restrict out = ret->data;
+  /* i-k-j order, an element of a scales a row of b into a row of the output */
+  for (int64_t ib = 0; ib < n; ib += SLC_MAT_TILE) {
+    const int64_t iend = (ib + SLC_MAT_TILE < n) ? ib + SLC_MAT_TILE : n;
+    for (int64_t pb = 0; pb < k; pb += SLC_MAT_TILE) {
+      const int64_t pend = (pb + SLC_MAT_TILE < k) ? pb + SLC_MAT_TILE : k;
+      for (int64_t jb = 0; jb < m; jb += SLC_MAT_TILE) {
+        const int64_t jend = (jb + SLC_MAT_TILE < m) ? jb + SLC_MAT_TILE : m;
+        for (int64_t i = ib; i < iend; ++i) {
+          SLC_MAT_T * restrict row = &out[i * m];
+          for (int64_t p = pb; p < pend; ++p) {
+            const SLC_MAT_T scale = lhs[i * k + p];
+            const SLC_MAT_T * restrict from = &rhs[p * m];
+            for (int64_t j = jb; j < jend; ++j) {
+              row[j] += scale * from[j];
+            }
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+struct SLC_MAT_VEC * SLC_MAT_FN(row_sums)(struct SLC_MAT * mat)
+{
+  struct SLC_MAT_VEC * ret = SLC_MAT_VEC_FN(create)(mat->rows);
+  if (NULL == ret) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < mat->rows; ++x) {
+    ret->data[x] = SLC_MAT_REDUCE(_sum)(&mat->data[x * mat->cols], mat->cols, 0);
+  }
+  return ret;
+}
+
+SLC_TARGET_CLONES
+struct SLC_MAT_VEC * SLC_MAT_FN(col_sums)(struct SLC_MAT * mat)
+{
+  struct SLC_MAT_VEC * ret = SLC_MAT_VEC_FN(create)(mat->cols);
+  if (NULL == ret) {
+    return NULL;
+  }
+  /* add whole rows into the sums, rather than walk down each column */
+  SLC_MAT_T * restrict sums = ret->data;
+  for (int64_t x = 0; x < mat->rows; ++x) {
+    const SLC_MAT_T * restrict row = &mat->data[x * mat->cols];
+    for (int64_t y = 0; y < mat->cols; ++y) {
+      sums[y] += row[y];
+    }
+  }
+  return ret;
+}
+
+SLC_MAT_T SLC_MAT_FN(add)(struct SLC_MAT * mat)
+{
+  return SLC_MAT_REDUCE(_sum)(mat->data, mat->rows * mat->cols, 0);
+}
+
+SLC_MAT_T SLC_MAT_FN(multiply)(struct SLC_MAT * mat)
+{
+  if (0 == mat->rows * mat->cols) {
+    return 0;
+  }
+  return SLC_MAT_REDUCE(_prod)(mat->data, mat->rows * mat->cols, 1);
+}
+
+SLC_MAT_T SLC_MAT_FN(min)(struct SLC_MAT * mat)
+{
+  if (0 == mat->rows * mat->cols) {
+    return 0;
+  }
+  return SLC_MAT_REDUCE(_min)(mat->data + 1, mat->rows * mat->cols - 1, mat->data[0]);
+}
+
+SLC_MAT_T SLC_MAT_FN(max)(struct SLC_MAT * mat)
+{
+  if (0 == mat->rows * mat->cols) {
+    return 0;
+  }
+  return SLC_MAT_REDUCE(_max)(mat->data + 1, mat->rows * mat->cols - 1, mat->data[0]);
+}
+
+int8_t SLC_MAT_CAT(print_, SLC_MAT, )(struct SLC_MAT * mat)
+{
+  for (int64_t x = 0; x < mat->rows; ++x) {
+    printf("[");
+    for (int64_t y = 0; y < mat->cols; ++y) {
+      printf(" " SLC_MAT_FMT, mat->data[x * mat->cols + y]);
+    }
+    printf(" ]\n");
+  }
+  return 1;
+}
+
+#undef SLC_MAT_REDUCE
+#undef SLC_MAT_LIST_FN
+#undef SLC_MAT_VEC_FN
+#undef SLC_MAT_VEC
+#undef SLC_MAT_FN
+#undef SLC_MAT
+#undef SLC_MAT_FMT
+#undef SLC_MAT_T
+#undef SLC_MAT_NAME
@@ -0,0 +1,85 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_ptr_vec.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Nested vecs are stored CSR style. Converting a list<list<T>> lays every
+ * element out back to back in one values array, right after the row
+ * table, and row x is a view of its run of that array. Walking a nested
+ * vec is an index loop over the rows, then an index loop over each row,
+ * with no pointer chasing between elements.
+ *
+ * A nested vec made by collect holds rows copied from other vecs, which
+ * are views of those vecs' elements.
+ */
+
+struct slc_ptr_vec * slc_ptr_vec_create(size_t n)
+{
+  struct slc_ptr_vec * vec = calloc(1, sizeof(struct slc_ptr_vec) + n * sizeof(struct slc_vec_row));
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = n;
+  vec->cap = n;
+  vec->data = vec->storage;
+  return vec;
+}
+
+int8_t slc_ptr_vec_destroy(struct slc_ptr_vec * vec)
+{
+  if (NULL == vec) {
+    return 0;
+  }
+  /* the values of a csr vec share its allocation */
+  free(vec);
+  return 1;
+}
+
+int64_t slc_ptr_vec_length(struct slc_ptr_vec * vec)
+{
+  return vec->len;
+}
+
+struct slc_ptr_vec * slc_ptr_vec_slice(struct slc_ptr_vec * vec, int64_t start, int64_t end)
+{
+  /* clamp to [0, len] so a slice never reaches outside of vec */
+  start = (start < 0) ? 0 : (start > vec->len) ? vec->len : start;
+  end = (end < start) ? start : (end > vec->len) ? vec->len : end;
+  struct slc_ptr_vec * view = malloc(sizeof(struct slc_ptr_vec));
+  if (NULL == view) {
+    return NULL;
+  }
+  view->len = end - start;
+  view->cap = 0;
+  view->data = vec->data + start;
+  return view;
+}
+
+struct slc_ptr_vec * slc_ptr_vec_csr(size_t rows, size_t count, size_t elem_size, void ** values)
+{
+  struct slc_ptr_vec * vec = malloc(
+    sizeof(struct slc_ptr_vec) + rows * sizeof(struct slc_vec_row) + count * elem_size);
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = rows;
+  vec->cap = rows;
+  vec->data = vec->storage;
+  /* rows are 8-byte aligned, and so is what follows them */
+  *values = &vec->storage[rows];
+  return vec;
+}
@@ -0,0 +1,472 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <asw/runtime/slc_pvec.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Every node has at most SLC_PVEC_WIDTH slots. A leaf's slots are
+ * elements. An inner node's slots are its children, followed by one size
+ * per child: the number of elements under that child and every one
+ * before it. A child of a node at shift s never holds more than 1 << s
+ * elements, so element i is under child i >> s or one of those after it,
+ * and finding it is a short scan of the sizes that usually stops at once.
+ *
+ * That is what makes the tree relaxed: a child need not be full, so
+ * slice and concat can leave short nodes behind instead of copying every
+ * element into place. Concat then keeps the tree shallow by spreading the
+ * slots of short nodes over their neighbours, until each level has no
+ * more than SLC_PVEC_EXTRA nodes beyond the fewest that could hold it.
+ */
+#define SLC_PVEC_BITS 5
+#define SLC_PVEC_WIDTH (1 << SLC_PVEC_BITS)
+#define SLC_PVEC_EXTRA 2
+_Static_assert(sizeof(void *) == sizeof(uint64_t), "a slot holds a child or an element");
+
+struct slc_pvec_node
+{
+  uint32_t count;
+  uint64_t slots[];
+};
+
+static struct slc_pvec_node * _node_create(uint32_t count, int64_t shift)
+{
+  /* an inner node's sizes follow its children */
+  struct slc_pvec_node * node = malloc(
+    sizeof(struct slc_pvec_node) + count * sizeof(uint64_t) * ((0 == shift) ? 1 : 2));
+  if (NULL != node) {
+    node->count = count;
+  }
+  return node;
+}
+
+static inline struct slc_pvec_node * _child(const struct slc_pvec_node * node, uint32_t x)
+{
+  return (struct slc_pvec_node *)(uintptr_t)node->slots[x];
+}
+
+static inline int64_t * _sizes(struct slc_pvec_node * node)
+{
+  return (int64_t *)&node->slots[node->count];
+}
+
+static inline int64_t _size(struct slc_pvec_node * node, int64_t shift)
+{
+  return (0 == shift) ? node->count : _sizes(node)[node->count - 1];
+}
+
+/* elements under the children before x */
+static inline int64_t _before(struct slc_pvec_node * node, uint32_t x)
+{
+  return (0 == x) ? 0 : _sizes(node)[x - 1];
+}
+
+/* the child that element i is under */
+static inline uint32_t _find(struct slc_pvec_node * node, int64_t shift, int64_t i)
+{
+  uint32_t x = i >> shift;
+  for (const int64_t * sizes = _sizes(node); sizes[x] <= i; ++x) {
+  }
+  return x;
+}
+
+static struct slc_pvec_node * _copy(struct slc_pvec_node * node, int64_t shift)
+{
+  struct slc_pvec_node * ret = _node_create(node->count, shift);
+  if (NULL != ret) {
+    memcpy(ret->slots, node->slots, node->count * sizeof(uint64_t) * ((0 == shift) ? 1 : 2));
+  }
+  return ret;
+}
+
+/* set the sizes of an inner node from its children */
+static void _set_sizes(struct slc_pvec_node * node, int64_t shift)
+{
+  int64_t * sizes = _sizes(node);
+  int64_t total = 0;
+  for (uint32_t x = 0; x < node->count; ++x) {
+    total += _size(_child(node, x), shift - SLC_PVEC_BITS);
+    sizes[x] = total;
+  }
+}
+
+/* an inner node at shift over the nodes kids[0, n) */
+static struct slc_pvec_node * _inner(struct slc_pvec_node ** kids, uint32_t n, int64_t shift)
+{
+  struct slc_pvec_node * node = _node_create(n, shift);
+  if (NULL == node) {
+    return NULL;
+  }
+  for (uint32_t x = 0; x < n; ++x) {
+    node->slots[x] = (uintptr_t)kids[x];
+  }
+  _set_sizes(node, shift);
+  return node;
+}
+
+static struct slc_pvec * _pvec_of(int64_t len, int64_t shift, struct slc_pvec_node * root)
+{
+  /* a root with one child is replaced by the child, so the tree is no deeper than it has to be */
+  for (; 0 != shift && 1 == root->count; shift -= SLC_PVEC_BITS) {
+    root = _child(root, 0);
+  }
+  struct slc_pvec * ret = malloc(sizeof(struct slc_pvec));
+  if (NULL != ret) {
+    ret->len = len;
+    ret->shift = (0 == len) ? 0 : shift;
+    ret->root = (0 == len) ? NULL : root;
+  }
+  return ret;
+}
+
+struct slc_pvec * slc_pvec_create()
+{
+  return _pvec_of(0, 0, NULL);
+}
+
+struct slc_pvec * slc_pvec_reserve(int64_t n)
+{
+  if (n <= 0) {
+    return slc_pvec_create();
+  }
+  /* full leaves, then each level above them is built from the one below */
+  int64_t count = (n + SLC_PVEC_WIDTH - 1) / SLC_PVEC_WIDTH;
+  struct slc_pvec_node ** level = malloc(count * sizeof(struct slc_pvec_node *));
+  if (NULL == level) {
+    return NULL;
+  }
+  for (int64_t x = 0; x < count; ++x) {
+    int64_t left = n - x * SLC_PVEC_WIDTH;
+    level[x] = _node_create((left < SLC_PVEC_WIDTH) ? left : SLC_PVEC_WIDTH, 0);
+    if (NULL == level[x]) {
+      free(level);
+      return NULL;
+    }
+    memset(level[x]->slots, 0, level[x]->count * sizeof(uint64_t));
+  }
+  int64_t shift = 0;
+  for (; count > 1; count = (count + SLC_PVEC_WIDTH - 1) / SLC_PVEC_WIDTH) {
+    shift += SLC_PVEC_BITS;
+    for (int64_t x = 0; x * SLC_PVEC_WIDTH < count; ++x) {
+      int64_t left = count - x * SLC_PVEC_WIDTH;
+      level[x] = _inner(
+        &level[x * SLC_PVEC_WIDTH], (left < SLC_PVEC_WIDTH) ? left : SLC_PVEC_WIDTH, shift);
+      if (NULL == level[x]) {
+        free(level);
+        return NULL;
+      }
+    }
+  }
+  struct slc_pvec * ret = _pvec_of(n, shift, level[0]);
+  free(level);
+  return ret;
+}
+
+uint64_t * slc_pvec_leaf(struct slc_pvec * pvec, int64_t i, int64_t * end)
+{
+  struct slc_pvec_node * node = pvec->root;
+  const int64_t at = i;
+  for (int64_t shift = pvec->shift; shift > 0; shift -= SLC_PVEC_BITS) {
+    uint32_t x = _find(node, shift, i);
+    i -= _before(node, x);
+    node = _child(node, x);
+  }
+  *end = at - i + node->count;
+  return &node->slots[i];
+}
+
+uint64_t slc_pvec_nth(struct slc_pvec * pvec, int64_t i)
+{
+  if (i < 0 || i >= pvec->len) {
+    return 0;
+  }
+  int64_t end;
+  return *slc_pvec_leaf(pvec, i, &end);
+}
+
+static struct slc_pvec_node * _assoc(
+  struct slc_pvec_node * node, int64_t shift, int64_t i, uint64_t val)
+{
+  struct slc_pvec_node * ret = _copy(node, shift);
+  if (NULL == ret) {
+    return NULL;
+  } else if (0 == shift) {
+    ret->slots[i] = val;
+    return ret;
+  }
+  uint32_t x = _find(node, shift, i);
+  struct slc_pvec_node * child = _assoc(
+    _child(node, x), shift - SLC_PVEC_BITS, i - _before(node, x), val);
+  if (NULL == child) {
+    free(ret);
+    return NULL;
+  }
+  ret->slots[x] = (uintptr_t)child;
+  return ret;
+}
+
+struct slc_pvec * slc_pvec_assoc(struct slc_pvec * pvec, int64_t i, uint64_t val)
+{
+  if (i < 0 || i >= pvec->len) {
+    return pvec;
+  }
+  struct slc_pvec_node * root = _assoc(pvec->root, pvec->shift, i, val);
+  return (NULL == root) ? NULL : _pvec_of(pvec->len, pvec->shift, root);
+}
+
+/* a node at shift holding just val */
+static struct slc_pvec_node * _path(int64_t shift, uint64_t val)
+{
+  struct slc_pvec_node * node = _node_create(1, 0);
+  if (NULL == node) {
+    return NULL;
+  }
+  node->slots[0] = val;
+  for (int64_t at = SLC_PVEC_BITS; NULL != node && at <= shift; at += SLC_PVEC_BITS) {
+    node = _inner(&node, 1, at);
+  }
+  return node;
+}
+
+/* node with val after its last element, NULL if there is no room under it */
+static struct slc_pvec_node * _push(struct slc_pvec_node * node, int64_t shift, uint64_t val)
+{
+  if (0 == shift) {
+    if (SLC_PVEC_WIDTH == node->count) {
+      return NULL;
+    }
+    struct slc_pvec_node * ret = _node_create(node->count + 1, 0);
+    if (NULL != ret) {
+      memcpy(ret->slots, node->slots, node->count * sizeof(uint64_t));
+      ret->slots[node->count] = val;
+    }
+    return ret;
+  }
+  const uint32_t last = node->count - 1;
+  struct slc_pvec_node * child = _push(_child(node, last), shift - SLC_PVEC_BITS, val);
+  if (NULL != child) {
+    struct slc_pvec_node * ret = _copy(node, shift);
+    if (NULL != ret) {
+      ret->slots[last] = (uintptr_t)child;
+      ++_sizes(ret)[last];
+    }
+    return ret;
+  } else if (SLC_PVEC_WIDTH == node->count) {
+    return NULL;
+  }
+  /* the last child is full, start a new one beside it */
+  struct slc_pvec_node * kids[SLC_PVEC_WIDTH];
+  memcpy(kids, node->slots, node->count * sizeof(uint64_t));
+  kids[node->count] = _path(shift - SLC_PVEC_BITS, val);
+  return (NULL == kids[node->count]) ? NULL : _inner(kids, node->count + 1, shift);
+}
+
+struct slc_pvec * slc_pvec_push(struct slc_pvec * pvec, uint64_t val)
+{
+  if (0 == pvec->len) {
+    return _pvec_of(1, 0, _path(0, val));
+  }
+  struct slc_pvec_node * root = _push(pvec->root, pvec->shift, val);
+  if (NULL != root) {
+    return _pvec_of(pvec->len + 1, pvec->shift, root);
+  }
+  /* the tree is full, so it gets a new level */
+  int64_t shift = pvec->shift + SLC_PVEC_BITS;
+  struct slc_pvec_node * kids[2] = {pvec->root, _path(pvec->shift, val)};
+  root = (NULL == kids[1]) ? NULL : _inner(kids, 2, shift);
+  return (NULL == root) ? NULL : _pvec_of(pvec->len + 1, shift, root);
+}
+
+/* the elements of node before end, which is at least 1 */
+static struct slc_pvec_node * _slice_right(
+  struct slc_pvec_node * node, int64_t shift, int64_t end)
+{
+  if (end == _size(node, shift)) {
+    return node;
+  } else if (0 == shift) {
+    struct slc_pvec_node * ret = _node_create(end, 0);
+    if (NULL != ret) {
+      memcpy(ret->slots, node->slots, end * sizeof(uint64_t));
+    }
+    return ret;
+  }
+  uint32_t x = _find(node, shift, end - 1);
+  struct slc_pvec_node * kids[SLC_PVEC_WIDTH];
+  memcpy(kids, node->slots, x * sizeof(uint64_t));
+  kids[x] = _slice_right(_child(node, x), shift - SLC_PVEC_BITS, end - _before(node, x));
+  return (NULL == kids[x]) ? NULL : _inner(kids, x + 1, shift);
+}
+
+/* the elements of node from start on */
+static struct slc_pvec_node * _slice_left(
+  struct slc_pvec_node * node, int64_t shift, int64_t start)
+{
+  if (0 == start) {
+    return node;
+  } else if (0 == shift) {
+    struct slc_pvec_node * ret = _node_create(node->count - start, 0);
+    if (NULL != ret) {
+      memcpy(ret->slots, &node->slots[start], ret->count * sizeof(uint64_t));
+    }
+    return ret;
+  }
+  uint32_t x = _find(node, shift, start);
+  struct slc_pvec_node * kids[SLC_PVEC_WIDTH];
+  kids[0] = _slice_left(_child(node, x), shift - SLC_PVEC_BITS, start - _before(node, x));
+  memcpy(&kids[1], &node->slots[x + 1], (node->count - x - 1) * sizeof(uint64_t));
+  return (NULL == kids[0]) ? NULL : _inner(kids, node->count - x, shift);
+}
+
+struct slc_pvec * slc_pvec_slice(struct slc_pvec * pvec, int64_t start, int64_t end)
+{
+  start = (start < 0) ? 0 : start;
+  end = (end > pvec->len) ? pvec->len : end;
+  if (start >= end) {
+    return slc_pvec_create();
+  }
+  struct slc_pvec_node * root = _slice_right(pvec->root, pvec->shift, end);
+  root = (NULL == root) ? NULL : _slice_left(root, pvec->shift, start);
+  return (NULL == root) ? NULL : _pvec_of(end - start, pvec->shift, root);
+}
+
+/**
+ * kids[0, n) are the nodes at shift that a concatenation left side by
+ * side. spread the slots of short ones over those after them, then return
+ * a node at shift + 2 * SLC_PVEC_BITS over the one or two nodes at shift
+ * + SLC_PVEC_BITS that hold them.
+ */
+static struct slc_pvec_node * _rebalance(struct slc_pvec_node ** kids, uint32_t n, int64_t shift)
+{
+  uint32_t plan[3 * SLC_PVEC_WIDTH];
+  int64_t slots = 0;
+  for (uint32_t x = 0; x < n; ++x) {
+    plan[x] = kids[x]->count;
+    slots += plan[x];
+  }
+  const uint32_t fewest = (slots + SLC_PVEC_WIDTH - 1) / SLC_PVEC_WIDTH;
+  uint32_t planned = n;
+  for (uint32_t x = 0; planned > fewest + SLC_PVEC_EXTRA; --x) {
+    /* skip nodes that are nearly full, then pour the next one into those after it */
+    for (; plan[x] >= SLC_PVEC_WIDTH - SLC_PVEC_EXTRA / 2; ++x) {
+    }
+    for (uint32_t rest = plan[x]; rest > 0; ++x) {
+      const uint32_t fill =
+        (rest + plan[x + 1] < SLC_PVEC_WIDTH) ? rest + plan[x + 1] : SLC_PVEC_WIDTH;
+      rest = rest + plan[x + 1] - fill;
+      plan[x] = fill;
+    }
+    /* the node at x was emptied */
+    memmove(&plan[x], &plan[x + 1], (planned - x - 1) * sizeof(uint32_t));
+    --planned;
+  }
+  /* follow the plan, keeping any node that it leaves where it was */
+  struct slc_pvec_node * out[3 * SLC_PVEC_WIDTH];
+  uint32_t from = 0, offset = 0;
+  for (uint32_t x = 0; x < planned; ++x) {
+    if (0 == offset && kids[from]->count == plan[x]) {
+      out[x] = kids[from++];
+      continue;
+    }
+    out[x] = _node_create(plan[x], shift);
+    if (NULL == out[x]) {
+      return NULL;
+    }
+    for (uint32_t filled = 0; filled < plan[x]; ) {
+      uint32_t take = kids[from]->count - offset;
+      take = (take < plan[x] - filled) ? take : plan[x] - filled;
+      memcpy(&out[x]->slots[filled], &kids[from]->slots[offset], take * sizeof(uint64_t));
+      filled += take;
+      offset += take;
+      if (offset == kids[from]->count) {
+        ++from;
+        offset = 0;
+      }
+    }
+    if (0 != shift) {
+      _set_sizes(out[x], shift);
+    }
+  }
+  struct slc_pvec_node * parents[2];
+  uint32_t count = 0;
+  for (uint32_t x = 0; x < planned; x += SLC_PVEC_WIDTH) {
+    const uint32_t take = (planned - x < SLC_PVEC_WIDTH) ? planned - x : SLC_PVEC_WIDTH;
+    parents[count] = _inner(&out[x], take, shift + SLC_PVEC_BITS);
+    if (NULL == parents[count++]) {
+      return NULL;
+    }
+  }
+  return _inner(parents, count, shift + 2 * SLC_PVEC_BITS);
+}
+
+/**
+ * left followed by right, as a node one level above the taller of them.
+ * it has one or two children, the rest are rebalanced on the way up.
+ */
+static struct slc_pvec_node * _concat(
+  struct slc_pvec_node * left, int64_t lshift, struct slc_pvec_node * right, int64_t rshift)
+{
+  struct slc_pvec_node * kids[3 * SLC_PVEC_WIDTH];
+  uint32_t n = 0;
+  if (0 == lshift && 0 == rshift) {
+    /* two leaves, which become one if they fit */
+    kids[n++] = left;
+    if (left->count + right->count <= SLC_PVEC_WIDTH) {
+      kids[0] = _node_create(left->count + right->count, 0);
+      if (NULL == kids[0]) {
+        return NULL;
+      }
+      memcpy(kids[0]->slots, left->slots, left->count * sizeof(uint64_t));
+      memcpy(&kids[0]->slots[left->count], right->slots, right->count * sizeof(uint64_t));
+    } else {
+      kids[n++] = right;
+    }
+    return _inner(kids, n, SLC_PVEC_BITS);
+  }
+  /* join the inner edges, then rebalance them with the rest of the taller side(s) */
+  const int64_t shift = (lshift > rshift) ? lshift : rshift;
+  struct slc_pvec_node * mid = _concat(
+    (lshift == shift) ? _child(left, left->count - 1) : left,
+    (lshift == shift) ? lshift - SLC_PVEC_BITS : lshift,
+    (rshift == shift) ? _child(right, 0) : right,
+    (rshift == shift) ? rshift - SLC_PVEC_BITS : rshift);
+  if (NULL == mid) {
+    return NULL;
+  }
+  if (lshift == shift) {
+    memcpy(kids, left->slots, (left->count - 1) * sizeof(uint64_t));
+    n += left->count - 1;
+  }
+  memcpy(&kids[n], mid->slots, mid->count * sizeof(uint64_t));
+  n += mid->count;
+  if (rshift == shift) {
+    memcpy(&kids[n], &right->slots[1], (right->count - 1) * sizeof(uint64_t));
+    n += right->count - 1;
+  }
+  return _rebalance(kids, n, shift - SLC_PVEC_BITS);
+}
+
+struct slc_pvec * slc_pvec_concat(struct slc_pvec * a, struct slc_pvec * b)
+{
+  if (0 == a->len) {
+    return b;
+  } else if (0 == b->len) {
+    return a;
+  }
+  const int64_t shift = ((a->shift > b->shift) ? a->shift : b->shift) + SLC_PVEC_BITS;
+  struct slc_pvec_node * root = _concat(a->root, a->shift, b->root, b->shift);
+  return (NULL == root) ? NULL : _pvec_of(a->len + b->len, shift, root);
+}
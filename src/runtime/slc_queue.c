@@ -0,0 +1,91 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <asw/runtime/slc_queue.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLC_QUEUE_MIN_CAP 16
+
+struct slc_queue * slc_queue_create()
+{
+  struct slc_queue * queue = malloc(sizeof(struct slc_queue));
+  if (NULL == queue) {
+    return NULL;
+  }
+  queue->slots = malloc(SLC_QUEUE_MIN_CAP * sizeof(uint64_t));
+  if (NULL == queue->slots) {
+    free(queue);
+    return NULL;
+  }
+  queue->len = 0;
+  queue->head = 0;
+  queue->mask = SLC_QUEUE_MIN_CAP - 1;
+  return queue;
+}
+
+int8_t slc_queue_destroy(struct slc_queue * queue)
+{
+  if (NULL == queue) {
+    return 0;
+  }
+  free(queue->slots);
+  free(queue);
+  return 1;
+}
+
+/* double the capacity, unwrapping the elements to the front of the new buffer */
+static int _grow(struct slc_queue * queue)
+{
+  const int64_t cap = queue->mask + 1;
+  uint64_t * slots = malloc(2 * cap * sizeof(uint64_t));
+  if (NULL == slots) {
+    return 0;
+  }
+  const int64_t first = cap - queue->head;
+  memcpy(slots, &queue->slots[queue->head], first * sizeof(uint64_t));
+  memcpy(&slots[first], queue->slots, queue->head * sizeof(uint64_t));
+  free(queue->slots);
+  queue->slots = slots;
+  queue->head = 0;
+  queue->mask = 2 * cap - 1;
+  return 1;
+}
+
+struct slc_queue * slc_queue_push(struct slc_queue * queue, uint64_t val)
+{
+  if (queue->len > queue->mask && !_grow(queue)) {
+    return NULL;
+  }
+  queue->slots[(queue->head + queue->len) & queue->mask] = val;
+  ++queue->len;
+  return queue;
+}
+
+uint64_t slc_queue_pop(struct slc_queue * queue)
+{
+  if (0 == queue->len) {
+    return 0;
+  }
+  uint64_t val = queue->slots[queue->head];
+  queue->head = (queue->head + 1) & queue->mask;
+  --queue->len;
+  return val;
+}
+
+uint64_t slc_queue_peek(struct slc_queue * queue)
+{
+  return (0 == queue->len) ? 0 : queue->slots[queue->head];
+}
@@ -0,0 +1,77 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_record_vec.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Either way a record vec is one allocation. An aos vec stores its records
+ * right after the header, where an soa vec has its column headers, and an
+ * soa vec stores each column after the last column header.
+ */
+
+struct slc_record_vec * slc_record_vec_create(size_t n, size_t elem_size)
+{
+  struct slc_record_vec * vec = calloc(1, sizeof(struct slc_record_vec) + n * elem_size);
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = n;
+  vec->cap = n;
+  vec->data = vec->columns;
+  vec->fields = 0;
+  return vec;
+}
+
+struct slc_record_vec * slc_record_vec_create_soa(
+  size_t n, size_t fields, const int64_t * column_bytes)
+{
+  size_t bytes = sizeof(struct slc_record_vec) + fields * sizeof(struct slc_vec_row);
+  for (size_t x = 0; x < fields; ++x) {
+    bytes += column_bytes[x];
+  }
+  struct slc_record_vec * vec = calloc(1, bytes);
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = n;
+  vec->cap = n;
+  vec->data = NULL;
+  vec->fields = fields;
+  /* the compiler sizes columns in whole words, so each one stays 8-byte aligned */
+  char * column = (char *)&vec->columns[fields];
+  for (size_t x = 0; x < fields; ++x) {
+    vec->columns[x].len = n;
+    vec->columns[x].cap = 0;
+    vec->columns[x].data = column;
+    column += column_bytes[x];
+  }
+  return vec;
+}
+
+int8_t slc_record_vec_destroy(struct slc_record_vec * vec)
+{
+  if (NULL == vec) {
+    return 0;
+  }
+  /* the records or columns share the allocation */
+  free(vec);
+  return 1;
+}
+
+int64_t slc_record_vec_length(struct slc_record_vec * vec)
+{
+  return vec->len;
+}
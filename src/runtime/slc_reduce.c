@@ -0,0 +1,93 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <asw/runtime/slc_reduce.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "slc_target.h"
+
+/**
+ * Each kernel keeps SLC_REDUCE_LANES independent accumulators, so no
+ * iteration waits on the one before it, and the lanes map directly onto
+ * SIMD registers. The accumulators are combined once at the end, which
+ * means floating point sums and products are reassociated.
+ *
+ * On x86-64 every kernel is cloned for AVX-512, AVX2 and the SSE2
+ * baseline. The loader resolves each one through CPUID when the runtime is
+ * loaded, so the dispatch costs nothing per call.
+ */
+#define SLC_REDUCE_LANES 8
+
+#define SLC_ADD(a, b) ((a) + (b))
+#define SLC_MUL(a, b) ((a) * (b))
+#define SLC_MIN(a, b) (((b) < (a)) ? (b) : (a))
+#define SLC_MAX(a, b) (((b) > (a)) ? (b) : (a))
+
+/* identity is the starting value of every lane, and may refer to init */
+#define SLC_REDUCE_KERNEL(name, T, identity, OP) \
+  SLC_TARGET_CLONES \
+  T name(const T * vals, size_t n, T init) \
+  { \
+    T acc[SLC_REDUCE_LANES]; \
+    for (size_t lane = 0; lane < SLC_REDUCE_LANES; ++lane) { \
+      acc[lane] = (identity); \
+    } \
+    size_t x = 0; \
+    for (; x + SLC_REDUCE_LANES <= n; x += SLC_REDUCE_LANES) { \
+      for (size_t lane = 0; lane < SLC_REDUCE_LANES; ++lane) { \
+        acc[lane] = OP(acc[lane], vals[x + lane]); \
+      } \
+    } \
+    T ret = init; \
+    for (size_t lane = 0; lane < SLC_REDUCE_LANES; ++lane) { \
+      ret = OP(ret, acc[lane]); \
+    } \
+    for (; x < n; ++x) { \
+      ret = OP(ret, vals[x]); \
+    } \
+    return ret; \
+  }
+
+SLC_REDUCE_KERNEL(slc_reduce_int_sum, int64_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_int_prod, int64_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_int_min, int64_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_int_max, int64_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_double_sum, double, 0.0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_double_prod, double, 1.0, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_double_min, double, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_double_max, double, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_i8_sum, int8_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_i8_prod, int8_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_i8_min, int8_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_i8_max, int8_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_i16_sum, int16_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_i16_prod, int16_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_i16_min, int16_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_i16_max, int16_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_i32_sum, int32_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_i32_prod, int32_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_i32_min, int32_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_i32_max, int32_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_u32_sum, uint32_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_u32_prod, uint32_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_u32_min, uint32_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_u32_max, uint32_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_u64_sum, uint64_t, 0, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_u64_prod, uint64_t, 1, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_u64_min, uint64_t, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_u64_max, uint64_t, init, SLC_MAX)
+SLC_REDUCE_KERNEL(slc_reduce_f32_sum, float, 0.0f, SLC_ADD)
+SLC_REDUCE_KERNEL(slc_reduce_f32_prod, float, 1.0f, SLC_MUL)
+SLC_REDUCE_KERNEL(slc_reduce_f32_min, float, init, SLC_MIN)
+SLC_REDUCE_KERNEL(slc_reduce_f32_max, float, init, SLC_MAX)
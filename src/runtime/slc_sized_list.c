@@ -0,0 +1,40 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_sized_list.h>
+#include <stdint.h>
+
+#define SLC_LIST_NAME i8
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
+
+#define SLC_LIST_NAME i16
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
+
+#define SLC_LIST_NAME i32
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
+
+#define SLC_LIST_NAME u32
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
+
+#define SLC_LIST_NAME u64
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
+
+#define SLC_LIST_NAME f32
+#define SLC_LIST_NUMERIC
+#include "slc_list_impl.h"
@@ -0,0 +1,69 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <asw/runtime/slc_double_list.h>
+#include <asw/runtime/slc_int_list.h>
+#include <asw/runtime/slc_sized_list.h>
+#include <asw/runtime/slc_sized_vec.h>
+#include <inttypes.h>
+#include <stdint.h>
+
+#define SLC_VEC_NAME int
+#define SLC_VEC_T int64_t
+#define SLC_VEC_FMT "%" PRId64
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME double
+#define SLC_VEC_T double
+#define SLC_VEC_FMT "%f"
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME i8
+#define SLC_VEC_T int8_t
+#define SLC_VEC_FMT "%" PRId8
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME i16
+#define SLC_VEC_T int16_t
+#define SLC_VEC_FMT "%" PRId16
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME i32
+#define SLC_VEC_T int32_t
+#define SLC_VEC_FMT "%" PRId32
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME u32
+#define SLC_VEC_T uint32_t
+#define SLC_VEC_FMT "%" PRIu32
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME u64
+#define SLC_VEC_T uint64_t
+#define SLC_VEC_FMT "%" PRIu64
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
+
+#define SLC_VEC_NAME f32
+#define SLC_VEC_T float
+#define SLC_VEC_FMT "%f"
+#define SLC_VEC_LIST
+#include "slc_vec_impl.h"
@@ -0,0 +1,97 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_string.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* long enough for any int64_t and any %.17g, with the NUL */
+#define SLC_STRING_NUMBER_BYTES 32
+
+static const char * _copy_string(const char * s, size_t len)
+{
+  char * ret = malloc(len + 1);
+  return (NULL == ret) ? NULL : memcpy(ret, s, len + 1);
+}
+
+const char * slc_string_concat(const char * const * parts, int64_t n)
+{
+  size_t bytes = 1;
+  for (int64_t x = 0; x < n; ++x) {
+    bytes += strlen(parts[x]);
+  }
+  char * ret = malloc(bytes);
+  if (NULL == ret) {
+    return NULL;
+  }
+  char * end = ret;
+  *end = '\0';
+  for (int64_t x = 0; x < n; ++x) {
+    end = stpcpy(end, parts[x]);
+  }
+  return ret;
+}
+
+int64_t slc_string_length(const char * s)
+{
+  return strlen(s);
+}
+
+int64_t slc_string_compare(const char * a, const char * b)
+{
+  return strcmp(a, b);
+}
+
+const char * slc_string_from_int(int64_t i)
+{
+  /* digits are written backwards from the end of buf */
+  char buf[SLC_STRING_NUMBER_BYTES];
+  char * start = buf + sizeof(buf) - 1;
+  *start = '\0';
+  uint64_t mag = (i < 0) ? -(uint64_t)i : (uint64_t)i;
+  do {
+    *--start = '0' + mag % 10;
+    mag /= 10;
+  } while (0 != mag);
+  if (i < 0) {
+    *--start = '-';
+  }
+  return _copy_string(start, buf + sizeof(buf) - 1 - start);
+}
+
+const char * slc_string_from_double(double d)
+{
+  /* the shortest of 15 to 17 significant digits that reads back as d */
+  char buf[SLC_STRING_NUMBER_BYTES];
+  int len = 0;
+  for (int digits = 15; digits <= 17; ++digits) {
+    len = snprintf(buf, sizeof(buf), "%.*g", digits, d);
+    if (strtod(buf, NULL) == d) {
+      break;
+    }
+  }
+  return _copy_string(buf, len);
+}
+
+int64_t slc_string_to_int(const char * s)
+{
+  return strtoll(s, NULL, 10);
+}
+
+double slc_string_to_double(const char * s)
+{
+  return strtod(s, NULL);
+}
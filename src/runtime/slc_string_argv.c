@@ -0,0 +1,89 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <asw/runtime/slc_string_argv.h>
+#include <asw/runtime/slc_string_list.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * There is one command line per process, so the end of argv is kept here
+ * rather than in each list value: the length of an argv list is its
+ * distance to the end, and car, cdr, and drop are pointer arithmetic.
+ */
+static const char * const * _argv_end = NULL;
+
+static inline const char * const * _slot_of(struct slc_string_list * list)
+{
+  return (const char * const *)((uintptr_t)list & ~(uintptr_t)SLC_STRING_ARGV_TAG);
+}
+
+static inline struct slc_string_list * _list_at(const char * const * slot)
+{
+  if (slot >= _argv_end) {
+    return NULL;
+  }
+  return (struct slc_string_list *)((uintptr_t)slot | SLC_STRING_ARGV_TAG);
+}
+
+struct slc_string_list * slc_string_list_from_argv(int64_t argc, const char ** argv)
+{
+  if (argc <= 0) {
+    return NULL;
+  }
+  _argv_end = argv + argc;
+  return _list_at(argv);
+}
+
+const char * slc_string_compact_head(struct slc_string_list * list)
+{
+  return *_slot_of(list);
+}
+
+struct slc_string_list * slc_string_compact_cdr(struct slc_string_list * list)
+{
+  return _list_at(_slot_of(list) + 1);
+}
+
+int64_t slc_string_compact_length(struct slc_string_list * list)
+{
+  return _argv_end - _slot_of(list);
+}
+
+struct slc_string_list * slc_string_compact_drop(struct slc_string_list * list, int64_t n)
+{
+  if (n >= slc_string_compact_length(list)) {
+    return NULL;
+  }
+  return _list_at(_slot_of(list) + n);
+}
+
+int8_t slc_string_compact_destroy(struct slc_string_list * list)
+{
+  /* argv belongs to the process */
+  (void)list;
+  return 0;
+}
+
+size_t slc_string_compact_decode(
+  struct slc_string_list * list, const char ** out, struct slc_string_list ** next)
+{
+  const char * const * slot = _slot_of(list);
+  size_t n = _argv_end - slot;
+  n = (n < SLC_STRING_ARGV_RUN) ? n : SLC_STRING_ARGV_RUN;
+  memcpy(out, slot, n * sizeof(*out));
+  *next = _list_at(slot + n);
+  return n;
+}
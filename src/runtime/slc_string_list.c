@@ -0,0 +1,51 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/runtime/slc_string_argv.h>
+#include <asw/runtime/slc_string_list.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLC_LIST_NAME string
+#define SLC_LIST_COMPACT
+#define SLC_LIST_COMPACT_RUN SLC_STRING_ARGV_RUN
+#include "slc_list_impl.h"
+
+const char * slc_string_list_add(struct slc_string_list * list)
+{
+  /* an argv list decodes into buf */
+  const char * buf[SLC_STRING_ARGV_RUN];
+  size_t bytes = 1;
+  for (struct slc_string_list * l = list, * next; NULL != l; l = next) {
+    size_t n;
+    const char * const * run = _slc_string_list_run(l, &n, &next, buf);
+    for (size_t x = 0; x < n; ++x) {
+      bytes += strlen(run[x]);
+    }
+  }
+  char * ret = malloc(bytes);
+  if (NULL == ret) {
+    return NULL;
+  }
+  char * end = ret;
+  *end = '\0';
+  for (struct slc_string_list * l = list, * next; NULL != l; l = next) {
+    size_t n;
+    const char * const * run = _slc_string_list_run(l, &n, &next, buf);
+    for (size_t x = 0; x < n; ++x) {
+      end = stpcpy(end, run[x]);
+    }
+  }
+  return ret;
+}
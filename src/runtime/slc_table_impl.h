@@ -0,0 +1,322 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Defines the hash table runtime for one key type. Include it once per
+ * key type, after the public header, with these defined:
+ *
+ *   SLC_TABLE_NAME     the same name the header was declared with
+ *   SLC_TABLE_K        C type of a key
+ *   SLC_TABLE_FMT      printf conversion for a key
+ *   SLC_TABLE_HASH(k)  64-bit hash of a key, well mixed in every bit
+ *   SLC_TABLE_EQ(a, b) key equality
+ *
+ * The top 57 bits of a hash pick the group a probe starts at, and the
+ * low 7 are kept in the control byte. Probes move a group further each
+ * time, which visits every group of a power of two table. Tables grow
+ * at 7/8 full, counting deleted slots, so a probe always ends at an
+ * empty slot.
+ */
+#ifndef ASW__SLC__RUNTIME__SLC_TABLE_H_
+#error "include the public header for the table type before slc_table_impl.h"
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slc_hash_group.h"
+
+#define SLC_TABLE SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _table)
+#define SLC_TABLE_KEY SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _table_key)
+#define SLC_TABLE_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _table_ ## fn)
+#define SLC_TABLE_MAP_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _map_ ## fn)
+#define SLC_TABLE_SET_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _set_ ## fn)
+#define SLC_TABLE_LIST SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _list)
+#define SLC_TABLE_LIST_FN(fn) SLC_TABLE_CAT(slc_, SLC_TABLE_NAME, _list_ ## fn)
+
+/* control bytes, keys and values of cap slots, all in one block */
+static int8_t SLC_TABLE_FN(alloc)(struct SLC_TABLE * table, int64_t cap, int8_t values)
+{
+  /* keep the keys aligned after the control bytes */
+  size_t ctrl = (cap + SLC_HASH_GROUP + 7) & ~(size_t)7;
+  size_t bytes = ctrl + cap * sizeof(SLC_TABLE_KEY) + (values ? cap * sizeof(uint64_t) : 0);
+  char * block = malloc(bytes);
+  if (NULL == block) {
+    return 0;
+  }
+  memset(block, SLC_HASH_EMPTY, cap + SLC_HASH_GROUP);
+  table->len = 0;
+  table->cap = cap;
+  table->ctrl = (int8_t *)block;
+  table->keys = (SLC_TABLE_KEY *)(block + ctrl);
+  table->vals = values ? (uint64_t *)(table->keys + cap) : NULL;
+  table->growth = cap - cap / 8;
+  return 1;
+}
+
+static struct SLC_TABLE * SLC_TABLE_FN(create)(int8_t values)
+{
+  struct SLC_TABLE * table = malloc(sizeof(struct SLC_TABLE));
+  if (NULL == table) {
+    return NULL;
+  }
+  if (!SLC_TABLE_FN(alloc)(table, SLC_HASH_GROUP, values)) {
+    free(table);
+    return NULL;
+  }
+  return table;
+}
+
+static int8_t SLC_TABLE_FN(destroy)(struct SLC_TABLE * table)
+{
+  if (NULL == table) {
+    return 0;
+  }
+  free(table->ctrl);
+  free(table);
+  return 1;
+}
+
+static inline void SLC_TABLE_FN(set_ctrl)(struct SLC_TABLE * table, int64_t x, int8_t ctrl)
+{
+  table->ctrl[x] = ctrl;
+  if (x < SLC_HASH_GROUP) {
+    /* the copy read by a group that starts near the end */
+    table->ctrl[table->cap + x] = ctrl;
+  }
+}
+
+/* the slot holding key, or -1 */
+static inline int64_t SLC_TABLE_FN(find)(
+  const struct SLC_TABLE * table, SLC_TABLE_KEY key, uint64_t hash)
+{
+  const uint64_t mask = table->cap - 1;
+  const int8_t h2 = hash & 0x7f;
+  uint64_t pos = (hash >> 7) & mask;
+  for (uint64_t step = SLC_HASH_GROUP;; pos = (pos + step) & mask, step += SLC_HASH_GROUP) {
+    const int8_t * group = table->ctrl + pos;
+    for (uint32_t match = slc_hash_match(group, h2); 0 != match; match &= match - 1) {
+      int64_t x = (pos + __builtin_ctz(match)) & mask;
+      if (SLC_TABLE_EQ(table->keys[x], key)) {
+        return x;
+      }
+    }
+    if (0 != slc_hash_match_empty(group)) {
+      return -1;
+    }
+  }
+}
+
+/* the first empty or deleted slot along the probe for hash */
+static inline int64_t SLC_TABLE_FN(find_free)(const struct SLC_TABLE * table, uint64_t hash)
+{
+  const uint64_t mask = table->cap - 1;
+  uint64_t pos = (hash >> 7) & mask;
+  for (uint64_t step = SLC_HASH_GROUP;; pos = (pos + step) & mask, step += SLC_HASH_GROUP) {
+    uint32_t match = slc_hash_match_free(table->ctrl + pos);
+    if (0 != match) {
+      return (pos + __builtin_ctz(match)) & mask;
+    }
+  }
+}
+
+/* rebuild the table, twice the size unless it is mostly deleted slots */
+static int8_t SLC_TABLE_FN(rehash)(struct SLC_TABLE * table)
+{
+  struct SLC_TABLE old = *table;
+  int64_t cap = (old.len < old.cap / 2) ? old.cap : old.cap * 2;
+  if (!SLC_TABLE_FN(alloc)(table, cap, NULL != old.vals)) {
+    *table = old;
+    return 0;
+  }
+  for (int64_t x = 0; x < old.cap; ++x) {
+    if (old.ctrl[x] < 0) {
+      continue;
+    }
+    uint64_t hash = SLC_TABLE_HASH(old.keys[x]);
+    int64_t y = SLC_TABLE_FN(find_free)(table, hash);
+    SLC_TABLE_FN(set_ctrl)(table, y, hash & 0x7f);
+    table->keys[y] = old.keys[x];
+    if (NULL != old.vals) {
+      table->vals[y] = old.vals[x];
+    }
+  }
+  table->len = old.len;
+  table->growth -= old.len;
+  free(old.ctrl);
+  return 1;
+}
+
+/* the slot for key, filled in if it is new */
+static int64_t SLC_TABLE_FN(insert)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  uint64_t hash = SLC_TABLE_HASH(key);
+  int64_t x = SLC_TABLE_FN(find)(table, key, hash);
+  if (x >= 0) {
+    return x;
+  }
+  if (0 == table->growth && !SLC_TABLE_FN(rehash)(table)) {
+    return -1;
+  }
+  x = SLC_TABLE_FN(find_free)(table, hash);
+  /* reusing a deleted slot doesn't bring the next empty one any closer */
+  table->growth -= (SLC_HASH_EMPTY == table->ctrl[x]);
+  SLC_TABLE_FN(set_ctrl)(table, x, hash & 0x7f);
+  table->keys[x] = key;
+  if (NULL != table->vals) {
+    table->vals[x] = 0;
+  }
+  ++table->len;
+  return x;
+}
+
+static int8_t SLC_TABLE_FN(has)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return SLC_TABLE_FN(find)(table, key, SLC_TABLE_HASH(key)) >= 0;
+}
+
+static int8_t SLC_TABLE_FN(remove)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  int64_t x = SLC_TABLE_FN(find)(table, key, SLC_TABLE_HASH(key));
+  if (x < 0) {
+    return 0;
+  }
+  /* a tombstone, so probes for keys placed after this one go on past it */
+  SLC_TABLE_FN(set_ctrl)(table, x, SLC_HASH_DELETED);
+  --table->len;
+  return 1;
+}
+
+struct SLC_TABLE * SLC_TABLE_MAP_FN(create)()
+{
+  return SLC_TABLE_FN(create)(1);
+}
+
+int8_t SLC_TABLE_MAP_FN(destroy)(struct SLC_TABLE * table)
+{
+  return SLC_TABLE_FN(destroy)(table);
+}
+
+int64_t SLC_TABLE_MAP_FN(length)(struct SLC_TABLE * table)
+{
+  return table->len;
+}
+
+struct SLC_TABLE * SLC_TABLE_MAP_FN(put)(struct SLC_TABLE * table, SLC_TABLE_KEY key, uint64_t val)
+{
+  int64_t x = SLC_TABLE_FN(insert)(table, key);
+  if (x < 0) {
+    return NULL;
+  }
+  table->vals[x] = val;
+  return table;
+}
+
+uint64_t SLC_TABLE_MAP_FN(get)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  int64_t x = SLC_TABLE_FN(find)(table, key, SLC_TABLE_HASH(key));
+  return (x < 0) ? 0 : table->vals[x];
+}
+
+int8_t SLC_TABLE_MAP_FN(has)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return SLC_TABLE_FN(has)(table, key);
+}
+
+int8_t SLC_TABLE_MAP_FN(remove)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return SLC_TABLE_FN(remove)(table, key);
+}
+
+struct SLC_TABLE * SLC_TABLE_SET_FN(create)()
+{
+  return SLC_TABLE_FN(create)(0);
+}
+
+int8_t SLC_TABLE_SET_FN(destroy)(struct SLC_TABLE * table)
+{
+  return SLC_TABLE_FN(destroy)(table);
+}
+
+int64_t SLC_TABLE_SET_FN(length)(struct SLC_TABLE * table)
+{
+  return table->len;
+}
+
+struct SLC_TABLE * SLC_TABLE_SET_FN(put)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return (SLC_TABLE_FN(insert)(table, key) < 0) ? NULL : table;
+}
+
+int8_t SLC_TABLE_SET_FN(has)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return SLC_TABLE_FN(has)(table, key);
+}
+
+int8_t SLC_TABLE_SET_FN(remove)(struct SLC_TABLE * table, SLC_TABLE_KEY key)
+{
+  return SLC_TABLE_FN(remove)(table, key);
+}
+
+struct SLC_TABLE * SLC_TABLE_SET_FN(from_array)(const SLC_TABLE_KEY * keys, size_t n)
+{
+  struct SLC_TABLE * table = SLC_TABLE_FN(create)(0);
+  for (size_t x = 0; NULL != table && x < n; ++x) {
+    if (SLC_TABLE_FN(insert)(table, keys[x]) < 0) {
+      SLC_TABLE_FN(destroy)(table);
+      return NULL;
+    }
+  }
+  return table;
+}
+
+struct SLC_TABLE * SLC_TABLE_SET_FN(from_list)(struct SLC_TABLE_LIST * list)
+{
+  size_t n = SLC_TABLE_LIST_FN(length)(list);
+  SLC_TABLE_KEY * keys = malloc(n * sizeof(SLC_TABLE_KEY));
+  if (NULL == keys) {
+    return NULL;
+  }
+  SLC_TABLE_LIST_FN(to_array)(list, keys);
+  struct SLC_TABLE * table = SLC_TABLE_SET_FN(from_array)(keys, n);
+  free(keys);
+  return table;
+}
+
+int8_t SLC_TABLE_CAT(print_slc_, SLC_TABLE_NAME, _set)(struct SLC_TABLE * table)
+{
+  printf("{");
+  for (int64_t x = 0; x < table->cap; ++x) {
+    if (table->ctrl[x] >= 0) {
+      printf(" " SLC_TABLE_FMT, table->keys[x]);
+    }
+  }
+  printf(" }\n");
+  return 1;
+}
+
+#undef SLC_TABLE_LIST_FN
+#undef SLC_TABLE_LIST
+#undef SLC_TABLE_SET_FN
+#undef SLC_TABLE_MAP_FN
+#undef SLC_TABLE_FN
+#undef SLC_TABLE_KEY
+#undef SLC_TABLE
+#undef SLC_TABLE_EQ
+#undef SLC_TABLE_HASH
+#undef SLC_TABLE_FMT
+#undef SLC_TABLE_K
+#undef SLC_TABLE_NAME
@@ -0,0 +1,32 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASW__SLC__RUNTIME__SLC_TARGET_H_
+#define ASW__SLC__RUNTIME__SLC_TARGET_H_
+
+/**
+ * Marks a runtime kernel to be cloned for AVX-512, AVX2 and the SSE2
+ * baseline on x86-64. The loader picks a clone through CPUID when the
+ * runtime is loaded, elsewhere this is empty.
+ */
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SLC_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef SLC_TARGET_CLONES
+#define SLC_TARGET_CLONES
+#endif
+
+#endif  /* ASW__SLC__RUNTIME__SLC_TARGET_H_ */
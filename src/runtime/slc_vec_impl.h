@@ -0,0 +1,218 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Defines the vec runtime for one numeric element type. Include it once
+ * per element type, after the public header, with these defined:
+ *
+ *   SLC_VEC_NAME  the same name the header was declared with
+ *   SLC_VEC_T     C type of an element
+ *   SLC_VEC_FMT   printf conversion for an element
+ *   SLC_VEC_LIST  if the header was declared with it, in which case the
+ *                 header for slc_<name>_list must be included too
+ *
+ * A vec owns its elements in storage, and data points at them. Slices are
+ * views: they share the data of the vec they were taken from and have no
+ * storage of their own, so taking one is O(1). Reductions hand the whole
+ * of data to the slc_reduce_<name>_* kernels.
+ */
+#ifndef ASW__SLC__RUNTIME__SLC_VEC_H_
+#error "include the public header for the vec type before slc_vec_impl.h"
+#endif
+
+#include <asw/runtime/slc_ptr_list.h>
+#include <asw/runtime/slc_ptr_vec.h>
+#include <asw/runtime/slc_reduce.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLC_VEC SLC_VEC_CAT(slc_, SLC_VEC_NAME, _vec)
+#define SLC_VEC_FN(fn) SLC_VEC_CAT(SLC_VEC, _, fn)
+#define SLC_VEC_REDUCE(fn) SLC_VEC_CAT(slc_reduce_, SLC_VEC_NAME, fn)
+#define SLC_VEC_LIST_FN(fn) SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list_ ## fn)
+
+struct SLC_VEC * SLC_VEC_FN(create)(size_t n)
+{
+  struct SLC_VEC * vec = calloc(1, sizeof(struct SLC_VEC) + n * sizeof(SLC_VEC_T));
+  if (NULL == vec) {
+    return NULL;
+  }
+  vec->len = n;
+  vec->cap = n;
+  vec->data = vec->storage;
+  return vec;
+}
+
+int8_t SLC_VEC_FN(destroy)(struct SLC_VEC * vec)
+{
+  if (NULL == vec) {
+    return 0;
+  }
+  free(vec);
+  return 1;
+}
+
+int64_t SLC_VEC_FN(length)(struct SLC_VEC * vec)
+{
+  return vec->len;
+}
+
+struct SLC_VEC * SLC_VEC_FN(slice)(struct SLC_VEC * vec, int64_t start, int64_t end)
+{
+  /* clamp to [0, len] so a slice never reaches outside of vec */
+  start = (start < 0) ? 0 : (start > vec->len) ? vec->len : start;
+  end = (end < start) ? start : (end > vec->len) ? vec->len : end;
+  struct SLC_VEC * view = malloc(sizeof(struct SLC_VEC));
+  if (NULL == view) {
+    return NULL;
+  }
+  view->len = end - start;
+  view->cap = 0;
+  view->data = vec->data + start;
+  return view;
+}
+
+struct SLC_VEC * SLC_VEC_FN(from_array)(const SLC_VEC_T * vals, size_t n)
+{
+  struct SLC_VEC * vec = SLC_VEC_FN(create)(n);
+  if (NULL == vec) {
+    return NULL;
+  }
+  memcpy(vec->data, vals, n * sizeof(SLC_VEC_T));
+  return vec;
+}
+
+#ifdef SLC_VEC_LIST
+struct SLC_VEC * SLC_VEC_FN(from_list)(struct SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list) * list)
+{
+  struct SLC_VEC * vec = SLC_VEC_FN(create)(SLC_VEC_LIST_FN(length)(list));
+  if (NULL == vec) {
+    return NULL;
+  }
+  SLC_VEC_LIST_FN(to_array)(list, vec->data);
+  return vec;
+}
+
+struct SLC_VEC_CAT(slc_, SLC_VEC_NAME, _list) * SLC_VEC_FN(to_list)(struct SLC_VEC * vec)
+{
+  return SLC_VEC_LIST_FN(from_array)(vec->data, vec->len);
+}
+
+struct slc_ptr_vec * SLC_VEC_FN(from_nested)(struct slc_ptr_list * list)
+{
+  size_t count = 0;
+  for (struct slc_ptr_list * iter = list; NULL != iter; iter = slc_ptr_list_cdr(iter)) {
+    count += SLC_VEC_LIST_FN(length)(slc_ptr_list_head(iter));
+  }
+  void * values;
+  struct slc_ptr_vec * vec =
+    slc_ptr_vec_csr(slc_ptr_list_length(list), count, sizeof(SLC_VEC_T), &values);
+  if (NULL == vec) {
+    return NULL;
+  }
+  SLC_VEC_T * next = values;
+  struct slc_vec_row * row = vec->data;
+  for (; NULL != list; list = slc_ptr_list_cdr(list), ++row) {
+    row->len = SLC_VEC_LIST_FN(to_array)(slc_ptr_list_head(list), next);
+    row->cap = 0;
+    row->data = next;
+    next += row->len;
+  }
+  return vec;
+}
+
+struct slc_ptr_list * SLC_VEC_FN(to_nested)(struct slc_ptr_vec * vec)
+{
+  struct slc_ptr_list * ret = slc_ptr_list_reserve(vec->len);
+  struct slc_ptr_list * iter = ret;
+  for (int64_t x = 0; x < vec->len; ++x, iter = slc_ptr_list_cdr(iter)) {
+    slc_ptr_list_set_head(
+      iter, SLC_VEC_LIST_FN(from_array)(vec->data[x].data, vec->data[x].len));
+  }
+  return ret;
+}
+#endif  /* SLC_VEC_LIST */
+
+SLC_VEC_T SLC_VEC_FN(add)(struct SLC_VEC * vec)
+{
+  return SLC_VEC_REDUCE(_sum)(vec->data, vec->len, 0);
+}
+
+SLC_VEC_T SLC_VEC_FN(subtract)(struct SLC_VEC * vec)
+{
+  if (0 == vec->len) {
+    return 0;
+  }
+  /* a - b - c - ... == a - (b + c + ...) */
+  return vec->data[0] - SLC_VEC_REDUCE(_sum)(vec->data + 1, vec->len - 1, 0);
+}
+
+SLC_VEC_T SLC_VEC_FN(multiply)(struct SLC_VEC * vec)
+{
+  if (0 == vec->len) {
+    return 0;
+  }
+  return SLC_VEC_REDUCE(_prod)(vec->data, vec->len, 1);
+}
+
+SLC_VEC_T SLC_VEC_FN(divide)(struct SLC_VEC * vec)
+{
+  if (0 == vec->len) {
+    return 0;
+  }
+  /* division doesn't reassociate, so this one stays sequential */
+  const SLC_VEC_T * data = vec->data;
+  SLC_VEC_T div = data[0];
+  for (int64_t x = 1; x < vec->len; ++x) {
+    div /= data[x];
+  }
+  return div;
+}
+
+SLC_VEC_T SLC_VEC_FN(min)(struct SLC_VEC * vec)
+{
+  if (0 == vec->len) {
+    return 0;
+  }
+  return SLC_VEC_REDUCE(_min)(vec->data + 1, vec->len - 1, vec->data[0]);
+}
+
+SLC_VEC_T SLC_VEC_FN(max)(struct SLC_VEC * vec)
+{
+  if (0 == vec->len) {
+    return 0;
+  }
+  return SLC_VEC_REDUCE(_max)(vec->data + 1, vec->len - 1, vec->data[0]);
+}
+
+int8_t SLC_VEC_CAT(print_, SLC_VEC, )(struct SLC_VEC * vec)
+{
+  printf("[");
+  for (int64_t x = 0; x < vec->len; ++x) {
+    printf(" " SLC_VEC_FMT, vec->data[x]);
+  }
+  printf(" ]\n");
+  return 1;
+}
+
+#undef SLC_VEC_LIST_FN
+#undef SLC_VEC_REDUCE
+#undef SLC_VEC_FN
+#undef SLC_VEC
+#undef SLC_VEC_FMT
+#undef SLC_VEC_LIST
+#undef SLC_VEC_T
+#undef SLC_VEC_NAME
@@ -0,0 +1,387 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <asw/llvm_codegen.hpp>
+
+namespace asw::slc::LLVM
+{
+
+namespace
+{
+/* how a runtime function takes or returns a value */
+enum class arg_kind
+{
+  PTR,   /* a list, vec, array, or function */
+  ELEM,  /* an element, in its storage type */
+  I64,
+  I8,
+  F64,
+};
+
+/* element types that a runtime function is provided for */
+enum elem_set : unsigned
+{
+  INT_ELEMS = 0x1,
+  FLOAT_ELEMS = 0x2,
+  BOOL_ELEMS = 0x4,
+  STRING_ELEMS = 0x8,
+  PTR_ELEMS = 0x10,
+  /* vecs of records, which the runtime only knows the size of */
+  RECORD_ELEMS = 0x20,
+  /* i8 through f32 */
+  SIZED_ELEMS = 0x40,
+  SYMBOL_ELEMS = 0x80,
+  NUMERIC_ELEMS = INT_ELEMS | FLOAT_ELEMS,
+  VEC_ELEMS = NUMERIC_ELEMS | BOOL_ELEMS,
+  /* what a list or vec can be reduced over */
+  ARITH_ELEMS = NUMERIC_ELEMS | SIZED_ELEMS,
+  ALL_ELEMS = VEC_ELEMS | SIZED_ELEMS | STRING_ELEMS | SYMBOL_ELEMS | PTR_ELEMS,
+  /* one element per cell, list<bool> is packed */
+  CELL_ELEMS = ALL_ELEMS & ~BOOL_ELEMS,
+  /* what a map or set can be keyed by */
+  KEY_ELEMS = NUMERIC_ELEMS | STRING_ELEMS | SYMBOL_ELEMS,
+};
+
+struct runtime_function
+{
+  type_id container;
+  runtime_op op;
+  /**
+   * symbol is slc_<element>_<list|vec|mat|map|set>_<suffix>, the element of a table is its
+   * key, and the string, symbol, pvec, queue, heap, and builder functions are just
+   * slc_<name>_<suffix>
+   */
+  const char * suffix;
+  unsigned elems;
+  arg_kind ret;
+  std::vector<arg_kind> args;
+};
+
+/* every entry point of the runtime's containers that the compiler calls */
+const std::vector<runtime_function> & runtime_functions()
+{
+  using k = arg_kind;
+  static const std::vector<runtime_function> table = {
+    /* utility */
+    {type_id::LIST, runtime_op::CREATE, "create", ALL_ELEMS, k::PTR, {}},
+    {type_id::LIST, runtime_op::DESTROY, "destroy", ALL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::INIT, "init", ALL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::FINI, "fini", ALL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::SET_HEAD, "set_head", ALL_ELEMS, k::I8, {k::PTR, k::ELEM}},
+    /* unary ops */
+    {type_id::LIST, runtime_op::HEAD, "head", ALL_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::CDR, "cdr", ALL_ELEMS, k::PTR, {k::PTR}},
+    /* the elements up to the end of a chunk, for the loops that are compiled inline */
+    {type_id::LIST, runtime_op::RUN, "run", ALL_ELEMS, k::PTR, {k::PTR, k::PTR, k::PTR, k::PTR}},
+    {type_id::LIST, runtime_op::LENGTH, "length", ALL_ELEMS, k::I64, {k::PTR}},
+    {type_id::LIST, runtime_op::COUNT, "count", BOOL_ELEMS, k::I64, {k::PTR}},
+    {type_id::LIST, runtime_op::NOT, "not", BOOL_ELEMS, k::PTR, {k::PTR}},
+    {type_id::LIST, runtime_op::COMPACT, "compact", INT_ELEMS, k::PTR, {k::PTR}},
+    /* binary ops */
+    {type_id::LIST, runtime_op::CONS, "cons", ALL_ELEMS, k::PTR, {k::ELEM, k::PTR}},
+    {type_id::LIST, runtime_op::APPEND, "append", ALL_ELEMS, k::PTR, {k::PTR, k::ELEM}},
+    /* list functions, map, filter, and fold are compiled inline instead */
+    {type_id::LIST, runtime_op::REVERSE, "reverse", CELL_ELEMS, k::PTR, {k::PTR}},
+    {type_id::LIST, runtime_op::NTH, "nth", CELL_ELEMS, k::ELEM, {k::PTR, k::I64}},
+    {type_id::LIST, runtime_op::TAKE, "take", CELL_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::LIST, runtime_op::DROP, "drop", CELL_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::LIST, runtime_op::CONCAT, "concat", CELL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::LIST, runtime_op::RANGE, "range", INT_ELEMS, k::PTR, {k::I64, k::I64}},
+    /* bulk construction */
+    {type_id::LIST, runtime_op::RESERVE, "reserve", ALL_ELEMS, k::PTR, {k::I64}},
+    {type_id::LIST, runtime_op::FROM_ARRAY, "from_array", ALL_ELEMS, k::PTR, {k::PTR, k::I64}},
+    /* the command line, read in place */
+    {type_id::LIST, runtime_op::FROM_ARGV, "from_argv", STRING_ELEMS, k::PTR, {k::I64, k::PTR}},
+    /* list ops */
+    {type_id::LIST, runtime_op::ADD, "add", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    /* joins the strings */
+    {type_id::LIST, runtime_op::ADD, "add", STRING_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::SUBTRACT, "subtract", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::MULTIPLY, "multiply", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::DIVIDE, "divide", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::MIN, "min", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::MAX, "max", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::LIST, runtime_op::AND, "and", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::OR, "or", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::XOR, "xor", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::LIST, runtime_op::MASK_AND, "mask_and", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::LIST, runtime_op::MASK_OR, "mask_or", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::LIST, runtime_op::MASK_XOR, "mask_xor", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    /* vecs */
+    {type_id::VEC, runtime_op::CREATE, "create", VEC_ELEMS | PTR_ELEMS | SIZED_ELEMS, k::PTR, {k::I64}},
+    {type_id::VEC, runtime_op::DESTROY, "destroy", VEC_ELEMS | PTR_ELEMS | SIZED_ELEMS, k::I8, {k::PTR}},
+    {type_id::VEC, runtime_op::LENGTH, "length", VEC_ELEMS | PTR_ELEMS | SIZED_ELEMS, k::I64, {k::PTR}},
+    {type_id::VEC, runtime_op::COUNT, "count", BOOL_ELEMS, k::I64, {k::PTR}},
+    {type_id::VEC, runtime_op::NOT, "not", BOOL_ELEMS, k::PTR, {k::PTR}},
+    {type_id::VEC, runtime_op::SLICE, "slice", VEC_ELEMS | PTR_ELEMS | SIZED_ELEMS, k::PTR, {k::PTR, k::I64, k::I64}},
+    {type_id::VEC, runtime_op::FROM_ARRAY, "from_array", VEC_ELEMS | SIZED_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::VEC, runtime_op::FROM_LIST, "from_list", VEC_ELEMS | SIZED_ELEMS, k::PTR, {k::PTR}},
+    {type_id::VEC, runtime_op::TO_LIST, "to_list", VEC_ELEMS | SIZED_ELEMS, k::PTR, {k::PTR}},
+    /* nested vecs, by the element type of their rows */
+    {type_id::VEC, runtime_op::FROM_NESTED, "from_nested", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::VEC, runtime_op::TO_NESTED, "to_nested", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::VEC, runtime_op::ADD, "add", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::SUBTRACT, "subtract", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::MULTIPLY, "multiply", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::DIVIDE, "divide", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::MIN, "min", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::MAX, "max", ARITH_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::VEC, runtime_op::AND, "and", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::VEC, runtime_op::OR, "or", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::VEC, runtime_op::XOR, "xor", BOOL_ELEMS, k::I8, {k::PTR}},
+    {type_id::VEC, runtime_op::MASK_AND, "mask_and", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::VEC, runtime_op::MASK_OR, "mask_or", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::VEC, runtime_op::MASK_XOR, "mask_xor", BOOL_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    /* vecs of records, by the size of a record or of each column */
+    {type_id::VEC, runtime_op::CREATE, "create", RECORD_ELEMS, k::PTR, {k::I64, k::I64}},
+    {type_id::VEC, runtime_op::CREATE_SOA, "create_soa", RECORD_ELEMS, k::PTR, {k::I64, k::I64, k::PTR}},
+    {type_id::VEC, runtime_op::DESTROY, "destroy", RECORD_ELEMS, k::I8, {k::PTR}},
+    {type_id::VEC, runtime_op::LENGTH, "length", RECORD_ELEMS, k::I64, {k::PTR}},
+    /* mats, the compiler reads the shape itself */
+    {type_id::MAT, runtime_op::CREATE, "create", NUMERIC_ELEMS, k::PTR, {k::I64, k::I64}},
+    {type_id::MAT, runtime_op::DESTROY, "destroy", NUMERIC_ELEMS, k::I8, {k::PTR}},
+    {type_id::MAT, runtime_op::NTH, "row", NUMERIC_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::MAT, runtime_op::FROM_NESTED, "from_nested", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::FROM_ROWS, "from_rows", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::TO_NESTED, "to_nested", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::TRANSPOSE, "transpose", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::MATMUL, "matmul", NUMERIC_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::MAT, runtime_op::ROW_SUMS, "row_sums", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::COL_SUMS, "col_sums", NUMERIC_ELEMS, k::PTR, {k::PTR}},
+    {type_id::MAT, runtime_op::ADD, "add", NUMERIC_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::MAT, runtime_op::MULTIPLY, "multiply", NUMERIC_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::MAT, runtime_op::MIN, "min", NUMERIC_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::MAT, runtime_op::MAX, "max", NUMERIC_ELEMS, k::ELEM, {k::PTR}},
+    /* maps and sets, a map's value is passed as its 64 bits, the compiler loops over the slots */
+    {type_id::MAP, runtime_op::CREATE, "create", KEY_ELEMS, k::PTR, {}},
+    {type_id::MAP, runtime_op::DESTROY, "destroy", KEY_ELEMS, k::I8, {k::PTR}},
+    {type_id::MAP, runtime_op::PUT, "put", KEY_ELEMS, k::PTR, {k::PTR, k::ELEM, k::I64}},
+    {type_id::MAP, runtime_op::GET, "get", KEY_ELEMS, k::I64, {k::PTR, k::ELEM}},
+    {type_id::MAP, runtime_op::HAS, "has", KEY_ELEMS, k::I8, {k::PTR, k::ELEM}},
+    {type_id::MAP, runtime_op::REMOVE, "remove", KEY_ELEMS, k::I8, {k::PTR, k::ELEM}},
+    {type_id::SET, runtime_op::CREATE, "create", KEY_ELEMS, k::PTR, {}},
+    {type_id::SET, runtime_op::DESTROY, "destroy", KEY_ELEMS, k::I8, {k::PTR}},
+    {type_id::SET, runtime_op::PUT, "put", KEY_ELEMS, k::PTR, {k::PTR, k::ELEM}},
+    {type_id::SET, runtime_op::HAS, "has", KEY_ELEMS, k::I8, {k::PTR, k::ELEM}},
+    {type_id::SET, runtime_op::REMOVE, "remove", KEY_ELEMS, k::I8, {k::PTR, k::ELEM}},
+    {type_id::SET, runtime_op::FROM_LIST, "from_list", KEY_ELEMS, k::PTR, {k::PTR}},
+    {type_id::SET, runtime_op::FROM_ARRAY, "from_array", NUMERIC_ELEMS, k::PTR, {k::PTR, k::I64}},
+    /* pvecs, an element is passed as its 64 bits so they are declared once, by int */
+    {type_id::PVEC, runtime_op::RESERVE, "reserve", INT_ELEMS, k::PTR, {k::I64}},
+    {type_id::PVEC, runtime_op::NTH, "nth", INT_ELEMS, k::I64, {k::PTR, k::I64}},
+    {type_id::PVEC, runtime_op::ASSOC, "assoc", INT_ELEMS, k::PTR, {k::PTR, k::I64, k::I64}},
+    {type_id::PVEC, runtime_op::PUSH, "push", INT_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::PVEC, runtime_op::SLICE, "slice", INT_ELEMS, k::PTR, {k::PTR, k::I64, k::I64}},
+    {type_id::PVEC, runtime_op::CONCAT, "concat", INT_ELEMS, k::PTR, {k::PTR, k::PTR}},
+    {type_id::PVEC, runtime_op::LEAF, "leaf", INT_ELEMS, k::PTR, {k::PTR, k::I64, k::PTR}},
+    /* queues and heaps, the same way, a heap's element as an int64_t that orders like it */
+    {type_id::QUEUE, runtime_op::CREATE, "create", INT_ELEMS, k::PTR, {}},
+    {type_id::QUEUE, runtime_op::PUSH, "push", INT_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::QUEUE, runtime_op::POP, "pop", INT_ELEMS, k::I64, {k::PTR}},
+    {type_id::QUEUE, runtime_op::PEEK, "peek", INT_ELEMS, k::I64, {k::PTR}},
+    {type_id::HEAP, runtime_op::CREATE, "create", INT_ELEMS, k::PTR, {k::I8}},
+    {type_id::HEAP, runtime_op::PUSH, "push", INT_ELEMS, k::PTR, {k::PTR, k::I64}},
+    {type_id::HEAP, runtime_op::POP, "pop", INT_ELEMS, k::I64, {k::PTR}},
+    {type_id::HEAP, runtime_op::PEEK, "peek", INT_ELEMS, k::I64, {k::PTR}},
+    /* string builders, by the string element like the strings they are made of */
+    {type_id::BUILDER, runtime_op::CREATE, "create", STRING_ELEMS, k::PTR, {}},
+    {type_id::BUILDER, runtime_op::PUSH, "push", STRING_ELEMS, k::PTR, {k::PTR, k::ELEM}},
+    {type_id::BUILDER, runtime_op::TO_STRING, "string", STRING_ELEMS, k::ELEM, {k::PTR}},
+    {type_id::BUILDER, runtime_op::LENGTH, "length", STRING_ELEMS, k::I64, {k::PTR}},
+    /* strings and symbols, by the string element so they are declared once */
+    {type_id::STRING, runtime_op::COMPARE, "compare", STRING_ELEMS, k::I64, {k::ELEM, k::ELEM}},
+    {type_id::STRING, runtime_op::CONCAT, "concat", STRING_ELEMS, k::ELEM, {k::PTR, k::I64}},
+    {type_id::STRING, runtime_op::LENGTH, "length", STRING_ELEMS, k::I64, {k::ELEM}},
+    {type_id::STRING, runtime_op::FROM_INT, "from_int", STRING_ELEMS, k::ELEM, {k::I64}},
+    {type_id::STRING, runtime_op::FROM_FLOAT, "from_double", STRING_ELEMS, k::ELEM, {k::F64}},
+    {type_id::STRING, runtime_op::TO_INT, "to_int", STRING_ELEMS, k::I64, {k::ELEM}},
+    {type_id::STRING, runtime_op::TO_FLOAT, "to_double", STRING_ELEMS, k::F64, {k::ELEM}},
+    {type_id::SYMBOL, runtime_op::INTERN, "intern", STRING_ELEMS, k::ELEM, {k::ELEM}},
+    {type_id::SYMBOL, runtime_op::INTERN_STATIC, "intern_static", STRING_ELEMS, k::ELEM, {k::ELEM}},
+  };
+  return table;
+}
+
+/* the runtime's name for an element type, nullptr if it has no runtime */
+const char * runtime_elem_name(const type_id elem)
+{
+  switch (elem) {
+    case type_id::INT:
+      return "int";
+    case type_id::FLOAT:
+      return "double";
+    case type_id::I8:
+      return "i8";
+    case type_id::I16:
+      return "i16";
+    case type_id::I32:
+      return "i32";
+    case type_id::U32:
+      return "u32";
+    case type_id::U64:
+      return "u64";
+    case type_id::F32:
+      return "f32";
+    case type_id::BOOL:
+      return "bool";
+    case type_id::STRING:
+      return "string";
+    case type_id::SYMBOL:
+      return "symbol";
+    case type_id::LIST:
+    case type_id::VEC:
+    case type_id::MAT:
+      /* nested containers are stored by pointer */
+      return "ptr";
+    case type_id::RECORD:
+      return "record";
+    default:
+      return nullptr;
+  }
+}
+
+unsigned runtime_elem_set(const type_id elem)
+{
+  switch (elem) {
+    case type_id::INT:
+      return INT_ELEMS;
+    case type_id::FLOAT:
+      return FLOAT_ELEMS;
+    case type_id::I8:
+    case type_id::I16:
+    case type_id::I32:
+    case type_id::U32:
+    case type_id::U64:
+    case type_id::F32:
+      return SIZED_ELEMS;
+    case type_id::BOOL:
+      return BOOL_ELEMS;
+    case type_id::STRING:
+      return STRING_ELEMS;
+    case type_id::SYMBOL:
+      return SYMBOL_ELEMS;
+    case type_id::LIST:
+    case type_id::VEC:
+    case type_id::MAT:
+      return PTR_ELEMS;
+    case type_id::RECORD:
+      return RECORD_ELEMS;
+    default:
+      return 0;
+  }
+}
+
+std::string runtime_symbol(const runtime_function & f, const type_id elem)
+{
+  if (f.container == type_id::STRING || f.container == type_id::SYMBOL ||
+    f.container == type_id::PVEC || f.container == type_id::QUEUE ||
+    f.container == type_id::HEAP || f.container == type_id::BUILDER)
+  {
+    return "slc_" + type_id_to_str(f.container) + "_" + f.suffix;
+  }
+  const char * container = (f.container == type_id::VEC) ? "_vec_" :
+    (f.container == type_id::MAT) ? "_mat_" : (f.container == type_id::MAP) ? "_map_" :
+    (f.container == type_id::SET) ? "_set_" : "_list_";
+  return std::string("slc_") + runtime_elem_name(elem) + container + f.suffix;
+}
+}  // namespace
+
+void codegen::_insert_runtime_functions() const
+{
+  const type_id elems[] = {
+    type_id::INT, type_id::FLOAT, type_id::BOOL, type_id::STRING, type_id::SYMBOL, type_id::LIST,
+    type_id::RECORD,
+    type_id::I8, type_id::I16, type_id::I32, type_id::U32, type_id::U64, type_id::F32,
+  };
+  for (const type_id elem : elems) {
+    auto to_llvm = [&](arg_kind kind) -> llvm::Type * {
+        switch (kind) {
+          case arg_kind::PTR:
+            return llvm::PointerType::get(*context_, 0);
+          case arg_kind::ELEM:
+            return _elem_storage_type(elem);
+          case arg_kind::I64:
+            return llvm::Type::getInt64Ty(*context_);
+          case arg_kind::I8:
+            return llvm::Type::getInt8Ty(*context_);
+          case arg_kind::F64:
+            return llvm::Type::getDoubleTy(*context_);
+        }
+        return nullptr;
+      };
+    for (const runtime_function & f : runtime_functions()) {
+      if (0 == (f.elems & runtime_elem_set(elem))) {
+        continue;
+      }
+      std::vector<llvm::Type *> args;
+      for (arg_kind kind : f.args) {
+        args.push_back(to_llvm(kind));
+      }
+      llvm::Function::Create(
+        llvm::FunctionType::get(to_llvm(f.ret), args, false),
+        llvm::Function::ExternalLinkage, runtime_symbol(f, elem), module_.get());
+    }
+  }
+}
+
+llvm::Function * codegen::_runtime_function(
+  const type_id container, const type_id elem, const runtime_op op) const
+{
+  for (const runtime_function & f : runtime_functions()) {
+    if (f.container == container && f.op == op && 0 != (f.elems & runtime_elem_set(elem))) {
+      return module_->getFunction(runtime_symbol(f, elem));
+    }
+  }
+  return nullptr;
+}
+
+llvm::Value * codegen::_call_runtime(
+  const type_id container, const type_id elem, const runtime_op op,
+  std::vector<llvm::Value *> args, const std::string & name) const
+{
+  llvm::Function * func = _runtime_function(container, elem, op);
+  if (nullptr == func) {
+    return LogErrorV(
+      ("no runtime support for " + type_id_to_str(container) + "<" +
+      type_id_to_str(elem) + "> here").c_str());
+  }
+  return builder_->CreateCall(func, args, name);
+}
+
+llvm::Type * codegen::_elem_storage_type(const type_id elem) const
+{
+  /* bools are a byte in memory, i1 is only used for values */
+  if (elem == type_id::BOOL) {
+    return llvm::Type::getInt8Ty(*context_);
+  }
+  return _type_id_to_llvm(elem);
+}
+
+llvm::Value * codegen::_to_storage(llvm::Value * val, const type_id elem) const
+{
+  if (elem == type_id::BOOL) {
+    return builder_->CreateZExt(val, llvm::Type::getInt8Ty(*context_), "boolbyte");
+  }
+  return val;
+}
+
+llvm::Value * codegen::_from_storage(llvm::Value * val, const type_id elem) const
+{
+  if (elem == type_id::BOOL) {
+    return builder_->CreateICmpNE(val, llvm::ConstantInt::get(val->getType(), 0), "boolval");
+  }
+  return val;
+}
+
+}  // namespace asw::slc::LLVM
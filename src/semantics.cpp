@@ -33,6 +33,10 @@ bool SemanticAnalyzer::visit(node * const n) const
   n->mark_visiting();
   bool ret = n->accept(this);
   n->mark_visited();
+  if (ret && n->is_root()) {
+    /* lambda parameters can only be checked once every call passing them is seen */
+    ret = check_dynamic_calls();
+  }
   return ret;
 }
 
@@ -52,6 +56,93 @@ bool SemanticAnalyzer::visit_children(node * const n) const
 }
 
 
+bool SemanticAnalyzer::check_function_argument(
+  op_id op, expression * const fn, const std::vector<type_info *> & params,
+  type_info * const ret) const
+{
+  const std::string name = op_to_str(op);
+  lambda * const resolved = resolve_lambda(fn);
+  if (nullptr == resolved) {
+    error("'%s' expects a lambda as its function\n", fn, name.c_str());
+    return false;
+  } else if (resolved->get_formals().size() != params.size()) {
+    error(
+      "lambda passed to '%s' takes '%zd' arguments, expected '%zd'\n",
+      fn, name.c_str(), resolved->get_formals().size(), params.size());
+    return false;
+  }
+  for (std::size_t x = 0; x < params.size(); ++x) {
+    /* the runtime passes elements as they are stored, so the types must match */
+    if (*params[x] != *resolved->get_formals()[x]->get_type()) {
+      error(
+        "invalid argument for lambda passed to '%s': got '%s' expected '%s'\n",
+        fn, name.c_str(), type_to_str(params[x]).c_str(),
+        type_to_str(resolved->get_formals()[x]->get_type()).c_str());
+      return false;
+    }
+  }
+  if (nullptr != ret && *ret != *resolved->get_type()) {
+    error(
+      "lambda passed to '%s' returns '%s', expected '%s'\n",
+      fn, name.c_str(), type_to_str(resolved->get_type()).c_str(), type_to_str(ret).c_str());
+    return false;
+  }
+  return true;
+}
+
+bool SemanticAnalyzer::check_table_type(node * const n, type_info * const t) const
+{
+  const type_id key = t->subtype->type;
+  if (t->type == type_id::HEAP) {
+    /* a heap orders its elements as numbers */
+    if (key != type_id::INT && key != type_id::FLOAT) {
+      error(
+        "cannot make '%s', the elements of a heap are int or float\n", n, type_to_str(t).c_str());
+      return false;
+    }
+    return true;
+  } else if (t->type != type_id::QUEUE && key != type_id::INT && key != type_id::FLOAT &&
+    key != type_id::STRING && key != type_id::SYMBOL)
+  {
+    error(
+      "cannot make '%s', the keys of a map or set are int, float, string, or symbol\n",
+      n, type_to_str(t).c_str());
+    return false;
+  } else if (t->type != type_id::MAP && t->type != type_id::QUEUE) {
+    return true;
+  }
+  /* the runtime keeps a map's value or a queue's element in 64 bits, a number or a pointer */
+  const type_id val = (t->type == type_id::MAP) ? t->elems[0].type : key;
+  if ((!is_numeric(val) || is_sized(val)) && val != type_id::BOOL && val != type_id::STRING &&
+    val != type_id::SYMBOL && val != type_id::LIST && val != type_id::VEC && val != type_id::MAT &&
+    val != type_id::MAP && val != type_id::SET)
+  {
+    error(
+      "cannot make '%s', a %s can't hold '%s'\n",
+      n, type_to_str(t).c_str(), type_id_to_str(t->type).c_str(), type_id_to_str(val).c_str());
+    return false;
+  }
+  return true;
+}
+
+bool SemanticAnalyzer::check_table_argument(
+  op_id op, expression * const arg, type_info * const table_t, bool value) const
+{
+  type_info * to = value ? &table_t->elems[0] : table_t->subtype;
+  type_info * from = arg->get_type();
+  /* numbers are converted to the key or value type, anything else has to match */
+  if (is_numeric(to->type) ? !is_numeric(from->type) : (*from != *to)) {
+    error(
+      "cannot convert type '%s' to '%s' for %s in '%s'\n",
+      arg, type_to_str(from).c_str(), type_to_str(to).c_str(),
+      value ? "a value" :
+      table_t->compatible(table_t->type, type_id::QUEUE, type_id::HEAP, type_id::BUILDER) ?
+      "an element" : "a key", op_to_str(op).c_str());
+    return false;
+  }
+  return true;
+}
+
 bool SemanticAnalyzer::visit_binary_op(binary_op * const op) const
 {
   if (!visit_children(op)) {
@@ -59,11 +150,21 @@ bool SemanticAnalyzer::visit_binary_op(binary_op * const op) const
   }
   expression * lhs = dynamic_cast<expression *>(op->get_children()[0]);
   expression * rhs = dynamic_cast<expression *>(op->get_children()[1]);
-  auto is_int = [](expression * expr) -> bool {return expr->get_type()->type == type_id::INT;};
-  auto is_float =
-    [](expression * expr) -> bool {return expr->get_type()->type == type_id::FLOAT;};
+  auto is_number = [](expression * expr) -> bool {return is_numeric(expr->get_type()->type);};
   auto is_list = [](expression * expr) -> bool {return expr->get_type()->type == type_id::LIST;};
   auto is_nil = [](expression * expr) -> bool {return expr->get_type()->type == type_id::NIL;};
+  /* list functions take any list but list<bool>, whose elements are packed */
+  auto check_list = [this, op, &is_list](expression * expr) -> bool {
+      if (!is_list(expr) || expr->get_type()->subtype->type == type_id::BOOL) {
+        error(
+          "attempted %s operation on type '%s', expected a list of int, float, string, or list\n",
+          op, op_to_str(op->get_op()).c_str(), type_to_str(expr->get_type()).c_str());
+        return false;
+      }
+      return true;
+    };
+  type_info int_t;
+  int_t.type = type_id::INT;
   switch (op->get_op()) {
     case op_id::GREATER:
     case op_id::GREATER_EQ:
@@ -71,7 +172,39 @@ bool SemanticAnalyzer::visit_binary_op(binary_op * const op) const
     case op_id::LESS_EQ:
     case op_id::EQUAL:
       {
-        if (((is_int(lhs) && is_float(rhs)) || (is_int(rhs) && is_float(lhs)))) {
+        if (lhs->get_type()->compatible(lhs->get_type()->type, type_id::RECORD, type_id::TUPLE) ||
+          rhs->get_type()->compatible(rhs->get_type()->type, type_id::RECORD, type_id::TUPLE))
+        {
+          error(
+            "invalid operands for binary operator '%s', records and tuples can't be compared\n",
+            op, op_to_str(op->get_op()).c_str());
+          return false;
+        } else if (lhs->get_type()->type == type_id::SYMBOL ||
+          rhs->get_type()->type == type_id::SYMBOL)
+        {
+          /* symbols are interned, so only identity means anything */
+          if (op->get_op() != op_id::EQUAL || lhs->get_type()->type != rhs->get_type()->type) {
+            error(
+              "invalid operands for binary operator '%s', symbols only compare with '=' to "
+              "symbols\n", op, op_to_str(op->get_op()).c_str());
+            return false;
+          }
+          op->set_type(type_id::BOOL);
+          return true;
+        } else if (lhs->get_type()->type == type_id::SIMD) {
+          /* lane by lane, into a vector of bools, a scalar rhs is compared with every lane */
+          if (!rhs->get_type()->converts_to(lhs->get_type())) {
+            error(
+              "cannot compare '%s' with '%s'\n",
+              op, type_to_str(lhs->get_type()).c_str(), type_to_str(rhs->get_type()).c_str());
+            return false;
+          }
+          type_info * type = new type_info(*lhs->get_type());
+          type->subtype->type = type_id::BOOL;
+          op->set_type(type);
+          return true;
+        } else if (is_number(lhs) && is_number(rhs)) {
+          /* compared as the type of lhs */
           op->set_type(type_id::BOOL);
           return true;
         } else if ((is_nil(lhs) && is_list(rhs)) || (is_nil(rhs) && is_list(lhs))) {
@@ -103,6 +236,182 @@ bool SemanticAnalyzer::visit_binary_op(binary_op * const op) const
         op->set_type(new type_info(*rhs->get_type()));
         return true;
       }
+    case op_id::NTH:
+    case op_id::TAKE:
+    case op_id::DROP:
+      {
+        if (op->get_op() == op_id::NTH &&
+          (lhs->get_type()->type == type_id::VEC || lhs->get_type()->type == type_id::MAT ||
+          lhs->get_type()->type == type_id::SIMD || lhs->get_type()->type == type_id::PVEC))
+        {
+          /* indexed directly */
+        } else if (!check_list(lhs)) {
+          return false;
+        }
+        if (!rhs->get_type()->converts_to(&int_t)) {
+          error(
+            "cannot convert type '%s' to 'int' for count in '%s'\n",
+            rhs, type_to_str(rhs->get_type()).c_str(), op_to_str(op->get_op()).c_str());
+          return false;
+        }
+        if (op->get_op() == op_id::NTH && lhs->get_type()->type == type_id::MAT) {
+          /* a row of a mat is a vec */
+          type_info * type = new type_info(*lhs->get_type());
+          type->type = type_id::VEC;
+          op->set_type(type);
+        } else if (op->get_op() == op_id::NTH) {
+          op->set_type(new type_info(*lhs->get_type()->subtype));
+        } else {
+          op->set_type(new type_info(*lhs->get_type()));
+        }
+        return true;
+      }
+    case op_id::CONCAT:
+      {
+        if (lhs->get_type()->type == type_id::PVEC) {
+          /* shares the nodes of both */
+        } else if (!check_list(lhs) || !check_list(rhs)) {
+          return false;
+        }
+        if (*lhs->get_type() != *rhs->get_type()) {
+          error(
+            "cannot concat '%s' and '%s'\n",
+            op, type_to_str(lhs->get_type()).c_str(), type_to_str(rhs->get_type()).c_str());
+          return false;
+        }
+        op->set_type(new type_info(*lhs->get_type()));
+        return true;
+      }
+    case op_id::RANGE:
+      {
+        if (!lhs->get_type()->converts_to(&int_t) || !rhs->get_type()->converts_to(&int_t)) {
+          error("range bounds must be integers\n", op);
+          return false;
+        }
+        type_info * type = new type_info();
+        type->type = type_id::LIST;
+        type->subtype = new type_info(int_t);
+        op->set_type(type);
+        return true;
+      }
+    case op_id::MATMUL:
+      {
+        if (lhs->get_type()->type != type_id::MAT || *lhs->get_type() != *rhs->get_type()) {
+          error(
+            "cannot matmul '%s' and '%s', expected two mats of the same element type\n",
+            op, type_to_str(lhs->get_type()).c_str(), type_to_str(rhs->get_type()).c_str());
+          return false;
+        }
+        op->set_type(new type_info(*lhs->get_type()));
+        return true;
+      }
+    case op_id::LOOKUP:
+    case op_id::HAS:
+    case op_id::REMOVE:
+      {
+        type_info * table_t = lhs->get_type();
+        if (op->get_op() == op_id::LOOKUP ? table_t->type != type_id::MAP :
+          !table_t->compatible(table_t->type, type_id::MAP, type_id::SET))
+        {
+          error(
+            "attempted %s operation on type '%s', expected a %s\n",
+            op, op_to_str(op->get_op()).c_str(), type_to_str(table_t).c_str(),
+            (op->get_op() == op_id::LOOKUP) ? "map" : "map or set");
+          return false;
+        } else if (!check_table_argument(op->get_op(), rhs, table_t, false)) {
+          return false;
+        }
+        /* a missing key looks up the zero of the value type */
+        if (op->get_op() == op_id::LOOKUP) {
+          op->set_type(new type_info(table_t->elems[0]));
+        } else {
+          op->set_type(type_id::BOOL);
+        }
+        return true;
+      }
+    case op_id::PUSH:
+      {
+        /* a new pvec, or the same queue, heap, or builder with the element added in place */
+        type_info * to_t = lhs->get_type();
+        if (!to_t->compatible(
+            to_t->type, type_id::PVEC, type_id::QUEUE, type_id::HEAP, type_id::BUILDER))
+        {
+          error(
+            "attempted push operation on type '%s', expected a pvec, queue, heap, or builder\n",
+            op, type_to_str(to_t).c_str());
+          return false;
+        } else if (to_t->type == type_id::BUILDER &&
+          !rhs->get_type()->compatible(rhs->get_type()->type, type_id::STRING, type_id::SYMBOL))
+        {
+          /* numbers would read as strings otherwise, but a builder only copies text */
+          error(
+            "cannot push type '%s' onto a builder, convert it with (string x) first\n",
+            rhs, type_to_str(rhs->get_type()).c_str());
+          return false;
+        } else if (!rhs->get_type()->converts_to(to_t->subtype)) {
+          error(
+            "cannot convert type '%s' to '%s' in 'push'\n",
+            rhs, type_to_str(rhs->get_type()).c_str(), type_to_str(to_t->subtype).c_str());
+          return false;
+        }
+        op->set_type(new type_info(*to_t));
+        return true;
+      }
+    case op_id::MAP:
+    case op_id::FILTER:
+      {
+        if (op->get_op() == op_id::MAP && rhs->get_type()->type == type_id::MAT) {
+          /* elementwise, into a mat of the same shape */
+          if (!check_function_argument(op->get_op(), lhs, {rhs->get_type()->subtype})) {
+            return false;
+          }
+          type_info * ret_t = resolve_lambda(lhs)->get_type();
+          if (ret_t->type != type_id::INT && ret_t->type != type_id::FLOAT) {
+            error(
+              "lambda passed to 'map' returns '%s', but a mat only holds int or float\n",
+              lhs, type_to_str(ret_t).c_str());
+            return false;
+          }
+          type_info * type = new type_info(*rhs->get_type());
+          *type->subtype = *ret_t;
+          op->set_type(type);
+          return true;
+        }
+        /* both are compiled into a loop around the lambda's body, so any list works */
+        if (!is_list(rhs)) {
+          error(
+            "attempted %s operation on non-list type '%s'\n",
+            op, op_to_str(op->get_op()).c_str(), type_to_str(rhs->get_type()).c_str());
+          return false;
+        }
+        type_info * elem_t = rhs->get_type()->subtype;
+        if (op->get_op() == op_id::FILTER) {
+          type_info bool_t;
+          bool_t.type = type_id::BOOL;
+          if (!check_function_argument(op->get_op(), lhs, {elem_t}, &bool_t)) {
+            return false;
+          }
+          op->set_type(new type_info(*rhs->get_type()));
+          return true;
+        } else if (!check_function_argument(op->get_op(), lhs, {elem_t})) {
+          return false;
+        }
+        /* map may change the element type to anything a list can hold */
+        type_info * ret_t = resolve_lambda(lhs)->get_type();
+        if (!is_numeric(ret_t->type) &&
+          ret_t->type != type_id::BOOL && ret_t->type != type_id::STRING &&
+          ret_t->type != type_id::SYMBOL && ret_t->type != type_id::LIST)
+        {
+          error(
+            "lambda passed to 'map' returns '%s', which can't be a list element\n",
+            lhs, type_to_str(ret_t).c_str());
+          return false;
+        }
+        type_info * type = new type_info(*rhs->get_type());
+        *type->subtype = *ret_t;
+        op->set_type(type);
+        return true;
+      }
     default:
       debug("operator\n", op);
       internal_compiler_error("operator is not a binary operator\n");
@@ -158,8 +467,20 @@ bool SemanticAnalyzer::visit_function_call(function_call * const call_) const
     return false;
   }
 
+  if (resolved_->is_record_definition()) {
+    return visit_record_construction(call_, resolved_->as_record_definition());
+  } else if (resolved_->is_function_definition() &&
+    resolved_->as_function_definition()->is_generic())
+  {
+    resolved_ = instantiate(call_, resolved_->as_function_definition());
+    if (nullptr == resolved_) {
+      return false;
+    }
+  }
   callable * resolved = nullptr;
-  if (resolved_->is_variable_definition()) {
+  if (resolved_->is_formal()) {
+    return visit_dynamic_call(call_, resolved_->as_formal());
+  } else if (resolved_->is_variable_definition()) {
     if (!resolved_->get_children()[0]->is_lambda()) {
       /* expected a lambda */
       error("attempted to call a variable as a function\n", call_);
@@ -186,9 +507,15 @@ bool SemanticAnalyzer::visit_function_call(function_call * const call_) const
   }
   /* check types on arguments */
   for (std::size_t x = 0; x < resolved->get_formals().size(); ++x) {
-    if (!call_->get_children()[x]->accept(this)) {
+    if (!visit(call_->get_children()[x])) {
       return false;
     }
+    if (resolved->get_formals()[x]->get_type()->type == type_id::LAMBDA) {
+      if (!check_lambda_argument(call_, x, resolved->get_formals()[x])) {
+        return false;
+      }
+      continue;
+    }
     if (!call_->get_children()[x]->get_type()->converts_to(resolved->get_formals()[x]->get_type()))
     {
       error(
@@ -252,6 +579,174 @@ bool SemanticAnalyzer::visit_function_call(function_call * const call_) const
   return true;
 }
 
+bool SemanticAnalyzer::visit_record_construction(
+  function_call * const call_, record_definition * const rec) const
+{
+  /* (R v0 v1 ...) makes a record, with the values of its fields in order */
+  if (call_->get_children().size() != rec->get_fields().size()) {
+    error(
+      "wrong number of fields for record '%s': got '%zd' expected '%zd'\n",
+      call_, rec->get_name().c_str(), call_->get_children().size(), rec->get_fields().size());
+    return false;
+  }
+  for (std::size_t x = 0; x < rec->get_fields().size(); ++x) {
+    node * const value = call_->get_children()[x];
+    if (!visit(value)) {
+      return false;
+    } else if (!value->get_type()->converts_to(rec->get_fields()[x]->get_type())) {
+      error(
+        "invalid value for field '%s' of record '%s': got '%s' expected '%s'\n",
+        value, rec->get_fields()[x]->get_name().c_str(), rec->get_name().c_str(),
+        type_to_str(value->get_type()).c_str(),
+        type_to_str(rec->get_fields()[x]->get_type()).c_str());
+      return false;
+    }
+  }
+  call_->resolve_record(rec);
+  call_->set_type(new type_info(*rec->get_type()));
+  return true;
+}
+
+record_definition * SemanticAnalyzer::find_record(
+  const std::string & name, node * const from) const
+{
+  node * parent = from;
+  for (; nullptr != parent && nullptr == parent->get_scope(); parent = parent->get_parent()) {
+    /* find the nearest scope */
+  }
+  record_definition * rec = nullptr;
+  for (scope * s = (nullptr == parent) ? nullptr : parent->get_scope().get();
+    nullptr != s && !scope_has_record(name, s, &rec); s = s->parent.get())
+  {
+    /* search this scope, then the ones around it */
+  }
+  return rec;
+}
+
+void SemanticAnalyzer::resolve_record_types(
+  type_info * const t, node * const from, const std::vector<std::string> & known) const
+{
+  /* a named type is parsed as a type parameter, unless it names a record */
+  for (type_info * iter = t; nullptr != iter; iter = iter->subtype) {
+    if (iter->type == type_id::VARIABLE && !iter->name.empty() &&
+      std::find(known.begin(), known.end(), iter->name) == known.end() &&
+      nullptr != find_record(iter->name, from))
+    {
+      iter->type = type_id::RECORD;
+    }
+    for (type_info & elem : iter->elems) {
+      resolve_record_types(&elem, from, known);
+    }
+  }
+}
+
+bool SemanticAnalyzer::visit_dynamic_call(function_call * const call_, formal * const param) const
+{
+  if (param->get_type()->type != type_id::LAMBDA) {
+    error("attempted to call a variable as a function\n", call_);
+    return false;
+  } else if (nullptr == param->get_type()->subtype) {
+    error(
+      "cannot call '%s' without knowing what it returns, declare it as lambda<T>\n",
+      call_, call_->get_name().c_str());
+    return false;
+  }
+  if (!visit_children(call_)) {
+    return false;
+  }
+  /* the arguments are checked against each lambda that reaches param, after every call is seen */
+  call_->resolve_dynamic(param);
+  dynamic_calls_.push_back(call_);
+  call_->set_type(new type_info(*param->get_type()->subtype));
+  return true;
+}
+
+bool SemanticAnalyzer::check_lambda_argument(
+  function_call * const call_, std::size_t x, formal * const param, bool * added) const
+{
+  expression * const arg = call_->get_children()[x]->as_expression();
+  type_info * const ret = param->get_type()->subtype;
+  bool is_new = false;
+  if (lambda * const fn = resolve_lambda(arg); nullptr != fn) {
+    if (nullptr != ret && *fn->get_type() != *ret) {
+      error(
+        "invalid argument passed to function '%s': lambda returns '%s' expected '%s'\n",
+        arg, call_->get_name().c_str(), type_to_str(fn->get_type()).c_str(),
+        type_to_str(ret).c_str());
+      return false;
+    }
+    is_new = param->add_source(fn);
+  } else {
+    /* otherwise it has to be passed along from another lambda parameter */
+    variable * const var = dynamic_cast<variable *>(arg);
+    formal * const from = (nullptr != var && nullptr != var->get_resolution() &&
+      var->get_resolution()->is_formal()) ? var->get_resolution()->as_formal() : nullptr;
+    if (nullptr == from || from->get_type()->type != type_id::LAMBDA) {
+      error(
+        "invalid argument passed to function '%s': got '%s' expected a lambda\n",
+        arg, call_->get_name().c_str(), type_to_str(arg->get_type()).c_str());
+      return false;
+    } else if (nullptr != ret && (nullptr == from->get_type()->subtype ||
+      *from->get_type()->subtype != *ret))
+    {
+      error(
+        "invalid argument passed to function '%s': got '%s' expected '%s'\n",
+        arg, call_->get_name().c_str(), type_to_str(from->get_type()).c_str(),
+        type_to_str(param->get_type()).c_str());
+      return false;
+    }
+    is_new = param->add_source(from);
+  }
+  if (nullptr != added) {
+    *added = *added || is_new;
+  }
+  return true;
+}
+
+bool SemanticAnalyzer::check_dynamic_calls() const
+{
+  /**
+   * Every lambda that reaches a call through a parameter has to take its
+   * arguments. Lambdas passed along by those calls reach further
+   * parameters, so this runs until no parameter gains a new source.
+   */
+  auto is_scalar = [](const type_info * t) -> bool {
+      return is_numeric(t->type) || t->type == type_id::BOOL;
+    };
+  for (bool added = true; added; ) {
+    added = false;
+    for (function_call * call_ : dynamic_calls_) {
+      for (lambda * fn : call_->get_dynamic_target()->get_targets()) {
+        if (fn->get_formals().size() != call_->get_children().size()) {
+          error(
+            "'%s' may be the lambda on line %d, which takes %zd arguments, got %zd\n",
+            call_, call_->get_name().c_str(), fn->get_location()->line,
+            fn->get_formals().size(), call_->get_children().size());
+          return false;
+        }
+        for (std::size_t x = 0; x < fn->get_formals().size(); ++x) {
+          type_info * const arg_t = call_->get_children()[x]->get_type();
+          type_info * const param_t = fn->get_formals()[x]->get_type();
+          if (param_t->type == type_id::LAMBDA) {
+            if (!check_lambda_argument(call_, x, fn->get_formals()[x], &added)) {
+              return false;
+            }
+          } else if (*arg_t != *param_t && !(is_scalar(arg_t) && is_scalar(param_t))) {
+            /* only scalars are converted at a call through a parameter */
+            error(
+              "invalid argument passed to '%s' (may be the lambda on line %d): "
+              "got '%s' expected '%s'\n",
+              call_->get_children()[x], call_->get_name().c_str(), fn->get_location()->line,
+              type_to_str(arg_t).c_str(), type_to_str(param_t).c_str());
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
 bool SemanticAnalyzer::visit_extern_function(extern_function * const func_) const
 {
   auto * parent = func_->get_parent();
@@ -307,6 +802,31 @@ bool SemanticAnalyzer::visit_function_definition(function_definition * const fun
   /* create new scope under the parent scope */
   func_->set_scope(std::make_shared<scope>());
   func_->get_scope()->parent = p_scope;
+  for (formal * param : func_->get_formals()) {
+    resolve_record_types(param->get_type(), func_, func_->get_type_params());
+    const std::string unknown = find_type_param(param->get_type(), func_->get_type_params());
+    if (!unknown.empty()) {
+      error("unknown type '%s' for parameter '%s'\n", param, unknown.c_str(),
+        param->get_name().c_str());
+      return false;
+    }
+  }
+  if ("main" == func_->get_name()) {
+    /* the entry point, codegen wraps it to take the command line */
+    const auto & formals = func_->get_formals();
+    const bool argc_ok = formals.size() < 1 || formals[0]->get_type()->type == type_id::INT;
+    const bool args_ok = formals.size() < 2 || (
+      formals[1]->get_type()->type == type_id::LIST &&
+      formals[1]->get_type()->subtype->type == type_id::STRING);
+    if (formals.size() > 2 || !argc_ok || !args_ok) {
+      error("'main' takes (argc: int) or (argc: int, args: list<string>)\n", func_);
+      return false;
+    }
+  }
+  if (func_->is_generic()) {
+    /* the body is checked for each instance, once its types are known at a call */
+    return true;
+  }
   /* visit children */
   if (!visit_children(func_)) {
     return false;
@@ -322,9 +842,153 @@ bool SemanticAnalyzer::visit_function_definition(function_definition * const fun
   return true;
 }
 
+std::string SemanticAnalyzer::find_type_param(
+  const type_info * const t, const std::vector<std::string> & known) const
+{
+  if (nullptr == t) {
+    return "";
+  } else if (t->type == type_id::VARIABLE && !t->name.empty() &&
+    std::find(known.begin(), known.end(), t->name) == known.end())
+  {
+    return t->name;
+  }
+  for (const type_info & elem : t->elems) {
+    if (std::string name = find_type_param(&elem, known); !name.empty()) {
+      return name;
+    }
+  }
+  return find_type_param(t->subtype, known);
+}
+
+bool SemanticAnalyzer::infer_type_params(
+  const type_info * const param, const type_info * const arg,
+  std::map<std::string, type_info> & bindings) const
+{
+  if (param->type == type_id::VARIABLE && !param->name.empty()) {
+    if (auto it = bindings.find(param->name); it != bindings.end()) {
+      return it->second == *arg;
+    }
+    bindings.emplace(param->name, *arg);
+    return true;
+  } else if (param->type == type_id::TUPLE) {
+    if (arg->type != type_id::TUPLE || arg->elems.size() != param->elems.size()) {
+      return false;
+    }
+    for (std::size_t x = 0; x < param->elems.size(); ++x) {
+      if (!infer_type_params(&param->elems[x], &arg->elems[x], bindings)) {
+        return false;
+      }
+    }
+    return true;
+  } else if (nullptr != param->subtype) {
+    /* whether the containers themselves match is up to the usual argument checks */
+    return nullptr != arg->subtype && infer_type_params(param->subtype, arg->subtype, bindings);
+  }
+  return true;
+}
+
+void SemanticAnalyzer::substitute_type_params(
+  node * const n, const std::map<std::string, type_info> & bindings) const
+{
+  substitute_type_params(n->get_type(), bindings);
+  for (node * child : n->get_children()) {
+    substitute_type_params(child, bindings);
+  }
+}
+
+void SemanticAnalyzer::substitute_type_params(
+  type_info * const t, const std::map<std::string, type_info> & bindings) const
+{
+  for (type_info * iter = t; nullptr != iter; iter = iter->subtype) {
+    if (iter->type == type_id::VARIABLE && bindings.count(iter->name) > 0) {
+      *iter = bindings.at(iter->name);
+      break;
+    }
+    for (type_info & elem : iter->elems) {
+      substitute_type_params(&elem, bindings);
+    }
+  }
+}
+
+function_definition * SemanticAnalyzer::instantiate(
+  function_call * const call_, function_definition * const generic) const
+{
+  if (call_->get_children().size() != generic->get_formals().size()) {
+    error(
+      "wrong number of arguments for function '%s': got '%zd' expected '%zd'\n",
+      call_, call_->get_name().c_str(), call_->get_children().size(),
+      generic->get_formals().size());
+    return nullptr;
+  }
+  /* infer the type parameters from the arguments */
+  std::map<std::string, type_info> bindings;
+  for (std::size_t x = 0; x < call_->get_children().size(); ++x) {
+    expression * const arg = call_->get_children()[x]->as_expression();
+    if (!visit(arg)) {
+      return nullptr;
+    }
+    type_info * const param_t = generic->get_formals()[x]->get_type();
+    lambda * const fn = resolve_lambda(arg);
+    /* a lambda's type is what it returns, which is the subtype of lambda<T> */
+    const bool inferred = (param_t->type == type_id::LAMBDA && nullptr != fn) ?
+      (nullptr == param_t->subtype || infer_type_params(param_t->subtype, fn->get_type(), bindings)) :
+      infer_type_params(param_t, arg->get_type(), bindings);
+    if (!inferred) {
+      error(
+        "conflicting types for the type parameters of '%s': got '%s' for '%s'\n",
+        arg, call_->get_name().c_str(), type_to_str(arg->get_type()).c_str(),
+        type_to_str(param_t).c_str());
+      return nullptr;
+    }
+  }
+  /* one instance per set of types, named after them */
+  std::string mangled = generic->get_name();
+  for (const std::string & param : generic->get_type_params()) {
+    if (bindings.count(param) == 0) {
+      error(
+        "unable to infer type parameter '%s' of '%s'\n", call_, param.c_str(),
+        call_->get_name().c_str());
+      return nullptr;
+    }
+    mangled += "__" + mangle_type(&bindings.at(param));
+  }
+  if (function_definition * const instance = generic->get_instance(mangled); nullptr != instance) {
+    return instance;
+  }
+  auto * const instance = static_cast<function_definition *>(generic->clone());
+  instance->set_name(mangled);
+  instance->set_type_params({});
+  substitute_type_params(instance, bindings);
+  /* lambdas are emitted by name, so each instance needs its own */
+  std::vector<node *> pending = {instance};
+  while (!pending.empty()) {
+    node * const n = pending.back();
+    pending.pop_back();
+    if (n->is_lambda()) {
+      n->set_name(mangled + "_" + n->get_name());
+    }
+    pending.insert(pending.end(), n->get_children().begin(), n->get_children().end());
+  }
+  /* added before it is visited, so a recursive call finds it */
+  generic->add_instance(instance);
+  if (!visit(instance)) {
+    return nullptr;
+  }
+  return instance;
+}
+
 bool SemanticAnalyzer::visit_if_expr(if_expr * const if_stmt) const
 {
-  auto * parent = if_stmt->get_parent();
+  /* an if among the arguments of an operator sits under a list, which has no scope */
+  node * parent = nullptr;
+  for (parent = if_stmt->get_parent(); parent && (parent->get_scope() == nullptr); ) {
+    parent = parent->get_parent();
+  }
+  if (nullptr == parent) {
+    internal_compiler_error(
+      "traversed to root node before finding a scope for if '%s'\n", if_stmt->get_fqn().c_str());
+    return false;
+  }
   const auto & p_scope = parent->get_scope();
   if_stmt->set_scope(std::make_shared<scope>());
   if_stmt->get_scope()->parent = p_scope;
@@ -369,7 +1033,11 @@ bool SemanticAnalyzer::visit_iterator_definition(iterator_definition * const ite
   if (!visit_children(iter)) {
     return false;
   }
-  if (iter->get_children()[0]->get_type()->type != type_id::LIST) {
+  const type_info * list_t = iter->get_children()[0]->get_type();
+  if (!list_t->compatible(
+      list_t->type, type_id::LIST, type_id::VEC, type_id::MAT, type_id::MAP, type_id::SET,
+      type_id::PVEC))
+  {
     error(
       "cannot iterate over type '%s'\n",
       iter->get_children()[0],
@@ -384,8 +1052,14 @@ bool SemanticAnalyzer::visit_iterator_definition(iterator_definition * const ite
     return false;
   }
   iter->set_list(iter->get_children()[0]->as_expression());
-  /* resolve to the type inside the list */
-  iter->set_type(new type_info(*iter->get_children()[0]->get_type()->subtype));
+  /* resolve to the type inside the list, or the keys of a map or set */
+  type_info * type = new type_info(*iter->get_children()[0]->get_type()->subtype);
+  if (iter->get_list()->get_type()->type == type_id::MAT) {
+    /* a mat is walked a row at a time, and each row is a vec */
+    *type = *iter->get_list()->get_type();
+    type->type = type_id::VEC;
+  }
+  iter->set_type(type);
   auto * parent = iter->get_parent();
   iter->set_scope(parent->get_scope());
   /* check scope for redefinition */
@@ -497,6 +1171,54 @@ bool SemanticAnalyzer::visit_formal(formal * const var) const
   }
   /* otherwise, append the formal to the function's scope */
   parent->get_scope()->variables.push_back(var);
+  resolve_record_types(var->get_type(), parent);
+  return true;
+}
+
+bool SemanticAnalyzer::visit_record_definition(record_definition * const rec) const
+{
+  auto * parent = rec->get_parent();
+  if (!parent->is_root()) {
+    error("record '%s' must be defined at the top level\n", rec, rec->get_name().c_str());
+    return false;
+  }
+  definition * conflict = nullptr;
+  if (scope_has_definition(rec->get_name(), parent->get_scope().get(), &conflict)) {
+    location_info & loc = *conflict->get_location();
+    error(
+      "conflicting definition for record '%s' (original on line %d column %d)\n",
+      rec, rec->get_name().c_str(), loc.line, loc.column);
+    return false;
+  } else if (rec->get_layout() != "aos" && rec->get_layout() != "soa") {
+    error(
+      "unknown layout '%s' for record '%s', expected 'aos' or 'soa'\n",
+      rec, rec->get_layout().c_str(), rec->get_name().c_str());
+    return false;
+  }
+  for (std::size_t x = 0; x < rec->get_fields().size(); ++x) {
+    formal * const field = rec->get_fields()[x];
+    const type_id field_t = field->get_type()->type;
+    /* fields are flat, so a record is a plain struct and each soa column is a vec<T> */
+    if (!is_numeric(field_t) && field_t != type_id::BOOL) {
+      error(
+        "field '%s' of record '%s' has type '%s', only number and bool fields are supported\n",
+        field, field->get_name().c_str(), rec->get_name().c_str(),
+        type_to_str(field->get_type()).c_str());
+      return false;
+    } else if (rec->get_field_index(field->get_name()) != static_cast<int>(x)) {
+      error(
+        "duplicate field '%s' in record '%s'\n",
+        field, field->get_name().c_str(), rec->get_name().c_str());
+      return false;
+    }
+    /* fields aren't variables, nothing else looks them up in a scope */
+    field->mark_visited();
+  }
+  type_info * type = new type_info();
+  type->type = type_id::RECORD;
+  type->name = rec->get_name();
+  rec->set_type(type);
+  parent->get_scope()->records.push_back(rec);
   return true;
 }
 
@@ -522,9 +1244,35 @@ bool SemanticAnalyzer::visit_lambda(lambda * const lambda) const
     return false;
   }
   lambda->set_type(new type_info(*ret->get_type()));
+  find_captures(lambda, lambda);
   return true;
 }
 
+void SemanticAnalyzer::find_captures(lambda * const fn, node * const n) const
+{
+  for (node * child : n->get_children()) {
+    definition * def = nullptr;
+    if (variable * var = dynamic_cast<variable *>(child); nullptr != var) {
+      def = var->get_resolution();
+    } else if (child->is_function_call() && child->as_function_call()->get_dynamic_target()) {
+      def = child->as_function_call()->get_dynamic_target();
+    } else if (child->is_function_call()) {
+      /* a call to a let-bound lambda needs its closure */
+      lambda * callee = dynamic_cast<lambda *>(child->as_function_call()->get_resolution());
+      def = (nullptr == callee) ? nullptr : dynamic_cast<definition *>(callee->get_parent());
+    }
+    variable_definition * var_def = dynamic_cast<variable_definition *>(def);
+    /* globals are reachable from anywhere, and a lambda reaches itself through its own closure */
+    if (nullptr != var_def && !var_def->is_descendent(fn) && !var_def->get_parent()->is_root() &&
+      (var_def->get_children().empty() || var_def->get_children()[0] != fn))
+    {
+      fn->add_capture(var_def);
+    }
+    /* nested lambdas are walked too, whatever they capture from outside of fn passes through it */
+    find_captures(fn, child);
+  }
+}
+
 bool SemanticAnalyzer::visit_list_op(list_op * const op) const
 {
   /* child (singular) should be a list */
@@ -533,9 +1281,235 @@ bool SemanticAnalyzer::visit_list_op(list_op * const op) const
       "too many children (%zd) for list operation\n", op,
       op->get_children().size());
     return false;
+  } else if (op->get_op() == op_id::TABLE || op->get_op() == op_id::MAX_HEAP) {
+    /* the parser set the type, the entries (if there are any) are checked one by one */
+    type_info * table_t = op->get_type();
+    if (op->get_op() == op_id::MAX_HEAP && table_t->type != type_id::HEAP) {
+      error(
+        "cannot make '%s' with 'max', only a heap has an order\n",
+        op, type_to_str(table_t).c_str());
+      return false;
+    } else if (!check_table_type(op, table_t)) {
+      return false;
+    }
+    std::vector<expression *> args;
+    for (list * iter = op->get_children().empty() ? nullptr : op->get_children()[0]->as_list();
+      nullptr != iter; iter = iter->get_tail())
+    {
+      if (!visit(iter->get_head())) {
+        return false;
+      }
+      args.push_back(iter->get_head());
+    }
+    const bool map = table_t->type == type_id::MAP;
+    if (!map && args.size() == 1 &&
+      args[0]->get_type()->compatible(args[0]->get_type()->type, type_id::LIST, type_id::VEC))
+    {
+      /* every element of a list or vec is a key, or is pushed onto a queue or heap */
+      if (*args[0]->get_type()->subtype != *table_t->subtype) {
+        error(
+          "cannot make '%s' from the elements of '%s'\n",
+          op, type_to_str(table_t).c_str(), type_to_str(args[0]->get_type()).c_str());
+        return false;
+      }
+      return true;
+    } else if (map && args.size() % 2 != 0) {
+      error("'%s' expects a value after each key\n", op, type_to_str(table_t).c_str());
+      return false;
+    }
+    for (std::size_t x = 0; x < args.size(); ++x) {
+      if (!check_table_argument(op->get_op(), args[x], table_t, map && x % 2 == 1)) {
+        return false;
+      }
+    }
+    return true;
   } else if (nullptr == dynamic_cast<list *>(op->get_children()[0])) {
     error("invalid arguments for list operation\n", op);
     return false;
+  } else if (op->get_op() == op_id::VALUES) {
+    /* a tuple keeps the type of each of its elements */
+    type_info * type = new type_info();
+    type->type = type_id::TUPLE;
+    for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+      if (!visit(iter->get_head())) {
+        delete type;
+        return false;
+      } else if (iter->get_head()->get_type()->compatible(
+          iter->get_head()->get_type()->type, type_id::NIL, type_id::TUPLE))
+      {
+        error(
+          "cannot make a tuple element of type '%s'\n",
+          iter->get_head(), type_to_str(iter->get_head()->get_type()).c_str());
+        delete type;
+        return false;
+      }
+      type->elems.push_back(*iter->get_head()->get_type());
+    }
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::SLICE || op->get_op() == op_id::FOLD ||
+    op->get_op() == op_id::LANES || op->get_op() == op_id::SHUFFLE ||
+    op->get_op() == op_id::PUT || op->get_op() == op_id::ASSOC)
+  {
+    /* the arguments to these are not a homogeneous list, check them one by one */
+    std::vector<expression *> args;
+    for (list * iter = op->get_children()[0]->as_list(); nullptr != iter; iter = iter->get_tail()) {
+      if (!visit(iter->get_head())) {
+        return false;
+      }
+      args.push_back(iter->get_head());
+    }
+    if (op->get_op() == op_id::FOLD) {
+      if (args.size() != 3) {
+        error("'fold' expects a lambda, an initial value, and a list\n", op);
+        return false;
+      } else if (args[2]->get_type()->type != type_id::LIST) {
+        error(
+          "attempted fold operation on non-list type '%s'\n",
+          op, type_to_str(args[2]->get_type()).c_str());
+        return false;
+      }
+      /* the accumulator has the type the lambda returns */
+      type_info * elem_t = args[2]->get_type()->subtype;
+      lambda * const fn = resolve_lambda(args[0]);
+      type_info * acc_t = (nullptr != fn) ? fn->get_type() : elem_t;
+      if (!check_function_argument(op->get_op(), args[0], {acc_t, elem_t}, acc_t)) {
+        return false;
+      } else if (!args[1]->get_type()->converts_to(acc_t)) {
+        error(
+          "cannot convert type '%s' to '%s' for initial value in 'fold'\n",
+          args[1], type_to_str(args[1]->get_type()).c_str(), type_to_str(acc_t).c_str());
+        return false;
+      }
+      op->set_type(new type_info(*acc_t));
+      return true;
+    } else if (op->get_op() == op_id::LANES) {
+      /* the parser set the type, (f64x4 a b c d) or (f64x4 a) */
+      type_info * simd_t = op->get_type();
+      if (args.size() == 1 && args[0]->get_type()->type == type_id::SIMD) {
+        /* converts a vector lane by lane */
+        if (args[0]->get_type()->lanes != simd_t->lanes ||
+          !args[0]->get_type()->subtype->converts_to(simd_t->subtype))
+        {
+          error(
+            "cannot convert type '%s' to '%s'\n",
+            op, type_to_str(args[0]->get_type()).c_str(), type_to_str(simd_t).c_str());
+          return false;
+        }
+        return true;
+      } else if (args.size() != 1 && args.size() != simd_t->lanes) {
+        error(
+          "'%s' expects one value for every lane, or a single value for all %zu\n",
+          op, type_to_str(simd_t).c_str(), simd_t->lanes);
+        return false;
+      }
+      for (expression * arg : args) {
+        type_info * arg_t = arg->get_type();
+        if ((!is_numeric(arg_t->type) && arg_t->type != type_id::BOOL) ||
+          !arg_t->converts_to(simd_t->subtype))
+        {
+          error(
+            "cannot convert type '%s' to '%s' for a lane of '%s'\n",
+            arg, type_to_str(arg_t).c_str(), type_to_str(simd_t->subtype).c_str(),
+            type_to_str(simd_t).c_str());
+          return false;
+        }
+      }
+      return true;
+    } else if (op->get_op() == op_id::PUT) {
+      /* (put m k v) or (put s k), the table is changed in place and returned */
+      type_info * table_t = args[0]->get_type();
+      if (!table_t->compatible(table_t->type, type_id::MAP, type_id::SET)) {
+        error(
+          "attempted put operation on type '%s', expected a map or set\n",
+          op, type_to_str(table_t).c_str());
+        return false;
+      } else if (args.size() != ((table_t->type == type_id::MAP) ? 3 : 2)) {
+        error(
+          "'put' into '%s' expects %s\n", op, type_to_str(table_t).c_str(),
+          (table_t->type == type_id::MAP) ? "a key and a value" : "a key");
+        return false;
+      }
+      for (std::size_t x = 1; x < args.size(); ++x) {
+        if (!check_table_argument(op->get_op(), args[x], table_t, 2 == x)) {
+          return false;
+        }
+      }
+      op->set_type(new type_info(*table_t));
+      return true;
+    } else if (op->get_op() == op_id::ASSOC) {
+      /* (assoc p i x), a new pvec with element i replaced */
+      type_info int_t;
+      int_t.type = type_id::INT;
+      if (args.size() != 3 || args[0]->get_type()->type != type_id::PVEC) {
+        error("'assoc' expects a pvec, an index, and a value\n", op);
+        return false;
+      } else if (!args[1]->get_type()->converts_to(&int_t)) {
+        error("assoc index must be an integer\n", op);
+        return false;
+      } else if (!args[2]->get_type()->converts_to(args[0]->get_type()->subtype)) {
+        error(
+          "cannot convert type '%s' to '%s' in 'assoc'\n",
+          args[2], type_to_str(args[2]->get_type()).c_str(),
+          type_to_str(args[0]->get_type()->subtype).c_str());
+        return false;
+      }
+      op->set_type(new type_info(*args[0]->get_type()));
+      return true;
+    } else if (op->get_op() == op_id::SHUFFLE) {
+      /* (shuffle a b 0 4 1 5) picks lanes from a and then b by constant position */
+      std::size_t sources = 0;
+      for (; sources < std::min<std::size_t>(args.size(), 2) &&
+        args[sources]->get_type()->type == type_id::SIMD; ++sources)
+      {
+      }
+      if (0 == sources || sources == args.size()) {
+        error("'shuffle' expects one or two simd vectors, then lane numbers\n", op);
+        return false;
+      } else if (2 == sources && *args[0]->get_type() != *args[1]->get_type()) {
+        error(
+          "cannot shuffle '%s' with '%s'\n",
+          op, type_to_str(args[0]->get_type()).c_str(), type_to_str(args[1]->get_type()).c_str());
+        return false;
+      }
+      const int limit = sources * args[0]->get_type()->lanes;
+      for (std::size_t x = sources; x < args.size(); ++x) {
+        literal * const lane = dynamic_cast<literal *>(args[x]);
+        if (nullptr == lane || lane->get_type()->type != type_id::INT ||
+          lane->get_int() < 0 || lane->get_int() >= limit)
+        {
+          error("lane numbers in 'shuffle' must be constants from 0 to %d\n", args[x], limit - 1);
+          return false;
+        }
+      }
+      type_info * type = new type_info(*args[0]->get_type());
+      type->lanes = args.size() - sources;
+      op->set_type(type);
+      return true;
+    }
+    type_info int_t;
+    int_t.type = type_id::INT;
+    if (args.size() != 3) {
+      error("'slice' expects a vec or pvec, a start index, and an end index\n", op);
+      return false;
+    } else if (args[0]->get_type()->type == type_id::PVEC) {
+      /* shares the nodes it keeps */
+    } else if (args[0]->get_type()->type != type_id::VEC ||
+      args[0]->get_type()->subtype->type == type_id::RECORD)
+    {
+      error(
+        "attempted slice operation on type '%s', expected a pvec, or a vec of int, float, bool, "
+        "or vec\n",
+        op, type_to_str(args[0]->get_type()).c_str());
+      return false;
+    } else if (!args[1]->get_type()->converts_to(&int_t) ||
+      !args[2]->get_type()->converts_to(&int_t))
+    {
+      error("slice indices must be integers\n", op);
+      return false;
+    }
+    op->set_type(new type_info(*args[0]->get_type()));
+    return true;
   }
   /* traverse through our children */
   bool ret = visit_children(op);
@@ -550,10 +1524,45 @@ bool SemanticAnalyzer::visit_list_op(list_op * const op) const
     internal_compiler_error("unresolved subtype for list '%s'\n", list_->get_fqn().c_str());
     return false;
   }
+  expression * const operand = op->get_reduced_operand();
+  if (nullptr != operand) {
+    /* a single list or vec operand is reduced itself */
+    list_t = operand->get_type();
+  }
+  if (list_t->type == type_id::SIMD || list_t->subtype->type == type_id::SIMD) {
+    /* one vector is reduced across its lanes, several are combined lane by lane */
+    type_info * simd_t = (list_t->type == type_id::SIMD) ? list_t : list_t->subtype;
+    const type_id lane = simd_t->subtype->type;
+    const bool logical = op->get_op() == op_id::AND || op->get_op() == op_id::OR ||
+      op->get_op() == op_id::XOR;
+    const bool arithmetic = op->get_op() == op_id::PLUS || op->get_op() == op_id::MINUS ||
+      op->get_op() == op_id::TIMES || op->get_op() == op_id::DIVIDE ||
+      op->get_op() == op_id::MIN || op->get_op() == op_id::MAX;
+    if (nullptr != operand && (op->get_op() == op_id::MINUS || op->get_op() == op_id::DIVIDE)) {
+      error(
+        "'%s' has no reduction across lanes, only +, *, min, max, and, or, and xor do\n",
+        op, op_to_str(op->get_op()).c_str());
+      return false;
+    } else if ((arithmetic && is_numeric(lane)) || (logical && lane == type_id::BOOL)) {
+      op->set_type(new type_info((nullptr != operand) ? *simd_t->subtype : *simd_t));
+      return true;
+    }
+    error(
+      "invalid operands for list operator '%s' on '%s'\n",
+      op, op_to_str(op->get_op()).c_str(), type_to_str(simd_t).c_str());
+    return false;
+  }
+  if (list_t->type == type_id::MAT &&
+    (op->get_op() == op_id::MINUS || op->get_op() == op_id::DIVIDE))
+  {
+    error(
+      "'%s' has no reduction over a mat, only +, *, min, and max do\n",
+      op, op_to_str(op->get_op()).c_str());
+    return false;
+  }
   switch (op->get_op()) {
     case op_id::PLUS:
-      if (list_t->subtype->type == type_id::INT ||
-        list_t->subtype->type == type_id::FLOAT ||
+      if (is_numeric(list_t->subtype->type) ||
         list_t->subtype->type == type_id::BOOL ||
         list_t->subtype->type == type_id::STRING ||
         list_t->subtype->type == type_id::LIST)
@@ -566,9 +1575,9 @@ bool SemanticAnalyzer::visit_list_op(list_op * const op) const
     case op_id::MINUS:
     case op_id::TIMES:
     case op_id::DIVIDE:
-      if (list_t->subtype->type == type_id::INT ||
-        list_t->subtype->type == type_id::FLOAT)
-      {
+    case op_id::MIN:
+    case op_id::MAX:
+      if (is_numeric(list_t->subtype->type)) {
         op->set_type(new type_info(*list_t->subtype));
         return true;
       }
@@ -579,15 +1588,16 @@ bool SemanticAnalyzer::visit_list_op(list_op * const op) const
     case op_id::OR:
     case op_id::AND:
     case op_id::XOR:
-    case op_id::NOT:
-      if (list_t->subtype->type == type_id::INT ||
-        list_t->subtype->type == type_id::FLOAT ||
-        list_t->subtype->type == type_id::BOOL ||
-        list_t->subtype->type == type_id::STRING ||
-        list_t->subtype->type == type_id::LIST)
-      {
+      if (list_t->subtype->type == type_id::BOOL) {
         op->set_type(type_id::BOOL);
         return true;
+      } else if (nullptr == operand &&
+        (list_t->subtype->type == type_id::LIST || list_t->subtype->type == type_id::VEC) &&
+        list_t->subtype->subtype->type == type_id::BOOL)
+      {
+        /* several masks are combined elementwise */
+        op->set_type(new type_info(*list_t->subtype));
+        return true;
       }
       error("invalid operands for list operator '%s'\n", op, op_to_str(op->get_op()).c_str());
       return false;
@@ -606,6 +1616,12 @@ bool SemanticAnalyzer::visit_list_op(list_op * const op) const
 
 bool SemanticAnalyzer::visit_list(list * const _list) const
 {
+  /* the arguments of an operator, (+ a b), are parsed as a list too, but never built */
+  auto is_operands = [](node * n) -> bool {
+      for (; nullptr != n->get_parent() && n->get_parent()->is_list(); n = n->get_parent()) {
+      }
+      return nullptr != n->get_parent() && n->get_parent()->is_list_op();
+    };
   if (!visit_children(_list)) {
     return false;
   }
@@ -619,6 +1635,23 @@ bool SemanticAnalyzer::visit_list(list * const _list) const
     _list->get_type()->subtype = new type_info(*_list->get_head()->get_type());
     subtype = _list->get_type()->subtype;
   }
+  if (subtype->type == type_id::RECORD) {
+    /* the list runtime stores elements by type, records are only stored in vecs */
+    error(
+      "cannot make a list of '%s', collect records into a vec instead\n",
+      _list, type_to_str(subtype).c_str());
+    return false;
+  } else if (subtype->type == type_id::TUPLE) {
+    error(
+      "cannot make a list of '%s', tuples are only returned and bound\n",
+      _list, type_to_str(subtype).c_str());
+    return false;
+  } else if (subtype->type == type_id::SIMD && !is_operands(_list)) {
+    error(
+      "cannot make a list of '%s', simd vectors are only values\n",
+      _list, type_to_str(subtype).c_str());
+    return false;
+  }
   /* check all list types are compatible */
   if (!_list->get_head()->get_type()->converts_to(subtype)) {
     error(
@@ -649,7 +1682,16 @@ bool SemanticAnalyzer::visit_literal(literal * const l) const
 
 bool SemanticAnalyzer::visit_do_loop(do_loop * const _loop) const
 {
-  auto * parent = _loop->get_parent();
+  /* loops may appear as arguments, so find the nearest enclosing scope */
+  node * parent;
+  for (parent = _loop->get_parent(); parent && (parent->get_scope() == nullptr); ) {
+    parent = parent->get_parent();
+  }
+  if (nullptr == parent) {
+    internal_compiler_error(
+      "traversed to root node before finding a scope for loop '%s'\n", _loop->get_fqn().c_str());
+    return false;
+  }
   const auto & p_scope = parent->get_scope();
   /* create new scope under the parent scope */
   _loop->set_scope(std::make_shared<scope>());
@@ -663,7 +1705,16 @@ bool SemanticAnalyzer::visit_do_loop(do_loop * const _loop) const
 
 bool SemanticAnalyzer::visit_collect_loop(collect_loop * const _loop) const
 {
-  auto * parent = _loop->get_parent();
+  /* loops may appear as arguments, so find the nearest enclosing scope */
+  node * parent;
+  for (parent = _loop->get_parent(); parent && (parent->get_scope() == nullptr); ) {
+    parent = parent->get_parent();
+  }
+  if (nullptr == parent) {
+    internal_compiler_error(
+      "traversed to root node before finding a scope for loop '%s'\n", _loop->get_fqn().c_str());
+    return false;
+  }
   const auto & p_scope = parent->get_scope();
   /* create new scope under the parent scope */
   _loop->set_scope(std::make_shared<scope>());
@@ -673,7 +1724,27 @@ bool SemanticAnalyzer::visit_collect_loop(collect_loop * const _loop) const
   }
   type_info * subtype = new type_info(*_loop->get_loop_body()->get_return_expression()->get_type());
   type_info * type = new type_info;
-  type->type = type_id::LIST;
+  /* collecting over a vec produces a vec, and so does collecting over a mat, table, or pvec */
+  type->type = _loop->get_iterator()->get_list()->get_type()->type;
+  if (type->compatible(type->type, type_id::MAT, type_id::MAP, type_id::SET, type_id::PVEC)) {
+    type->type = type_id::VEC;
+  }
+  if (type->type == type_id::VEC && !is_numeric(subtype->type) &&
+    subtype->type != type_id::BOOL && subtype->type != type_id::VEC &&
+    subtype->type != type_id::RECORD)
+  {
+    error(
+      "cannot collect '%s' over a vec, only number, bool, vec, and record elements are "
+      "supported\n", _loop, type_to_str(subtype).c_str());
+    return false;
+  } else if (type->type == type_id::LIST &&
+    subtype->compatible(subtype->type, type_id::RECORD, type_id::TUPLE))
+  {
+    error(
+      "cannot collect '%s' over a list, records and tuples are only stored in vecs\n",
+      _loop, type_to_str(subtype).c_str());
+    return false;
+  }
   type->subtype = subtype;
   _loop->set_type(type);
   return true;
@@ -744,6 +1815,16 @@ bool SemanticAnalyzer::visit_unary_op(unary_op * const op) const
     {
       internal_compiler_error("unresolved type for not operator\n");
       return false;
+    } else if (child_t.type == type_id::LIST || child_t.type == type_id::VEC) {
+      if (child_t.subtype->type != type_id::BOOL) {
+        error(
+          "attempted not operation on non-boolean elements of '%s'\n",
+          op, type_to_str(&child_t).c_str());
+        return false;
+      }
+      /* negates every element of the mask */
+      op->set_type(new type_info(child_t));
+      return true;
     }
     op->set_type(type_id::BOOL);
     return true;
@@ -765,6 +1846,223 @@ bool SemanticAnalyzer::visit_unary_op(unary_op * const op) const
     }
     op->set_type(new type_info(*op->get_children()[0]->get_type()));
     return true;
+  } else if (op->get_op() == op_id::LENGTH) {
+    /* the length of a mat is its number of rows, of a map or set its number of keys */
+    if (!child_t.compatible(
+        child_t.type, type_id::LIST, type_id::VEC, type_id::MAT, type_id::MAP, type_id::SET,
+        type_id::PVEC, type_id::QUEUE, type_id::HEAP, type_id::BUILDER, type_id::STRING,
+        type_id::SYMBOL))
+    {
+      error(
+        "attempted length operation on non-list type '%s'\n",
+        op, type_to_str(op->get_children()[0]->get_type()).c_str());
+      return false;
+    }
+    op->set_type(type_id::INT);
+    return true;
+  } else if (op->get_op() == op_id::POP || op->get_op() == op_id::PEEK) {
+    /* the front of a queue or the top of a heap, which pop also removes */
+    if (!child_t.compatible(child_t.type, type_id::QUEUE, type_id::HEAP)) {
+      error(
+        "attempted %s operation on type '%s', expected a queue or heap\n",
+        op, op_to_str(op->get_op()).c_str(), type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(new type_info(*child_t.subtype));
+    return true;
+  } else if (op->get_op() == op_id::COUNT) {
+    if ((child_t.type != type_id::LIST && child_t.type != type_id::VEC) ||
+      child_t.subtype->type != type_id::BOOL)
+    {
+      error(
+        "attempted count operation on type '%s', expected list<bool> or vec<bool>\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(type_id::INT);
+    return true;
+  } else if (op->get_op() == op_id::COMPACT) {
+    if (child_t.type != type_id::LIST || child_t.subtype->type != type_id::INT) {
+      error(
+        "attempted compact operation on type '%s', expected list<int>\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(new type_info(child_t));
+    return true;
+  } else if (op->get_op() == op_id::TO_STRING) {
+    /* numbers are written out in decimal, bools as true or false, a builder's text is copied */
+    if (!is_numeric(child_t.type) && !child_t.compatible(
+        child_t.type, type_id::BOOL, type_id::STRING, type_id::SYMBOL, type_id::BUILDER))
+    {
+      error(
+        "cannot convert type '%s' to 'string'\n", op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(type_id::STRING);
+    return true;
+  } else if (op->get_op() == op_id::INTERN) {
+    if (child_t.type != type_id::STRING && child_t.type != type_id::SYMBOL) {
+      error(
+        "attempted intern operation on type '%s', expected string\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(type_id::SYMBOL);
+    return true;
+  } else if (op->get_op() == op_id::REVERSE) {
+    if (child_t.type != type_id::LIST || child_t.subtype->type == type_id::BOOL) {
+      error(
+        "attempted reverse operation on type '%s', expected a list of int, float, string, or list\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(new type_info(child_t));
+    return true;
+  } else if (op->get_op() == op_id::CAST) {
+    /* the parser already set the type to convert to, a string is parsed */
+    if (!is_numeric(child_t.type) && !child_t.compatible(
+        child_t.type, type_id::BOOL, type_id::STRING, type_id::SYMBOL))
+    {
+      error(
+        "cannot convert type '%s' to '%s'\n",
+        op, type_to_str(&child_t).c_str(), type_to_str(op->get_type()).c_str());
+      return false;
+    }
+    return true;
+  } else if (op->get_op() == op_id::GET && child_t.type == type_id::TUPLE) {
+    /* an element of a tuple, the parser only makes positions from integers */
+    const std::size_t x = std::stoul(op->get_name());
+    if (x >= child_t.elems.size()) {
+      error(
+        "element %zd is out of range for type '%s'\n", op, x, type_to_str(&child_t).c_str());
+      return false;
+    }
+    op->set_type(new type_info(child_t.elems[x]));
+    return true;
+  } else if (op->get_op() == op_id::GET) {
+    /* a field of a record, or of every record in a vec, which is a vec of that field */
+    const bool column = child_t.type == type_id::VEC && child_t.subtype->type == type_id::RECORD;
+    type_info * const rec_t = column ? child_t.subtype : &child_t;
+    if (rec_t->type != type_id::RECORD) {
+      error(
+        "attempted get operation on type '%s', expected a record or a vec of records\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    record_definition * const rec = find_record(rec_t->name, op);
+    if (nullptr == rec) {
+      internal_compiler_error("unresolved record '%s'\n", rec_t->name.c_str());
+      return false;
+    }
+    const int field = rec->get_field_index(op->get_name());
+    if (field < 0) {
+      error(
+        "record '%s' has no field '%s'\n", op, rec->get_name().c_str(), op->get_name().c_str());
+      return false;
+    }
+    type_info * type = new type_info(*rec->get_fields()[field]->get_type());
+    if (column) {
+      type_info * vec_t = new type_info();
+      vec_t->type = type_id::VEC;
+      vec_t->subtype = type;
+      type = vec_t;
+    }
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::COLS || op->get_op() == op_id::TRANSPOSE ||
+    op->get_op() == op_id::ROW_SUMS || op->get_op() == op_id::COL_SUMS)
+  {
+    if (child_t.type != type_id::MAT) {
+      error(
+        "attempted %s operation on type '%s', expected a mat\n",
+        op, op_to_str(op->get_op()).c_str(), type_to_str(&child_t).c_str());
+      return false;
+    } else if (op->get_op() == op_id::COLS) {
+      op->set_type(type_id::INT);
+      return true;
+    }
+    /* a transpose is a mat, and the sums are a vec with one per row or column */
+    type_info * type = new type_info(child_t);
+    if (op->get_op() != op_id::TRANSPOSE) {
+      type->type = type_id::VEC;
+    }
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::TO_MAT) {
+    /* from list<list<T>> or vec<vec<T>>, one row per inner list */
+    const bool nested = (child_t.type == type_id::LIST || child_t.type == type_id::VEC) &&
+      child_t.subtype->type == child_t.type;
+    if (!nested || (child_t.subtype->subtype->type != type_id::INT &&
+      child_t.subtype->subtype->type != type_id::FLOAT))
+    {
+      error(
+        "cannot convert type '%s' with 'mat', expected a nested list or vec of int or float\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    type_info * type = new type_info(*child_t.subtype);
+    type->type = type_id::MAT;
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::TO_LIST && child_t.type == type_id::MAT) {
+    /* a list of rows */
+    type_info * type = new type_info();
+    type->type = type_id::LIST;
+    type->subtype = new type_info(child_t);
+    type->subtype->type = type_id::LIST;
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::TO_PVEC) {
+    /* copies a list or vec, each element is kept in 64 bits like a map's value */
+    const type_id elem = (nullptr != child_t.subtype) ? child_t.subtype->type : type_id::INVALID;
+    if (child_t.type != type_id::LIST && child_t.type != type_id::VEC) {
+      error(
+        "cannot convert type '%s' with 'pvec', expected a list or vec\n",
+        op, type_to_str(&child_t).c_str());
+      return false;
+    } else if (elem != type_id::INT && elem != type_id::FLOAT && elem != type_id::BOOL &&
+      elem != type_id::STRING && elem != type_id::SYMBOL)
+    {
+      error(
+        "cannot convert type '%s' with 'pvec', only int, float, bool, string, and symbol "
+        "elements are supported\n", op, type_to_str(&child_t).c_str());
+      return false;
+    }
+    type_info * type = new type_info(child_t);
+    type->type = type_id::PVEC;
+    op->set_type(type);
+    return true;
+  } else if (op->get_op() == op_id::TO_VEC || op->get_op() == op_id::TO_LIST) {
+    if (child_t.type != type_id::LIST && child_t.type != type_id::VEC) {
+      error(
+        "cannot convert type '%s' with '%s'\n",
+        op, type_to_str(&child_t).c_str(), op_to_str(op->get_op()).c_str());
+      return false;
+    }
+    const type_id to = (op->get_op() == op_id::TO_VEC) ? type_id::VEC : type_id::LIST;
+    type_info * elem_t = child_t.subtype;
+    const bool nested = elem_t->type == child_t.type;
+    if (nested) {
+      /* list<list<T>> and vec<vec<T>> convert both levels */
+      elem_t = elem_t->subtype;
+    }
+    if (elem_t->type != type_id::INT && elem_t->type != type_id::FLOAT &&
+      (nested || (elem_t->type != type_id::BOOL && !is_sized(elem_t->type))))
+    {
+      error(
+        "cannot convert type '%s' with '%s', only number and bool elements, "
+        "or nested int and float elements, are supported\n",
+        op, type_to_str(&child_t).c_str(), op_to_str(op->get_op()).c_str());
+      return false;
+    }
+    type_info * type = new type_info(child_t);
+    type->type = to;
+    if (nested) {
+      type->subtype->type = to;
+    }
+    op->set_type(type);
+    return true;
   }
   internal_compiler_error("invalid unary operator '%s'", op_to_str(op->get_op()).c_str());
   return false;
@@ -36,8 +36,24 @@ utilities_impl(list)
 utilities_impl(list_op)
 utilities_impl(literal)
 utilities_impl(loop)
+utilities_impl(record_definition)
 utilities_impl(set_expression)
 utilities_impl(unary_op)
 utilities_impl(variable_definition)
 utilities_impl(when_loop)
+
+expression * list_op::get_reduced_operand() const
+{
+  list * args = dynamic_cast<list *>(children[0]);
+  if (nullptr == args || nullptr != args->get_tail() || nullptr == args->get_head()) {
+    return nullptr;
+  }
+  type_info * t = args->get_head()->get_type();
+  if (nullptr == t || (t->type != type_id::LIST && t->type != type_id::VEC &&
+    t->type != type_id::MAT && t->type != type_id::SIMD))
+  {
+    return nullptr;
+  }
+  return args->get_head();
+}
 }  // namespace asw::slc
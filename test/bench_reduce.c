@@ -0,0 +1,133 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * Throughput of the reduction kernels at each instruction set level. The
+ * kernels are built into this file, so every target_clones variant is a
+ * symbol here and can be called directly, bypassing the loader's pick.
+ * A variant the machine can't run is skipped.
+ *
+ * Takes the number of elements and of passes over them, 1 << 20 and 100 by
+ * default, and prints elements per nanosecond for each kernel and level.
+ */
+#include "../src/runtime/slc_reduce.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef int64_t (* int_kernel)(const int64_t *, size_t, int64_t);
+typedef double (* double_kernel)(const double *, size_t, double);
+typedef float (* f32_kernel)(const float *, size_t, float);
+typedef int32_t (* i32_kernel)(const int32_t *, size_t, int32_t);
+
+struct level
+{
+  const char * name;
+  int supported;
+};
+
+/* the clones gcc makes for each kernel are named <kernel>.<target> */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define SLC_BENCH_CLONES 3
+#define SLC_BENCH_VARIANTS(KIND, kernel, T) \
+  T kernel ## _avx512f(const T *, size_t, T) __asm__(#kernel ".avx512f"); \
+  T kernel ## _avx2(const T *, size_t, T) __asm__(#kernel ".avx2"); \
+  T kernel ## _default(const T *, size_t, T) __asm__(#kernel ".default"); \
+  static const KIND kernel ## _variants[] = { \
+    kernel ## _avx512f, kernel ## _avx2, kernel ## _default};
+#else
+/* without target_clones there is only the one build of each kernel */
+#define SLC_BENCH_CLONES 1
+#define SLC_BENCH_VARIANTS(KIND, kernel, T) \
+  static const KIND kernel ## _variants[] = {kernel};
+#endif
+
+SLC_BENCH_VARIANTS(int_kernel, slc_reduce_int_sum, int64_t)
+SLC_BENCH_VARIANTS(int_kernel, slc_reduce_int_min, int64_t)
+SLC_BENCH_VARIANTS(double_kernel, slc_reduce_double_sum, double)
+SLC_BENCH_VARIANTS(double_kernel, slc_reduce_double_max, double)
+SLC_BENCH_VARIANTS(i32_kernel, slc_reduce_i32_sum, int32_t)
+SLC_BENCH_VARIANTS(f32_kernel, slc_reduce_f32_sum, float)
+
+static double _seconds(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + 1e-9 * (double)now.tv_nsec;
+}
+
+/* the result is summed into sink so the calls are not optimized away */
+static volatile double sink;
+
+#define SLC_BENCH(kernel, T, vals, n, passes, levels) \
+  for (size_t v = 0; v < SLC_BENCH_CLONES; ++v) { \
+    if (!levels[v].supported) { \
+      printf("%-24s %-8s skipped, not supported here\n", #kernel, levels[v].name); \
+      continue; \
+    } \
+    double start = _seconds(); \
+    T acc = 0; \
+    for (size_t pass = 0; pass < passes; ++pass) { \
+      acc += kernel ## _variants[v]((const T *)vals, n, 0); \
+    } \
+    double elapsed = _seconds() - start; \
+    sink += (double)acc; \
+    printf( \
+      "%-24s %-8s %8.3f elements/ns\n", #kernel, levels[v].name, \
+      (double)n * (double)passes / (elapsed * 1e9)); \
+  }
+
+int main(int argc, char ** argv)
+{
+  size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : (size_t)1 << 20;
+  size_t passes = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100;
+#if SLC_BENCH_CLONES == 3
+  __builtin_cpu_init();
+  const struct level levels[] = {
+    {"avx512f", __builtin_cpu_supports("avx512f")},
+    {"avx2", __builtin_cpu_supports("avx2")},
+    {"default", 1},
+  };
+#else
+  const struct level levels[] = {{"default", 1}};
+#endif
+  /* sized for the widest element, every kernel reads the front of it */
+  int64_t * ints = malloc(n * sizeof(int64_t));
+  double * doubles = malloc(n * sizeof(double));
+  int32_t * i32s = malloc(n * sizeof(int32_t));
+  float * floats = malloc(n * sizeof(float));
+  if (NULL == ints || NULL == doubles || NULL == i32s || NULL == floats) {
+    fprintf(stderr, "could not allocate %zu elements\n", n);
+    return EXIT_FAILURE;
+  }
+  for (size_t x = 0; x < n; ++x) {
+    ints[x] = (int64_t)(x % 1000) - 500;
+    doubles[x] = (double)ints[x] * 0.5;
+    i32s[x] = (int32_t)ints[x];
+    floats[x] = (float)doubles[x];
+  }
+  SLC_BENCH(slc_reduce_int_sum, int64_t, ints, n, passes, levels)
+  SLC_BENCH(slc_reduce_int_min, int64_t, ints, n, passes, levels)
+  SLC_BENCH(slc_reduce_double_sum, double, doubles, n, passes, levels)
+  SLC_BENCH(slc_reduce_double_max, double, doubles, n, passes, levels)
+  SLC_BENCH(slc_reduce_i32_sum, int32_t, i32s, n, passes, levels)
+  SLC_BENCH(slc_reduce_f32_sum, float, floats, n, passes, levels)
+  free(ints);
+  free(doubles);
+  free(i32s);
+  free(floats);
+  return EXIT_SUCCESS;
+}
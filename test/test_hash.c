@@ -0,0 +1,229 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Checks the map and set tables against a plain array indexed by key
+ * number. Random puts, lookups and removes run over a key range a few
+ * times larger than what is live at once, so tables grow through several
+ * doublings and collect tombstones, and after every batch the table's own
+ * slots are walked and compared with the array.
+ *
+ * A separate churn puts fresh keys and removes old ones with only a few
+ * live at a time, which fills a table with tombstones: it has to rehash
+ * in place rather than keep doubling. float keys check that every NaN is
+ * one key and -0.0 is 0.0, and string keys are found by their contents.
+ */
+#include <asw/runtime/slc_hash.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEYS 5000
+#define OPS 300000
+#define BATCH 1000
+#define CHURN_LIVE 64
+#define CHURN_OPS 100000
+
+static int failures = 0;
+
+static uint64_t _rand_state = 0x9e3779b97f4a7c15u;
+
+/* xorshift, so every run sees the same values */
+static int64_t _rand_between(int64_t lo, int64_t hi)
+{
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 7;
+  _rand_state ^= _rand_state << 17;
+  return lo + (int64_t)(_rand_state % (uint64_t)(hi - lo + 1));
+}
+
+static void _fail(const char * what, int64_t at, int64_t got, int64_t want)
+{
+  fprintf(stderr, "%s, at %lld: got %lld, expected %lld\n",
+    what, (long long)at, (long long)got, (long long)want);
+  ++failures;
+}
+
+/* keys that differ only in their high bits, so the hash has to mix them down */
+static int64_t _key(int64_t x)
+{
+  return (x - KEYS / 2) * ((int64_t)1 << 24);
+}
+
+/* every full slot holds a live key with its value, and every live key is found */
+static void _compare_map(
+  struct slc_int_table * map, const int8_t * live, const uint64_t * vals, int64_t at)
+{
+  int64_t full = 0;
+  for (int64_t x = 0; x < map->cap; ++x) {
+    if (map->ctrl[x] < 0) {
+      continue;
+    }
+    ++full;
+    int64_t k = map->keys[x] / ((int64_t)1 << 24) + KEYS / 2;
+    if (k < 0 || k >= KEYS || !live[k] || map->vals[x] != vals[k]) {
+      _fail("slot holds a dead key or the wrong value", at, map->keys[x], -1);
+    }
+  }
+  if (full != map->len) {
+    _fail("full slots", at, full, map->len);
+  }
+  for (int64_t k = 0; k < KEYS; ++k) {
+    if (live[k] != slc_int_map_has(map, _key(k))) {
+      _fail("slc_int_map_has", at, slc_int_map_has(map, _key(k)), live[k]);
+    }
+  }
+}
+
+static void check_int_map(void)
+{
+  static int8_t live[KEYS];
+  static uint64_t vals[KEYS];
+  int64_t len = 0, cap = 0;
+  struct slc_int_table * map = slc_int_map_create();
+  for (int64_t at = 0; at < OPS; ++at) {
+    int64_t k = _rand_between(0, KEYS - 1);
+    int64_t op = _rand_between(0, 9);
+    if (op < 5) {
+      uint64_t val = (uint64_t)_rand_between(1, INT64_MAX);
+      map = slc_int_map_put(map, _key(k), val);
+      len += !live[k];
+      live[k] = 1;
+      vals[k] = val;
+    } else if (op < 8) {
+      if (live[k] != slc_int_map_remove(map, _key(k))) {
+        _fail("slc_int_map_remove", at, !live[k], live[k]);
+      }
+      len -= live[k];
+      live[k] = 0;
+    } else if ((live[k] ? vals[k] : 0) != slc_int_map_get(map, _key(k))) {
+      _fail("slc_int_map_get", at, slc_int_map_get(map, _key(k)), live[k] ? vals[k] : 0);
+    }
+    if (len != slc_int_map_length(map)) {
+      _fail("slc_int_map_length", at, slc_int_map_length(map), len);
+    }
+    /* growth only ever doubles */
+    if (map->cap != cap) {
+      if (map->cap < cap || 0 != (map->cap & (map->cap - 1))) {
+        _fail("capacity", at, map->cap, cap);
+      }
+      cap = map->cap;
+    }
+    if (0 == (at + 1) % BATCH) {
+      _compare_map(map, live, vals, at);
+    }
+  }
+  slc_int_map_destroy(map);
+}
+
+static void check_int_set_churn(void)
+{
+  struct slc_int_table * set = slc_int_set_create();
+  /* key x is put at step x and removed CHURN_LIVE steps later */
+  for (int64_t x = 0; x < CHURN_OPS; ++x) {
+    set = slc_int_set_put(set, _key(x));
+    if (x >= CHURN_LIVE && !slc_int_set_remove(set, _key(x - CHURN_LIVE))) {
+      _fail("slc_int_set_remove", x, 0, 1);
+    }
+    int64_t want = (x < CHURN_LIVE) ? x + 1 : CHURN_LIVE;
+    if (want != slc_int_set_length(set)) {
+      _fail("slc_int_set_length", x, slc_int_set_length(set), want);
+    }
+  }
+  /* a table never more than half full doubles only when live keys are half of it */
+  if (set->cap > 4 * CHURN_LIVE) {
+    _fail("capacity after churn", CHURN_OPS, set->cap, 4 * CHURN_LIVE);
+  }
+  for (int64_t x = CHURN_OPS - 2 * CHURN_LIVE; x < CHURN_OPS; ++x) {
+    if ((x >= CHURN_OPS - CHURN_LIVE) != slc_int_set_has(set, _key(x))) {
+      _fail("slc_int_set_has after churn", x, slc_int_set_has(set, _key(x)), x >= CHURN_OPS - CHURN_LIVE);
+    }
+  }
+  slc_int_set_destroy(set);
+}
+
+static double _nan_with_payload(uint64_t payload)
+{
+  uint64_t bits = UINT64_C(0x7ff8000000000000) | payload;
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+static void check_double_set(void)
+{
+  struct slc_double_table * set = slc_double_set_create();
+  for (int64_t x = 0; x < 1000; ++x) {
+    set = slc_double_set_put(set, (double)x / 8);
+  }
+  set = slc_double_set_put(set, _nan_with_payload(1));
+  set = slc_double_set_put(set, _nan_with_payload(2));
+  set = slc_double_set_put(set, -_nan_with_payload(3));
+  if (1001 != slc_double_set_length(set)) {
+    _fail("slc_double_set_length with NaNs", 0, slc_double_set_length(set), 1001);
+  }
+  if (!slc_double_set_has(set, _nan_with_payload(4))) {
+    _fail("slc_double_set_has(NaN)", 0, 0, 1);
+  }
+  set = slc_double_set_put(set, -0.0);
+  if (1001 != slc_double_set_length(set) || !slc_double_set_has(set, -0.0)) {
+    _fail("-0.0 is 0.0", 0, slc_double_set_length(set), 1001);
+  }
+  for (int64_t x = 0; x < 1000; ++x) {
+    if (!slc_double_set_has(set, (double)x / 8) || slc_double_set_has(set, (double)x / 8 + 1e-9)) {
+      _fail("slc_double_set_has", x, slc_double_set_has(set, (double)x / 8), 1);
+    }
+  }
+  if (!slc_double_set_remove(set, _nan_with_payload(5)) || slc_double_set_has(set, _nan_with_payload(1))) {
+    _fail("slc_double_set_remove(NaN)", 0, slc_double_set_has(set, _nan_with_payload(1)), 0);
+  }
+  slc_double_set_destroy(set);
+}
+
+static void check_string_map(void)
+{
+  static char keys[2000][16];
+  char buf[16];
+  struct slc_string_table * map = slc_string_map_create();
+  for (int64_t x = 0; x < 2000; ++x) {
+    snprintf(keys[x], sizeof(keys[x]), "key %lld", (long long)x);
+    map = slc_string_map_put(map, keys[x], (uint64_t)x);
+  }
+  /* the same text at another address is the same key */
+  for (int64_t x = 0; x < 2000; ++x) {
+    snprintf(buf, sizeof(buf), "key %lld", (long long)x);
+    if ((uint64_t)x != slc_string_map_get(map, buf)) {
+      _fail("slc_string_map_get", x, slc_string_map_get(map, buf), x);
+    }
+  }
+  if (slc_string_map_has(map, "key 2000") || 2000 != slc_string_map_length(map)) {
+    _fail("slc_string_map_length", 2000, slc_string_map_length(map), 2000);
+  }
+  slc_string_map_destroy(map);
+}
+
+int main(void)
+{
+  check_int_map();
+  check_int_set_churn();
+  check_double_set();
+  check_string_map();
+  if (0 != failures) {
+    fprintf(stderr, "%d table operations did not match\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all table operations match\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Checks the packed list encodings against plain arrays. A list<bool> is
+ * built with from_array, cons and append at lengths either side of a
+ * word, a 256-bit chunk and a 65536-bit reserved chunk, then read back
+ * with to_array, to_words, head and cdr, and run, both from its head and
+ * from elements part way into a chunk.
+ *
+ * A compacted list<int> is checked the same way at lengths either side of
+ * its 128-element chunks, with values that pack into no bits, a few bits,
+ * 59 bits, past the 56 that one load always covers, and the full 64. It
+ * is also read through the regular list functions that decode it: nth,
+ * drop, take, reverse, and a concat that shares it as a tail.
+ */
+#include <asw/runtime/slc_bool_list.h>
+#include <asw/runtime/slc_int_compact.h>
+#include <asw/runtime/slc_int_list.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const int64_t bool_lens[] = {
+  0, 1, 63, 64, 65, 255, 256, 257, 513, 65535, 65536, 65537, 140000};
+#define BOOL_LENS ((int64_t)(sizeof(bool_lens) / sizeof(bool_lens[0])))
+/* where reads start part way in, clipped to the length */
+static const int64_t offsets[] = {0, 1, 63, 64, 200, 256, 257, 65535, 65536, 65600};
+#define OFFSETS ((int64_t)(sizeof(offsets) / sizeof(offsets[0])))
+static const int64_t int_lens[] = {0, 1, 2, 127, 128, 129, 255, 256, 257, 1000, 4099};
+#define INT_LENS ((int64_t)(sizeof(int_lens) / sizeof(int_lens[0])))
+/* how the values of a compact list are spread, which sets its bit widths */
+enum spread { SAME, SORTED, WIDE_59, FULL, EXTREMES, SPREADS };
+
+static int failures = 0;
+
+static uint64_t _rand_state = 0x9e3779b97f4a7c15u;
+
+/* xorshift, so every run sees the same values */
+static int64_t _rand_between(int64_t lo, int64_t hi)
+{
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 7;
+  _rand_state ^= _rand_state << 17;
+  return lo + (int64_t)(_rand_state % (uint64_t)(hi - lo + 1));
+}
+
+static void _fail(const char * what, const char * how, int64_t len, int64_t at)
+{
+  fprintf(stderr, "%s of a list made by %s, length %lld, at %lld\n",
+    what, how, (long long)len, (long long)at);
+  ++failures;
+}
+
+static void _check_bools(struct slc_bool_list * list, const int8_t * want, int64_t n, const char * how)
+{
+  int8_t * got = malloc((size_t)n + 1);
+  int8_t buf[SLC_BOOL_LIST_RUN];
+  if (n != slc_bool_list_length(list)) {
+    _fail("slc_bool_list_length", how, n, slc_bool_list_length(list));
+  }
+  int64_t ones = 0;
+  for (int64_t x = 0; x < n; ++x) {
+    ones += want[x];
+  }
+  if (ones != slc_bool_list_count(list)) {
+    _fail("slc_bool_list_count", how, n, slc_bool_list_count(list));
+  }
+  if ((size_t)n != slc_bool_list_to_array(list, got) || 0 != memcmp(got, want, (size_t)n)) {
+    _fail("slc_bool_list_to_array", how, n, 0);
+  }
+  /* bit x of the words is element x, and the words round-trip */
+  uint64_t * words = calloc((size_t)n / 64 + 1, sizeof(uint64_t));
+  slc_bool_list_to_words(list, words);
+  for (int64_t x = 0; x < n; ++x) {
+    if (want[x] != (int8_t)((words[x / 64] >> (x % 64)) & 1)) {
+      _fail("slc_bool_list_to_words", how, n, x);
+      break;
+    }
+  }
+  struct slc_bool_list * copy = slc_bool_list_from_words(words, (size_t)n);
+  if ((size_t)n != slc_bool_list_to_array(copy, got) || 0 != memcmp(got, want, (size_t)n)) {
+    _fail("slc_bool_list_from_words", how, n, 0);
+  }
+  int64_t x = 0;
+  for (struct slc_bool_list * iter = list; NULL != iter; iter = slc_bool_list_cdr(iter), ++x) {
+    if (x >= n || want[x] != slc_bool_list_head(iter)) {
+      _fail("slc_bool_list_head", how, n, x);
+      break;
+    }
+  }
+  if (x != n) {
+    _fail("slc_bool_list_cdr", how, n, x);
+  }
+  /* runs from each offset, reached by cdr, cover the rest of the list in order */
+  struct slc_bool_list * iter = list;
+  int64_t at = 0;
+  for (int64_t o = 0; o < OFFSETS && offsets[o] < n; ++o) {
+    for (; at < offsets[o]; ++at) {
+      iter = slc_bool_list_cdr(iter);
+    }
+    int64_t y = at;
+    for (struct slc_bool_list * run = iter, * next; NULL != run; run = next) {
+      int64_t k;
+      const int8_t * bits = slc_bool_list_run(run, &k, &next, buf);
+      if (k <= 0 || k > SLC_BOOL_LIST_RUN || y + k > n || 0 != memcmp(bits, want + y, (size_t)k)) {
+        _fail("slc_bool_list_run", how, n, y);
+        break;
+      }
+      y += k;
+    }
+    if (y != n) {
+      _fail("slc_bool_list_run", how, n, y);
+    }
+  }
+  free(words);
+  free(got);
+}
+
+static void check_bool_lists(void)
+{
+  for (int64_t l = 0; l < BOOL_LENS; ++l) {
+    int64_t n = bool_lens[l];
+    int8_t * want = malloc((size_t)n + 1);
+    for (int64_t x = 0; x < n; ++x) {
+      want[x] = (int8_t)_rand_between(0, 1);
+    }
+    _check_bools(slc_bool_list_from_array(want, (size_t)n), want, n, "from_array");
+    struct slc_bool_list * consed = NULL;
+    for (int64_t x = n - 1; x >= 0; --x) {
+      consed = slc_bool_list_cons(want[x], consed);
+    }
+    _check_bools(consed, want, n, "cons");
+    struct slc_bool_list * appended = NULL;
+    for (int64_t x = 0; x < n; ++x) {
+      appended = slc_bool_list_append(appended, want[x]);
+    }
+    _check_bools(appended, want, n, "append");
+    free(want);
+  }
+}
+
+static int64_t _value(enum spread spread, int64_t x)
+{
+  switch (spread) {
+    case SAME:
+      return -7;
+    case SORTED:
+      return 1000 * x + _rand_between(0, 999);
+    case WIDE_59:
+      return _rand_between(0, (INT64_C(1) << 59) - 1);
+    case FULL:
+      _rand_between(0, 1);
+      return (int64_t)_rand_state;
+    default:
+      return (0 == _rand_between(0, 1)) ? INT64_MIN : INT64_MAX;
+  }
+}
+
+static void _check_ints(struct slc_int_list * list, const int64_t * want, int64_t n, const char * how)
+{
+  int64_t * got = malloc((size_t)(n + 1) * sizeof(int64_t));
+  int64_t buf[SLC_LIST_RUN_MAX];
+  if (n != slc_int_list_length(list)) {
+    _fail("slc_int_list_length", how, n, slc_int_list_length(list));
+  }
+  if ((size_t)n != slc_int_list_to_array(list, got) ||
+    0 != memcmp(got, want, (size_t)n * sizeof(int64_t)))
+  {
+    _fail("slc_int_list_to_array", how, n, 0);
+  }
+  int64_t x = 0;
+  for (struct slc_int_list * iter = list; NULL != iter; iter = slc_int_list_cdr(iter), ++x) {
+    if (x >= n || want[x] != slc_int_list_head(iter) || want[x] != slc_int_list_nth(list, x)) {
+      _fail("slc_int_list_head or nth", how, n, x);
+      break;
+    }
+  }
+  if (x != n) {
+    _fail("slc_int_list_cdr", how, n, x);
+  }
+  for (int64_t o = 0; o < OFFSETS && offsets[o] < n; ++o) {
+    int64_t y = offsets[o];
+    for (struct slc_int_list * run = slc_int_list_drop(list, y), * next; NULL != run; run = next) {
+      int64_t k;
+      const int64_t * vals = slc_int_list_run(run, &k, &next, buf);
+      if (k <= 0 || k > SLC_LIST_RUN_MAX || y + k > n ||
+        0 != memcmp(vals, want + y, (size_t)k * sizeof(int64_t)))
+      {
+        _fail("slc_int_list_run", how, n, y);
+        break;
+      }
+      y += k;
+    }
+    if (y != n) {
+      _fail("slc_int_list_run", how, n, y);
+    }
+  }
+  free(got);
+}
+
+static void check_compact_lists(void)
+{
+  char how[64];
+  for (int64_t l = 0; l < INT_LENS; ++l) {
+    for (int spread = 0; spread < SPREADS; ++spread) {
+      int64_t n = int_lens[l];
+      int64_t * want = malloc((size_t)(n + 1) * sizeof(int64_t));
+      for (int64_t x = 0; x < n; ++x) {
+        want[x] = _value((enum spread)spread, x);
+      }
+      struct slc_int_list * compact = slc_int_list_compact(slc_int_list_from_array(want, (size_t)n));
+      if (0 != n && !slc_int_compact_is(compact)) {
+        _fail("slc_int_list_compact", "compact", n, spread);
+        free(want);
+        continue;
+      }
+      snprintf(how, sizeof(how), "compact, spread %d", spread);
+      _check_ints(compact, want, n, how);
+      snprintf(how, sizeof(how), "take of compact, spread %d", spread);
+      _check_ints(slc_int_list_take(compact, n / 2 + 1), want, (n > 0) ? n / 2 + 1 : 0, how);
+      /* reverse decodes the compact list into a regular one, which concat puts in front of it */
+      struct slc_int_list * reversed = slc_int_list_reverse(compact);
+      int64_t * joined = malloc((size_t)(2 * n + 1) * sizeof(int64_t));
+      for (int64_t x = 0; x < n; ++x) {
+        joined[x] = want[n - 1 - x];
+        joined[n + x] = want[x];
+      }
+      snprintf(how, sizeof(how), "reverse of compact, spread %d", spread);
+      _check_ints(reversed, joined, n, how);
+      snprintf(how, sizeof(how), "concat onto compact, spread %d", spread);
+      _check_ints(slc_int_list_concat(reversed, compact), joined, 2 * n, how);
+      free(joined);
+      free(want);
+    }
+  }
+}
+
+int main(void)
+{
+  check_bool_lists();
+  check_compact_lists();
+  if (0 != failures) {
+    fprintf(stderr, "%d list reads did not match\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all list encodings match\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Checks pvec against plain arrays. Vectors whose lengths sit on either
+ * side of a change in tree depth (32, 1024 and 32768 elements) are
+ * concatenated with each other and sliced at those same lengths, since
+ * that is where a concat has to add a level or rebalance and a slice has
+ * to drop one. A random run of push, assoc, slice and concat then mixes
+ * versions that share nodes, and at the end every version it made is
+ * checked again, so no operation may have changed one of its arguments.
+ *
+ * Every element is read both with slc_pvec_nth and a leaf at a time with
+ * slc_pvec_leaf, the way the compiler loops over a pvec.
+ */
+#include <asw/runtime/slc_pvec.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL 8
+#define OPS 600
+#define MAX_LEN 40000
+
+static const int64_t edges[] = {0, 1, 31, 32, 33, 1023, 1024, 1025, 32767, 32768, 32769};
+#define EDGES ((int64_t)(sizeof(edges) / sizeof(edges[0])))
+
+static int failures = 0;
+
+static uint64_t _rand_state = 0x9e3779b97f4a7c15u;
+
+/* xorshift, so every run sees the same values */
+static int64_t _rand_between(int64_t lo, int64_t hi)
+{
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 7;
+  _rand_state ^= _rand_state << 17;
+  return lo + (int64_t)(_rand_state % (uint64_t)(hi - lo + 1));
+}
+
+/* a vector and the array it should hold */
+struct model
+{
+  struct slc_pvec * pvec;
+  uint64_t * vals;
+  int64_t len;
+};
+
+static struct model _model_of(struct slc_pvec * pvec, const uint64_t * vals, int64_t len)
+{
+  struct model m = {pvec, malloc((size_t)(len + 1) * sizeof(uint64_t)), len};
+  memcpy(m.vals, vals, (size_t)len * sizeof(uint64_t));
+  return m;
+}
+
+static struct model _filled(int64_t len, uint64_t tag)
+{
+  struct model m = {slc_pvec_create(), malloc((size_t)(len + 1) * sizeof(uint64_t)), len};
+  for (int64_t x = 0; x < len; ++x) {
+    m.vals[x] = (tag << 32) | (uint64_t)x;
+    m.pvec = slc_pvec_push(m.pvec, m.vals[x]);
+  }
+  return m;
+}
+
+static struct model _concat(const struct model * a, const struct model * b)
+{
+  struct model m = {slc_pvec_concat(a->pvec, b->pvec),
+    malloc((size_t)(a->len + b->len + 1) * sizeof(uint64_t)), a->len + b->len};
+  memcpy(m.vals, a->vals, (size_t)a->len * sizeof(uint64_t));
+  memcpy(m.vals + a->len, b->vals, (size_t)b->len * sizeof(uint64_t));
+  return m;
+}
+
+static struct model _slice(const struct model * a, int64_t start, int64_t end)
+{
+  return _model_of(slc_pvec_slice(a->pvec, start, end), a->vals + start, end - start);
+}
+
+static void _check(const char * what, const struct model * m)
+{
+  if (m->len != m->pvec->len) {
+    fprintf(stderr, "%s: length %lld, expected %lld\n",
+      what, (long long)m->pvec->len, (long long)m->len);
+    ++failures;
+    return;
+  }
+  for (int64_t x = 0; x < m->len; ++x) {
+    if (m->vals[x] != slc_pvec_nth(m->pvec, x)) {
+      fprintf(stderr, "%s: slc_pvec_nth at %lld of %lld\n", what, (long long)x, (long long)m->len);
+      ++failures;
+      return;
+    }
+  }
+  for (int64_t x = 0, end = 0; x < m->len; x = end) {
+    const uint64_t * leaf = slc_pvec_leaf(m->pvec, x, &end);
+    if (end <= x || end > m->len || 0 != memcmp(leaf, m->vals + x, (size_t)(end - x) * sizeof(uint64_t))) {
+      fprintf(stderr, "%s: slc_pvec_leaf at %lld of %lld\n", what, (long long)x, (long long)m->len);
+      ++failures;
+      return;
+    }
+  }
+}
+
+static void check_edges(void)
+{
+  struct model filled[EDGES];
+  char what[64];
+  for (int64_t x = 0; x < EDGES; ++x) {
+    filled[x] = _filled(edges[x], (uint64_t)x + 1);
+    _check("push", &filled[x]);
+  }
+  for (int64_t a = 0; a < EDGES; ++a) {
+    for (int64_t b = 0; b < EDGES; ++b) {
+      struct model joined = _concat(&filled[a], &filled[b]);
+      snprintf(what, sizeof(what), "concat %lld %lld", (long long)edges[a], (long long)edges[b]);
+      _check(what, &joined);
+      /* cut the joined vector back at the edges, both inside and across the seam */
+      for (int64_t s = 0; s < EDGES && edges[s] <= joined.len; ++s) {
+        for (int64_t e = s; e < EDGES && edges[e] <= joined.len; ++e) {
+          struct model cut = _slice(&joined, edges[s], edges[e]);
+          snprintf(what, sizeof(what), "slice %lld %lld of %lld",
+            (long long)edges[s], (long long)edges[e], (long long)joined.len);
+          _check(what, &cut);
+          free(cut.vals);
+        }
+        struct model tail = _slice(&joined, edges[s], joined.len);
+        snprintf(what, sizeof(what), "slice %lld to the end of %lld",
+          (long long)edges[s], (long long)joined.len);
+        _check(what, &tail);
+        free(tail.vals);
+      }
+      free(joined.vals);
+    }
+  }
+  for (int64_t x = 0; x < EDGES; ++x) {
+    _check("push, after concat and slice", &filled[x]);
+    free(filled[x].vals);
+  }
+}
+
+static void check_random(void)
+{
+  static struct model made[POOL + 2 * OPS];
+  int64_t count = 0;
+  int64_t pool[POOL];
+  for (int64_t x = 0; x < POOL; ++x) {
+    made[count] = _filled(_rand_between(0, 3000), (uint64_t)(x + 100));
+    pool[x] = count++;
+  }
+  for (int64_t at = 0; at < OPS; ++at) {
+    struct model * a = &made[pool[_rand_between(0, POOL - 1)]];
+    struct model * b = &made[pool[_rand_between(0, POOL - 1)]];
+    struct model out;
+    int64_t op = _rand_between(0, 3);
+    if (0 == op || a->len + b->len > MAX_LEN) {
+      int64_t start = _rand_between(0, a->len);
+      out = _slice(a, start, _rand_between(start, a->len));
+    } else if (1 == op) {
+      out = _concat(a, b);
+    } else if (2 == op && 0 != a->len) {
+      int64_t i = _rand_between(0, a->len - 1);
+      out = _model_of(slc_pvec_assoc(a->pvec, i, (uint64_t)at), a->vals, a->len);
+      out.vals[i] = (uint64_t)at;
+    } else {
+      out = _model_of(slc_pvec_push(a->pvec, (uint64_t)at), a->vals, a->len);
+      out.vals[out.len++] = (uint64_t)at;
+    }
+    _check("random", &out);
+    made[count] = out;
+    pool[_rand_between(0, POOL - 1)] = count++;
+  }
+  for (int64_t x = 0; x < count; ++x) {
+    _check("earlier version", &made[x]);
+    free(made[x].vals);
+  }
+}
+
+int main(void)
+{
+  check_edges();
+  check_random();
+  if (0 != failures) {
+    fprintf(stderr, "%d vectors did not match\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all vectors match\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Checks queue and heap against plain arrays under a random mix of push,
+ * pop and peek. The mix leans towards push and then towards pop in turn,
+ * so a queue grows while its ring has wrapped and a heap is emptied and
+ * refilled several times. Heap keys include duplicates and both ends of
+ * int64_t, and every pop of a min or max heap must give the smallest or
+ * largest key still in the array.
+ */
+#include <asw/runtime/slc_heap.h>
+#include <asw/runtime/slc_queue.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define OPS 200000
+/* ops between switching from mostly push to mostly pop */
+#define PHASE 5000
+
+static int failures = 0;
+
+static uint64_t _rand_state = 0x9e3779b97f4a7c15u;
+
+/* xorshift, so every run sees the same values */
+static int64_t _rand_between(int64_t lo, int64_t hi)
+{
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 7;
+  _rand_state ^= _rand_state << 17;
+  return lo + (int64_t)(_rand_state % (uint64_t)(hi - lo + 1));
+}
+
+static void _fail(const char * what, int64_t at, int64_t got, int64_t want)
+{
+  fprintf(stderr, "%s, at %lld: got %lld, expected %lld\n",
+    what, (long long)at, (long long)got, (long long)want);
+  ++failures;
+}
+
+/* push more often in even phases, pop more often in odd ones */
+static int _pushes(int64_t at)
+{
+  return _rand_between(0, 9) < ((at / PHASE) % 2 ? 3 : 7);
+}
+
+static void check_queue(void)
+{
+  /* every value ever pushed, the queue holds [front, back) */
+  static uint64_t model[OPS];
+  int64_t front = 0, back = 0;
+  struct slc_queue * queue = slc_queue_create();
+  for (int64_t at = 0; at < OPS; ++at) {
+    if (_pushes(at)) {
+      model[back] = (uint64_t)_rand_between(0, INT64_MAX - 1);
+      queue = slc_queue_push(queue, model[back++]);
+    } else {
+      uint64_t want = (front < back) ? model[front] : 0;
+      uint64_t peeked = slc_queue_peek(queue);
+      uint64_t popped = slc_queue_pop(queue);
+      if (want != peeked || want != popped) {
+        _fail("slc_queue_pop", at, (int64_t)popped, (int64_t)want);
+      }
+      front += front < back;
+    }
+    if (back - front != queue->len) {
+      _fail("queue length", at, queue->len, back - front);
+    }
+  }
+  slc_queue_destroy(queue);
+}
+
+static int64_t _key(void)
+{
+  switch (_rand_between(0, 9)) {
+    case 0:
+      return INT64_MIN;
+    case 1:
+      return INT64_MAX;
+    case 2:
+    case 3:
+      /* few distinct values, so plenty of duplicates */
+      return _rand_between(-4, 4);
+    default:
+      return (int64_t)(_rand_state ^ (_rand_state >> 11));
+  }
+}
+
+static void check_heap(int8_t max)
+{
+  /* the keys in the heap, unordered */
+  static int64_t model[OPS];
+  int64_t len = 0;
+  const char * what = max ? "max heap" : "min heap";
+  struct slc_heap * heap = slc_heap_create(max);
+  for (int64_t at = 0; at < OPS; ++at) {
+    if (_pushes(at)) {
+      model[len] = _key();
+      heap = slc_heap_push(heap, model[len++]);
+    } else {
+      int64_t best = 0;
+      for (int64_t x = 1; x < len; ++x) {
+        if (max ? model[x] > model[best] : model[x] < model[best]) {
+          best = x;
+        }
+      }
+      int64_t want = (0 != len) ? model[best] : 0;
+      int64_t peeked = slc_heap_peek(heap);
+      int64_t popped = slc_heap_pop(heap);
+      if (want != peeked || want != popped) {
+        _fail(what, at, popped, want);
+      }
+      if (0 != len) {
+        model[best] = model[--len];
+      }
+    }
+    if (len != heap->len) {
+      _fail(what, at, heap->len, len);
+    }
+  }
+  slc_heap_destroy(heap);
+}
+
+int main(void)
+{
+  check_queue();
+  check_heap(0);
+  check_heap(1);
+  if (0 != failures) {
+    fprintf(stderr, "%d queue and heap operations did not match\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all queue and heap operations match\n");
+  return EXIT_SUCCESS;
+}
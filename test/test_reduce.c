@@ -0,0 +1,175 @@
+// Copyright 2024 Hunter L. Allen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * Checks every slc_reduce_* kernel against a plain loop over the same
+ * values. Lengths run from 0 through a few multiples of the kernels' 8
+ * accumulators, so both the unrolled body and the tail are covered, and
+ * min and max see negative values and an init past every element.
+ *
+ * Integer kernels must match exactly: wrapping sums and products don't
+ * depend on order. Float sums and products are reassociated across the
+ * accumulators, so they only have to match to within a rounding bound.
+ */
+#include <asw/runtime/slc_reduce.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_LEN 67
+#define LONG_LEN 4099
+
+static int failures = 0;
+
+static uint64_t _rand_state = 0x9e3779b97f4a7c15u;
+
+/* xorshift, so every run sees the same values */
+static int64_t _rand_between(int64_t lo, int64_t hi)
+{
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 7;
+  _rand_state ^= _rand_state << 17;
+  return lo + (int64_t)(_rand_state % (uint64_t)(hi - lo + 1));
+}
+
+static void _fail(const char * kernel, size_t n, double got, double want)
+{
+  fprintf(stderr, "%s, n = %zu: got %.17g, expected %.17g\n", kernel, n, got, want);
+  ++failures;
+}
+
+/* products stay small enough for an int8_t: -1 and 1, with a 2 every 9 of the first 54 */
+static int64_t _factor(size_t x, int64_t lo)
+{
+  if (x < 54 && 0 == x % 9) {
+    return 2;
+  }
+  return (lo < 0 && _rand_between(0, 1)) ? -1 : 1;
+}
+
+#define CHECK_INT_KERNELS(NAME, T, lo, hi) \
+  static void check_ ## NAME(size_t n) \
+  { \
+    T vals[LONG_LEN]; \
+    T sum = 0, prod = 1; \
+    for (size_t x = 0; x < n; ++x) { \
+      vals[x] = (T)_rand_between(lo, hi); \
+      sum = (T)(sum + vals[x]); \
+    } \
+    if (sum != slc_reduce_ ## NAME ## _sum(vals, n, 0)) { \
+      _fail("slc_reduce_" #NAME "_sum", n, slc_reduce_ ## NAME ## _sum(vals, n, 0), sum); \
+    } \
+    /* an init below and above every element, and one inside their range */ \
+    const T inits[] = {(T)(lo - 1), (T)(hi + 1), (T)((lo + hi) / 2)}; \
+    for (size_t y = 0; y < sizeof(inits) / sizeof(inits[0]); ++y) { \
+      T min = inits[y], max = inits[y]; \
+      for (size_t x = 0; x < n; ++x) { \
+        min = (vals[x] < min) ? vals[x] : min; \
+        max = (vals[x] > max) ? vals[x] : max; \
+      } \
+      if (min != slc_reduce_ ## NAME ## _min(vals, n, inits[y])) { \
+        _fail("slc_reduce_" #NAME "_min", n, slc_reduce_ ## NAME ## _min(vals, n, inits[y]), min); \
+      } \
+      if (max != slc_reduce_ ## NAME ## _max(vals, n, inits[y])) { \
+        _fail("slc_reduce_" #NAME "_max", n, slc_reduce_ ## NAME ## _max(vals, n, inits[y]), max); \
+      } \
+    } \
+    for (size_t x = 0; x < n; ++x) { \
+      vals[x] = (T)_factor(x, lo); \
+      prod = (T)(prod * vals[x]); \
+    } \
+    if (prod != slc_reduce_ ## NAME ## _prod(vals, n, 1)) { \
+      _fail("slc_reduce_" #NAME "_prod", n, slc_reduce_ ## NAME ## _prod(vals, n, 1), prod); \
+    } \
+  }
+
+CHECK_INT_KERNELS(int, int64_t, -1000000, 1000000)
+CHECK_INT_KERNELS(i8, int8_t, -100, 100)
+CHECK_INT_KERNELS(i16, int16_t, -30000, 30000)
+CHECK_INT_KERNELS(i32, int32_t, -1000000, 1000000)
+CHECK_INT_KERNELS(u32, uint32_t, 0, 4000000)
+CHECK_INT_KERNELS(u64, uint64_t, 0, 4000000)
+
+/* a reassociated sum is within n roundings of the sum of magnitudes */
+#define CHECK_FLOAT_KERNELS(NAME, T, eps) \
+  static void check_ ## NAME(size_t n) \
+  { \
+    T vals[LONG_LEN]; \
+    T sum = 0, prod = 1; \
+    T magnitude = 0; \
+    for (size_t x = 0; x < n; ++x) { \
+      vals[x] = (T)_rand_between(-1000000, 1000000) / (T)1000; \
+      sum += vals[x]; \
+      magnitude += (T)fabs((double)vals[x]); \
+    } \
+    T got = slc_reduce_ ## NAME ## _sum(vals, n, 0); \
+    if (fabs((double)(got - sum)) > (double)(eps) * (double)(n + 1) * (double)magnitude) { \
+      _fail("slc_reduce_" #NAME "_sum", n, got, sum); \
+    } \
+    const T inits[] = {(T)-1001, (T)1001, (T)0}; \
+    for (size_t y = 0; y < sizeof(inits) / sizeof(inits[0]); ++y) { \
+      T min = inits[y], max = inits[y]; \
+      for (size_t x = 0; x < n; ++x) { \
+        min = (vals[x] < min) ? vals[x] : min; \
+        max = (vals[x] > max) ? vals[x] : max; \
+      } \
+      if (min != slc_reduce_ ## NAME ## _min(vals, n, inits[y])) { \
+        _fail("slc_reduce_" #NAME "_min", n, slc_reduce_ ## NAME ## _min(vals, n, inits[y]), min); \
+      } \
+      if (max != slc_reduce_ ## NAME ## _max(vals, n, inits[y])) { \
+        _fail("slc_reduce_" #NAME "_max", n, slc_reduce_ ## NAME ## _max(vals, n, inits[y]), max); \
+      } \
+    } \
+    /* factors near 1 keep long products in range, each step rounds once */ \
+    for (size_t x = 0; x < n; ++x) { \
+      vals[x] = (T)_rand_between(900, 1100) / (T)1000; \
+      prod *= vals[x]; \
+    } \
+    got = slc_reduce_ ## NAME ## _prod(vals, n, 1); \
+    if (fabs((double)(got - prod)) > (double)(eps) * (double)(n + 1) * fabs((double)prod)) { \
+      _fail("slc_reduce_" #NAME "_prod", n, got, prod); \
+    } \
+  }
+
+CHECK_FLOAT_KERNELS(double, double, 1e-15)
+CHECK_FLOAT_KERNELS(f32, float, 1e-6f)
+
+int main(void)
+{
+  size_t lens[MAX_LEN + 3];
+  size_t count = 0;
+  for (size_t n = 0; n < MAX_LEN; ++n) {
+    lens[count++] = n;
+  }
+  lens[count++] = LONG_LEN - 1;
+  lens[count++] = LONG_LEN;
+  for (size_t x = 0; x < count; ++x) {
+    check_int(lens[x]);
+    check_i8(lens[x]);
+    check_i16(lens[x]);
+    check_i32(lens[x]);
+    check_u32(lens[x]);
+    check_u64(lens[x]);
+    check_double(lens[x]);
+    check_f32(lens[x]);
+  }
+  if (0 != failures) {
+    fprintf(stderr, "%d reductions did not match\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all reductions match\n");
+  return EXIT_SUCCESS;
+}